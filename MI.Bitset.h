@@ -0,0 +1,287 @@
+﻿#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#if defined(_MSC_VER)
+  #include <intrin.h>
+#endif
+
+#include "Common/MI.Check.h"
+#include "Common/MI.ParallelFor.h"
+
+// Битовый набор размера, задаваемого во время выполнения (1 бит на элемент).
+// =========================================================================
+//
+// Биты хранятся словами по 64, бит i лежит в слове i / 64 на позиции i % 64. Неиспользуемые биты последнего слова
+// всегда нулевые, поэтому count(), сравнение и операции над словами не требуют масок.
+//
+// Для 100M элементов набор занимает 12.5 МБ вместо 100 МБ у STD vector<char> / массива bool.
+//
+// make_bitset(size, n_threads, predicate) заполняет набор параллельно: каждый поток собирает свои слова целиком
+// в регистре и записывает их один раз, атомарные операции не нужны.
+namespace mi {
+namespace internal {
+MI_NODISCARD inline size_t popcount(const STD uint64_t word) noexcept {
+#if defined(_MSC_VER)
+  return static_cast<size_t>(__popcnt64(word));
+#elif defined(__GNUC__)
+  return static_cast<size_t>(__builtin_popcountll(word));
+#else
+  size_t result = 0;
+
+  for (STD uint64_t rest = word; rest != 0; rest &= rest - 1) {
+    ++result;
+  }
+
+  return result;
+#endif
+}
+
+// Номер младшего установленного бита, word != 0.
+MI_NODISCARD inline size_t count_trailing_zeros(const STD uint64_t word) noexcept {
+  MI_DCHECK(word != 0);
+
+#if defined(_MSC_VER)
+  unsigned long index;
+  _BitScanForward64(&index, word);
+
+  return static_cast<size_t>(index);
+#elif defined(__GNUC__)
+  return static_cast<size_t>(__builtin_ctzll(word));
+#else
+  size_t result = 0;
+
+  while ((word >> result & 1) == 0) {
+    ++result;
+  }
+
+  return result;
+#endif
+}
+}  // namespace internal
+
+class dynamic_bitset {
+  public:
+    using word_type = STD uint64_t;
+
+    static constexpr size_t bits_per_word = 64;
+
+  public:
+    dynamic_bitset() = default;
+
+    explicit dynamic_bitset(const size_t size, const bool value = false)
+        : _size(size),
+          _words(n_words_for(size), value ? ~word_type{0} : word_type{0}) {
+      clear_tail();
+    }
+
+  public:
+    MI_NODISCARD size_t size() const noexcept {
+      return _size;
+    }
+
+    MI_NODISCARD bool empty() const noexcept {
+      return _size == 0;
+    }
+
+    MI_NODISCARD bool test(const size_t n_bit) const {
+      MI_DCHECK(n_bit < _size);
+
+      return (_words[n_bit / bits_per_word] >> (n_bit % bits_per_word) & 1) != 0;
+    }
+
+    MI_NODISCARD bool operator[](const size_t n_bit) const {
+      return test(n_bit);
+    }
+
+    void set(const size_t n_bit, const bool value = true) {
+      MI_DCHECK(n_bit < _size);
+
+      const word_type mask = word_type{1} << (n_bit % bits_per_word);
+      word_type&      word = _words[n_bit / bits_per_word];
+
+      word = value ? word | mask : word & ~mask;
+    }
+
+    void reset(const size_t n_bit) {
+      set(n_bit, false);
+    }
+
+    // Количество установленных битов.
+    MI_NODISCARD size_t count() const noexcept {
+      size_t result = 0;
+
+      for (const word_type word: _words) {
+        result += internal::popcount(word);
+      }
+
+      return result;
+    }
+
+    MI_NODISCARD bool all() const noexcept {
+      return count() == _size;
+    }
+
+    MI_NODISCARD bool any() const noexcept {
+      return STD any_of(_words.begin(), _words.end(), [](const word_type word) {
+        return word != 0;
+      });
+    }
+
+    MI_NODISCARD bool none() const noexcept {
+      return !any();
+    }
+
+  public:
+    // fn(n_bit) для каждого установленного бита по возрастанию.
+    template<class Fn>
+    void for_each_set(Fn&& fn) const {
+      for (size_t n_word = 0; n_word < _words.size(); ++n_word) {
+        for_each_bit(_words[n_word], n_word, fn);
+      }
+    }
+
+    // fn(n_bit) для каждого сброшенного бита по возрастанию.
+    template<class Fn>
+    void for_each_unset(Fn&& fn) const {
+      for (size_t n_word = 0; n_word < _words.size(); ++n_word) {
+        for_each_bit(~_words[n_word] & live_mask(n_word), n_word, fn);
+      }
+    }
+
+  public:
+    dynamic_bitset& operator&=(const dynamic_bitset& other) {
+      MI_CHECK(_size == other._size);
+
+      for (size_t n_word = 0; n_word < _words.size(); ++n_word) {
+        _words[n_word] &= other._words[n_word];
+      }
+
+      return *this;
+    }
+
+    dynamic_bitset& operator|=(const dynamic_bitset& other) {
+      MI_CHECK(_size == other._size);
+
+      for (size_t n_word = 0; n_word < _words.size(); ++n_word) {
+        _words[n_word] |= other._words[n_word];
+      }
+
+      return *this;
+    }
+
+    // Сбрасывает биты, установленные в other (this & ~other).
+    dynamic_bitset& subtract(const dynamic_bitset& other) {
+      MI_CHECK(_size == other._size);
+
+      for (size_t n_word = 0; n_word < _words.size(); ++n_word) {
+        _words[n_word] &= ~other._words[n_word];
+      }
+
+      return *this;
+    }
+
+    dynamic_bitset& flip() noexcept {
+      for (word_type& word: _words) {
+        word = ~word;
+      }
+
+      clear_tail();
+
+      return *this;
+    }
+
+    MI_NODISCARD friend dynamic_bitset operator&(dynamic_bitset left, const dynamic_bitset& right) {
+      return left &= right;
+    }
+
+    MI_NODISCARD friend dynamic_bitset operator|(dynamic_bitset left, const dynamic_bitset& right) {
+      return left |= right;
+    }
+
+    MI_NODISCARD friend dynamic_bitset operator~(dynamic_bitset bitset) {
+      return bitset.flip();
+    }
+
+    MI_NODISCARD friend bool operator==(const dynamic_bitset& left, const dynamic_bitset& right) noexcept {
+      return left._size == right._size && left._words == right._words;
+    }
+
+    MI_NODISCARD friend bool operator!=(const dynamic_bitset& left, const dynamic_bitset& right) noexcept {
+      return !(left == right);
+    }
+
+  public:
+    // Доступ к словам для массовых операций. Неиспользуемые биты последнего слова должны оставаться нулевыми.
+    MI_NODISCARD size_t n_words() const noexcept {
+      return _words.size();
+    }
+
+    MI_NODISCARD const word_type* words() const noexcept {
+      return _words.data();
+    }
+
+    MI_NODISCARD word_type* words() noexcept {
+      return _words.data();
+    }
+
+    MI_NODISCARD static constexpr size_t n_words_for(const size_t size) noexcept {
+      return (size + bits_per_word - 1) / bits_per_word;
+    }
+
+  private:
+    template<class Fn>
+    static void for_each_bit(word_type word, const size_t n_word, Fn& fn) {
+      while (word != 0) {
+        fn(n_word * bits_per_word + internal::count_trailing_zeros(word));
+        word &= word - 1;
+      }
+    }
+
+    MI_NODISCARD word_type live_mask(const size_t n_word) const noexcept {
+      const size_t n_live = STD min(_size - n_word * bits_per_word, bits_per_word);
+
+      return n_live == bits_per_word ? ~word_type{0} : (word_type{1} << n_live) - 1;
+    }
+
+    void clear_tail() noexcept {
+      if (!_words.empty()) {
+        _words.back() &= live_mask(_words.size() - 1);
+      }
+    }
+
+  private:
+    size_t                _size = 0;
+    STD vector<word_type> _words;
+};
+
+// Набор из size битов, бит i = predicate(i). predicate вызывается параллельно из n_threads потоков, каждый поток
+// заполняет свой непрерывный диапазон слов.
+template<class Predicate>
+MI_NODISCARD dynamic_bitset make_bitset(const size_t size, const size_t n_threads, Predicate&& predicate) {
+  dynamic_bitset result(size);
+
+  const size_t n_words = result.n_words();
+
+  parallel_chunks(n_words, STD min(n_threads, n_words), [&](size_t, const size_t first_word, const size_t last_word) {
+    dynamic_bitset::word_type* const words = result.words();
+
+    for (size_t n_word = first_word; n_word < last_word; ++n_word) {
+      const size_t first = n_word * dynamic_bitset::bits_per_word;
+      const size_t last  = STD min(first + dynamic_bitset::bits_per_word, size);
+
+      dynamic_bitset::word_type word = 0;
+
+      for (size_t i = first; i < last; ++i) {
+        word |= dynamic_bitset::word_type{predicate(i) ? 1u : 0u} << (i - first);
+      }
+
+      words[n_word] = word;
+    }
+  });
+
+  return result;
+}
+}  // namespace mi
@@ -0,0 +1,105 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "Container/MI.Bitset.h"
+
+namespace mi::test {
+namespace {
+STD vector<size_t> set_bits(const MI dynamic_bitset& bitset) {
+  STD vector<size_t> result;
+
+  bitset.for_each_set([&result](const size_t n_bit) {
+    result.push_back(n_bit);
+  });
+
+  return result;
+}
+
+STD vector<size_t> unset_bits(const MI dynamic_bitset& bitset) {
+  STD vector<size_t> result;
+
+  bitset.for_each_unset([&result](const size_t n_bit) {
+    result.push_back(n_bit);
+  });
+
+  return result;
+}
+}  // namespace
+
+TEST(Bitset, SetTestCount) {
+  MI dynamic_bitset bitset(130);
+
+  EXPECT_EQ(bitset.size(), 130);
+  EXPECT_EQ(bitset.n_words(), 3);
+  EXPECT_TRUE(bitset.none());
+
+  bitset.set(0);
+  bitset.set(63);
+  bitset.set(64);
+  bitset.set(129);
+  bitset.set(5);
+  bitset.reset(5);
+
+  EXPECT_TRUE(bitset.test(63));
+  EXPECT_FALSE(bitset[5]);
+  EXPECT_EQ(bitset.count(), 4);
+  EXPECT_THAT(set_bits(bitset), testing::ElementsAre(0, 63, 64, 129));
+
+  const STD vector<size_t> unset = unset_bits(bitset);
+
+  EXPECT_EQ(unset.size(), 126);
+  EXPECT_EQ(unset.back(), 128);
+}
+
+TEST(Bitset, TailStaysClear) {
+  MI dynamic_bitset bitset(70, true);
+
+  EXPECT_EQ(bitset.count(), 70);
+  EXPECT_TRUE(bitset.all());
+  EXPECT_EQ(bitset.words()[1], (STD uint64_t{1} << 6) - 1);
+
+  bitset.flip();
+
+  EXPECT_TRUE(bitset.none());
+  EXPECT_THAT(unset_bits(bitset).size(), 70);
+  EXPECT_EQ(~bitset, MI dynamic_bitset(70, true));
+}
+
+TEST(Bitset, Operations) {
+  const MI dynamic_bitset even = MI make_bitset(200, 3, [](const size_t i) {
+    return i % 2 == 0;
+  });
+  const MI dynamic_bitset by_three = MI make_bitset(200, 1, [](const size_t i) {
+    return i % 3 == 0;
+  });
+
+  EXPECT_EQ(even.count(), 100);
+  EXPECT_EQ((even & by_three).count(), 34);
+  EXPECT_EQ((even | by_three).count(), 133);
+
+  MI dynamic_bitset odd_by_three = by_three;
+  odd_by_three.subtract(even);
+
+  for (const size_t n_bit: set_bits(odd_by_three)) {
+    EXPECT_EQ(n_bit % 6, 3);
+  }
+
+  EXPECT_EQ(odd_by_three.count(), 33);
+}
+
+TEST(Bitset, MakeBitsetDoesNotDependOnThreads) {
+  const auto predicate = [](const size_t i) {
+    return (i * 2654435761u) % 7 < 3;
+  };
+
+  const MI dynamic_bitset expected = MI make_bitset(10'000, 1, predicate);
+
+  for (const size_t n_threads: {2, 5, 64, 1000}) {
+    EXPECT_EQ(MI make_bitset(10'000, n_threads, predicate), expected);
+  }
+
+  EXPECT_TRUE(MI make_bitset(0, 4, predicate).empty());
+}
+}  // namespace mi::test
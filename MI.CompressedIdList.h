@@ -0,0 +1,105 @@
+﻿#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Common/MI.Check.h"
+
+// Сжатый список возрастающих номеров.
+// ===================================
+//
+// Хранятся разности соседних номеров (первый - относительно -1) в формате LEB128: по 7 бит на байт, старший бит
+// байта - признак продолжения. Номера недействительных элементов обычно сгруппированы, поэтому разности малы
+// и на номер уходит 1-2 байта вместо 8.
+//
+// Произвольного доступа нет, только последовательный обход (for_each, decode).
+namespace mi {
+class compressed_id_list {
+  public:
+    using value_type = STD uint64_t;
+
+  public:
+    // id должен быть больше последнего добавленного.
+    void push_back(const value_type id) {
+      MI_CHECK(_size == 0 || id > _last);
+
+      value_type delta = _size == 0 ? id : id - _last - 1;
+
+      while (delta >= 0x80) {
+        _bytes.push_back(static_cast<STD uint8_t>(delta | 0x80));
+        delta >>= 7;
+      }
+
+      _bytes.push_back(static_cast<STD uint8_t>(delta));
+
+      _last = id;
+      ++_size;
+    }
+
+    // fn(id) для каждого номера по возрастанию.
+    template<class Fn>
+    void for_each(Fn&& fn) const {
+      value_type id    = 0;
+      size_t     shift = 0;
+      value_type delta = 0;
+      bool       first = true;
+
+      for (const STD uint8_t byte: _bytes) {
+        delta |= static_cast<value_type>(byte & 0x7f) << shift;
+        shift += 7;
+
+        if ((byte & 0x80) == 0) {
+          id    = first ? delta : id + delta + 1;
+          first = false;
+          fn(id);
+
+          delta = 0;
+          shift = 0;
+        }
+      }
+    }
+
+    MI_NODISCARD STD vector<value_type> decode() const {
+      STD vector<value_type> result;
+      result.reserve(_size);
+
+      for_each([&result](const value_type id) {
+        result.push_back(id);
+      });
+
+      return result;
+    }
+
+    void clear() noexcept {
+      _bytes.clear();
+      _size = 0;
+      _last = 0;
+    }
+
+  public:
+    MI_NODISCARD size_t size() const noexcept {
+      return _size;
+    }
+
+    MI_NODISCARD bool empty() const noexcept {
+      return _size == 0;
+    }
+
+    // Объем закодированных данных в байтах.
+    MI_NODISCARD size_t n_bytes() const noexcept {
+      return _bytes.size();
+    }
+
+    // Последний добавленный номер, список не пуст.
+    MI_NODISCARD value_type back() const {
+      MI_DCHECK(_size > 0);
+
+      return _last;
+    }
+
+  private:
+    STD vector<STD uint8_t> _bytes;
+    size_t                  _size = 0;
+    value_type              _last = 0;
+};
+}  // namespace mi
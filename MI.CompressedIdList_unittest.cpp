@@ -0,0 +1,39 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "Container/MI.CompressedIdList.h"
+
+namespace mi::test {
+TEST(CompressedIdList, RoundTrip) {
+  const STD vector<STD uint64_t> ids = {0, 1, 2, 127, 128, 300, 16'511, 16'512, 1'000'000'000'000, UINT64_MAX};
+
+  MI compressed_id_list list;
+
+  for (const STD uint64_t id: ids) {
+    list.push_back(id);
+  }
+
+  EXPECT_EQ(list.size(), ids.size());
+  EXPECT_EQ(list.back(), UINT64_MAX);
+  EXPECT_EQ(list.decode(), ids);
+}
+
+TEST(CompressedIdList, DenseIdsTakeOneByte) {
+  MI compressed_id_list list;
+
+  for (STD uint64_t id = 1'000; id < 2'000; id += 3) {
+    list.push_back(id);
+  }
+
+  // Первый номер (1000) - 2 байта, остальные разности (2) - по одному.
+  EXPECT_EQ(list.n_bytes(), list.size() + 1);
+
+  list.clear();
+
+  EXPECT_TRUE(list.empty());
+  EXPECT_TRUE(list.decode().empty());
+}
+}  // namespace mi::test
@@ -0,0 +1,248 @@
+﻿#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <utility>
+
+#include "Common/MI.Check.h"
+
+// Буфер фиксированной емкости для добавления из нескольких потоков без блокировок.
+// ================================================================================
+//
+// Потоки параллельного прохода публикуют найденные значения (например, номера невалидных элементов) в общий буфер:
+// место резервируется одним fetch_add счетчика, после чего поток пишет в свои ячейки без синхронизации. Память
+// выделяется один раз вместе с объектом (как у MI static_vector), поэтому добавление не выделяет память и не
+// блокирует другие потоки.
+//
+// При переполнении значение не записывается, а try_push_back / try_emplace_back возвращают false - вызывающий код
+// решает, что делать (прервать проход, переключиться на запасной путь), вместо MI_CHECK(!full()) в
+// MI static_vector::emplace_back. Счетчик продолжает расти, поэтому overflowed() и n_dropped() показывают, сколько
+// значений не поместилось.
+//
+// Чтобы потоки реже обращались к общему счетчику, значения можно добавлять пачками: reserve(count) резервирует
+// сразу count ячеек (при переполнении - сколько осталось), try_append копирует диапазон.
+//
+// Добавление можно вызывать из разных потоков одновременно, остальные методы - нет: содержимое читается после того,
+// как все писатели завершились (например, после MI parallel_chunks). Порядок значений зависит от планирования потоков,
+// для воспроизводимого результата его нужно отсортировать.
+//
+// MI concurrent_static_vector<STD uint64_t, 4096> failed;
+//
+// MI parallel_chunks(n_elements, n_threads, [&](size_t, const size_t first, const size_t last) {
+//   for (size_t n_element = first; n_element < last; ++n_element) {
+//     if (!is_valid(n_element) && !failed.try_push_back(n_element)) {
+//       return;
+//     }
+//   }
+// });
+namespace mi {
+template<class Ty, size_t Size>
+class concurrent_static_vector {
+  public:
+    using static_capacity = STD integral_constant<size_t, Size>;
+
+  public:
+    using container_type = STD array<Ty, Size>;
+
+  public:
+    using value_type = typename container_type::value_type;
+
+    using size_type       = typename container_type::size_type;
+    using difference_type = typename container_type::difference_type;
+
+    using pointer       = typename container_type::pointer;
+    using const_pointer = typename container_type::const_pointer;
+
+    using reference       = typename container_type::reference;
+    using const_reference = typename container_type::const_reference;
+
+    using iterator       = typename container_type::iterator;
+    using const_iterator = typename container_type::const_iterator;
+
+  public:
+    // Зарезервированные ячейки [data(); data() + size()). size() меньше запрошенного, если буфер переполнен.
+    class reservation {
+      public:
+        reservation() = default;
+
+        reservation(const pointer data, const size_type size, const bool is_complete) noexcept
+            : _data(data),
+              _size(size),
+              _is_complete(is_complete) {
+        }
+
+      public:
+        MI_NODISCARD pointer data() const noexcept {
+          return _data;
+        }
+
+        MI_NODISCARD size_type size() const noexcept {
+          return _size;
+        }
+
+        MI_NODISCARD bool empty() const noexcept {
+          return _size == 0;
+        }
+
+        // Зарезервированы все запрошенные ячейки.
+        MI_NODISCARD bool is_complete() const noexcept {
+          return _is_complete;
+        }
+
+      public:
+        MI_NODISCARD pointer begin() const noexcept {
+          return _data;
+        }
+
+        MI_NODISCARD pointer end() const noexcept {
+          return _data + _size;
+        }
+
+        MI_NODISCARD reference operator[](const size_type pos) const {
+          MI_DCHECK(pos < _size);
+
+          return _data[pos];
+        }
+
+      private:
+        pointer   _data        = nullptr;
+        size_type _size        = 0;
+        bool      _is_complete = true;
+    };
+
+  public:
+    concurrent_static_vector() = default;
+
+    // Копирование и перемещение атомарного счетчика не имеют смысла во время добавления.
+    concurrent_static_vector(const concurrent_static_vector&)            = delete;
+    concurrent_static_vector& operator=(const concurrent_static_vector&) = delete;
+
+  public:
+    // Резервирует count ячеек. Ячейки принадлежат вызывающему потоку, их нужно заполнить до чтения буфера.
+    MI_NODISCARD reservation reserve(const size_type count) noexcept {
+      if (count == 0) {
+        return {};
+      }
+
+      const size_type first = _reserved.fetch_add(count, STD memory_order_relaxed);
+
+      if (first >= max_size()) {
+        return {nullptr, 0, false};
+      }
+
+      const size_type n_reserved = STD min(count, max_size() - first);
+
+      return {_container.data() + first, n_reserved, n_reserved == count};
+    }
+
+    template<class... TyVal>
+    MI_NODISCARD bool try_emplace_back(TyVal&&... values) {
+      const size_type pos = _reserved.fetch_add(1, STD memory_order_relaxed);
+
+      if (pos >= max_size()) {
+        return false;
+      }
+
+      _container[pos] = {STD forward<TyVal>(values)...};
+
+      return true;
+    }
+
+    MI_NODISCARD bool try_push_back(const value_type& value) {
+      return try_emplace_back(value);
+    }
+
+    MI_NODISCARD bool try_push_back(value_type&& value) {
+      return try_emplace_back(STD move(value));
+    }
+
+    // Копирует [first; last) одним резервированием. Возвращает количество скопированных значений, при переполнении
+    // копируется начало диапазона.
+    template<class ItTy>
+    size_type try_append(ItTy first, const ItTy last) {
+      const reservation slots = reserve(static_cast<size_type>(STD distance(first, last)));
+
+      for (reference slot: slots) {
+        slot = *first;
+        ++first;
+      }
+
+      return slots.size();
+    }
+
+  public:
+    MI_NODISCARD size_type size() const noexcept {
+      return STD min(_reserved.load(STD memory_order_relaxed), max_size());
+    }
+
+    MI_NODISCARD static constexpr size_type max_size() noexcept {
+      return static_capacity::value;
+    }
+
+    MI_NODISCARD bool empty() const noexcept {
+      return size() == 0;
+    }
+
+    MI_NODISCARD bool full() const noexcept {
+      return size() == max_size();
+    }
+
+    // Хотя бы одно значение не поместилось.
+    MI_NODISCARD bool overflowed() const noexcept {
+      return _reserved.load(STD memory_order_relaxed) > max_size();
+    }
+
+    // Количество значений, которые не поместились.
+    MI_NODISCARD size_type n_dropped() const noexcept {
+      return _reserved.load(STD memory_order_relaxed) - size();
+    }
+
+    // Не сбрасывает содержимое ячеек, только счетчик.
+    void clear() noexcept {
+      _reserved.store(0, STD memory_order_relaxed);
+    }
+
+  public:
+    MI_NODISCARD iterator begin() noexcept {
+      return _container.begin();
+    }
+
+    MI_NODISCARD const_iterator begin() const noexcept {
+      return _container.begin();
+    }
+
+    MI_NODISCARD iterator end() noexcept {
+      return STD next(_container.begin(), static_cast<difference_type>(size()));
+    }
+
+    MI_NODISCARD const_iterator end() const noexcept {
+      return STD next(_container.begin(), static_cast<difference_type>(size()));
+    }
+
+  public:
+    MI_NODISCARD reference operator[](const size_type pos) {
+      MI_DCHECK(pos < size());
+
+      return _container[pos];
+    }
+
+    MI_NODISCARD const_reference operator[](const size_type pos) const {
+      MI_DCHECK(pos < size());
+
+      return _container[pos];
+    }
+
+    MI_NODISCARD pointer data() noexcept {
+      return _container.data();
+    }
+
+    MI_NODISCARD const_pointer data() const noexcept {
+      return _container.data();
+    }
+
+  private:
+    container_type        _container{};  // Контейнер
+    STD atomic<size_type> _reserved{0};  // Количество зарезервированных ячеек, может превышать Size
+};
+}  // namespace mi
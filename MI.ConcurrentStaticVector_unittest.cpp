@@ -0,0 +1,121 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#include "Container/MI.ConcurrentStaticVector.h"
+
+namespace mi::test {
+TEST(ConcurrentStaticVector, PushBack) {
+  MI concurrent_static_vector<int, 3> a;
+
+  EXPECT_TRUE(a.empty());
+  EXPECT_TRUE(a.try_push_back(1));
+  EXPECT_TRUE(a.try_emplace_back(2));
+  EXPECT_TRUE(a.try_push_back(3));
+  EXPECT_TRUE(a.full());
+  EXPECT_FALSE(a.overflowed());
+
+  EXPECT_THAT(a, testing::ElementsAre(1, 2, 3));
+}
+
+TEST(ConcurrentStaticVector, Overflow) {
+  MI concurrent_static_vector<int, 2> a;
+
+  EXPECT_TRUE(a.try_push_back(1));
+  EXPECT_TRUE(a.try_push_back(2));
+  EXPECT_FALSE(a.try_push_back(3));
+  EXPECT_FALSE(a.try_push_back(4));
+
+  EXPECT_EQ(a.size(), 2);
+  EXPECT_TRUE(a.overflowed());
+  EXPECT_EQ(a.n_dropped(), 2);
+  EXPECT_THAT(a, testing::ElementsAre(1, 2));
+
+  a.clear();
+
+  EXPECT_TRUE(a.empty());
+  EXPECT_FALSE(a.overflowed());
+}
+
+TEST(ConcurrentStaticVector, Reserve) {
+  MI concurrent_static_vector<int, 5> a;
+
+  auto first = a.reserve(3);
+
+  EXPECT_TRUE(first.is_complete());
+  ASSERT_EQ(first.size(), 3);
+  STD iota(first.begin(), first.end(), 10);
+
+  // Переполнение: резервируется остаток.
+  auto second = a.reserve(4);
+
+  EXPECT_FALSE(second.is_complete());
+  ASSERT_EQ(second.size(), 2);
+  second[0] = 20;
+  second[1] = 21;
+
+  EXPECT_TRUE(a.reserve(1).empty());
+  EXPECT_TRUE(a.reserve(0).is_complete());
+  EXPECT_EQ(a.n_dropped(), 3);
+  EXPECT_THAT(a, testing::ElementsAre(10, 11, 12, 20, 21));
+}
+
+TEST(ConcurrentStaticVector, Append) {
+  MI concurrent_static_vector<int, 4> a;
+
+  const STD vector<int> values = {1, 2, 3};
+
+  EXPECT_EQ(a.try_append(values.begin(), values.end()), 3);
+  EXPECT_EQ(a.try_append(values.begin(), values.end()), 1);
+  EXPECT_THAT(a, testing::ElementsAre(1, 2, 3, 1));
+}
+
+TEST(ConcurrentStaticVector, ConcurrentPushBack) {
+  constexpr size_t n_threads    = 8;
+  constexpr size_t n_per_thread = 10'000;
+
+  const auto a = STD make_unique<MI concurrent_static_vector<STD uint64_t, n_threads * n_per_thread>>();
+
+  STD vector<STD thread> threads;
+
+  for (size_t n_thread = 0; n_thread < n_threads; ++n_thread) {
+    threads.emplace_back([&a, n_thread] {
+      for (size_t i = 0; i < n_per_thread; ++i) {
+        // Половина значений пачками по 4.
+        if (i % 8 == 0) {
+          const STD uint64_t batch[] = {n_thread * n_per_thread + i,
+                                        n_thread * n_per_thread + i + 1,
+                                        n_thread * n_per_thread + i + 2,
+                                        n_thread * n_per_thread + i + 3};
+
+          EXPECT_EQ(a->try_append(STD begin(batch), STD end(batch)), 4);
+
+          i += 3;
+        } else {
+          EXPECT_TRUE(a->try_push_back(n_thread * n_per_thread + i));
+        }
+      }
+    });
+  }
+
+  for (STD thread& thread: threads) {
+    thread.join();
+  }
+
+  STD vector<STD uint64_t> values(a->begin(), a->end());
+  STD sort(values.begin(), values.end());
+
+  STD vector<STD uint64_t> expected(n_threads * n_per_thread);
+  STD iota(expected.begin(), expected.end(), STD uint64_t{0});
+
+  EXPECT_EQ(values, expected);
+  EXPECT_TRUE(a->full());
+  EXPECT_FALSE(a->overflowed());
+}
+}  // namespace mi::test
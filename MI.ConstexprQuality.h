@@ -0,0 +1,142 @@
+﻿#pragma once
+
+#include <cstddef>
+#include <limits>
+
+#include "Common/MI.Check.h"
+#include "Mesh/MI.QualityGradient.h"
+
+// Mean ratio quality (m = 2) треугольника и quad, вычислимая на этапе компиляции.
+// ================================================================================
+//
+// MI quality использует STD pow, нормирование векторов (STD sqrt) и обращение весовой матрицы во время выполнения,
+// поэтому не может быть constexpr. Здесь та же формула, что и в MI mean_ratio_quality:
+//
+// q = 2 * a * d * |c| / F,  c = e1 x e2,  F = |a * e1|^2 + |b * e1 + d * e2|^2,
+//
+// с весами MI internal::triangle_mean_ratio_weights / quad_mean_ratio_weights. Единственный корень (|c|) считается
+// методом Ньютона (MI internal::constexpr_sqrt), поэтому результат совпадает с MI mean_ratio_quality с точностью
+// до единиц последнего знака.
+//
+// Координаты передаются литералами, элемент действителен, если нормали всех симплекс-узлов смотрят в одну сторону
+// с нормалью элемента (MI element_normal), для недействительного элемента возвращается 0:
+//
+// static_assert(MI constexpr_quality({{0., 0., 0.}, {1., 0., 0.}, {1., 1., 0.}, {0., 1., 0.}}) == 1.);
+namespace mi {
+namespace internal {
+struct constexpr_point3d {
+    double x;
+    double y;
+    double z;
+};
+
+constexpr constexpr_point3d operator-(const constexpr_point3d& l, const constexpr_point3d& r) noexcept {
+  return {l.x - r.x, l.y - r.y, l.z - r.z};
+}
+
+constexpr double dot(const constexpr_point3d& l, const constexpr_point3d& r) noexcept {
+  return l.x * r.x + l.y * r.y + l.z * r.z;
+}
+
+constexpr constexpr_point3d cross(const constexpr_point3d& l, const constexpr_point3d& r) noexcept {
+  return {l.y * r.z - l.z * r.y, l.z * r.x - l.x * r.z, l.x * r.y - l.y * r.x};
+}
+
+// Квадратный корень методом Ньютона. Аргумент сначала масштабируется степенями 4 в [1; 4), затем итерации идут
+// сверху и останавливаются, как только значение перестает уменьшаться (не больше 6-7 итераций).
+constexpr double constexpr_sqrt(double value) noexcept {
+  // Отрицательные значения и NaN здесь не встречаются (аргумент - квадрат длины).
+  if (!(value > 0.) || value > STD numeric_limits<double>::max()) {
+    return value > 0. ? value : 0.;
+  }
+
+  double scale = 1.;
+
+  while (value >= 4.) {
+    value *= 0.25;
+    scale *= 2.;
+  }
+
+  while (value < 1.) {
+    value *= 4.;
+    scale *= 0.5;
+  }
+
+  double result = 2.;
+
+  for (;;) {
+    const double next = 0.5 * (result + value / result);
+
+    if (!(next < result)) {
+      return result * scale;
+    }
+
+    result = next;
+  }
+}
+
+constexpr double constexpr_simplex_quality(const constexpr_point3d&  left,
+                                           const constexpr_point3d&  mid,
+                                           const constexpr_point3d&  right,
+                                           const mean_ratio_weights& w,
+                                           const constexpr_point3d&  reference_normal) noexcept {
+  const constexpr_point3d e1 = right - mid;
+  const constexpr_point3d e2 = left - mid;
+  const constexpr_point3d c  = cross(e1, e2);
+
+  if (!(dot(c, reference_normal) > 0.)) {
+    return -1.;
+  }
+
+  const constexpr_point3d s1 = {w.a * e1.x, w.a * e1.y, w.a * e1.z};
+  const constexpr_point3d s2 = {w.b * e1.x + w.d * e2.x, w.b * e1.y + w.d * e2.y, w.b * e1.z + w.d * e2.z};
+
+  return 2. * w.a * w.d * constexpr_sqrt(dot(c, c)) / (dot(s1, s1) + dot(s2, s2));
+}
+}  // namespace internal
+
+// Качество треугольника (3 вершины) или quad (4 вершины, в порядке обхода). 0 для недействительного элемента.
+template<size_t NodesPerElement>
+MI_NODISCARD constexpr double constexpr_quality(const double (&p)[NodesPerElement][3]) noexcept {
+  static_assert(NodesPerElement == 3 || NodesPerElement == 4,
+                "constexpr_quality: only triangles and quads are supported");
+
+  internal::constexpr_point3d v[NodesPerElement] = {};
+
+  for (size_t i = 0; i < NodesPerElement; ++i) {
+    v[i] = {p[i][0], p[i][1], p[i][2]};
+  }
+
+  if constexpr (NodesPerElement == 3) {
+    const internal::constexpr_point3d normal = cross(v[1] - v[0], v[2] - v[0]);
+    const double                      result =
+      internal::constexpr_simplex_quality(v[2], v[0], v[1], internal::triangle_mean_ratio_weights, normal);
+
+    return result > 0. ? result : 0.;
+  } else {
+    const internal::constexpr_point3d normal = cross(v[2] - v[0], v[3] - v[1]);
+
+    double result = 0.;
+
+    // Симплекс-узлы как в MI quad::simplex_node: mid = n, right = n + 1, left = n - 1.
+    for (size_t n_node = 0; n_node < 4; ++n_node) {
+      const double node_quality = internal::constexpr_simplex_quality(
+        v[(n_node + 3) % 4], v[n_node], v[(n_node + 1) % 4], internal::quad_mean_ratio_weights, normal);
+
+      if (!(node_quality > 0.)) {
+        return 0.;
+      }
+
+      result += node_quality;
+    }
+
+    return result / 4.;
+  }
+}
+
+// Проверка ядра на этапе сборки: правильные элементы имеют качество 1, вырожденные и невыпуклые - 0.
+static_assert(constexpr_quality({{0., 0., 0.}, {1., 0., 0.}, {1., 1., 0.}, {0., 1., 0.}}) == 1.);
+static_assert(constexpr_quality({{0., 0., 0.}, {2., 0., 0.}, {1., 1.7320508075688772, 0.}}) > 1. - 1e-15);
+static_assert(constexpr_quality({{0., 0., 0.}, {1., 0., 0.}, {2., 0., 0.}}) == 0.);
+static_assert(constexpr_quality({{0., 0., 0.}, {2., 0., 0.}, {0.5, 0.5, 0.}, {0., 2., 0.}}) == 0.);
+}  // namespace mi
@@ -0,0 +1,75 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cmath>
+#include <random>
+
+#include "Mesh/MI.ConstexprQuality.h"
+#include "Mesh/MI.QualityGradient.h"
+
+namespace mi::test {
+namespace {
+// Таблица эталонных элементов: считается при компиляции, во время выполнения - только чтение.
+constexpr double reference_quality[] = {
+  MI constexpr_quality({{0., 0., 0.}, {1., 0., 0.}, {0.5, 0.86602540378443865, 0.}}),  // Правильный треугольник
+  MI constexpr_quality({{0., 0., 0.}, {1., 0., 0.}, {0., 1., 0.}}),                     // Прямоугольный треугольник
+  MI constexpr_quality({{0., 0., 0.}, {2., 0., 0.}, {2., 1., 0.}, {0., 1., 0.}}),       // Прямоугольник 2 x 1
+  MI constexpr_quality({{0., 0., 0.}, {1., 0., 0.}, {1., 1., 0.}, {0., 1., 1.}}),       // Неплоский quad
+};
+
+static_assert(reference_quality[0] > 1. - 1e-15 && reference_quality[0] <= 1.);
+static_assert(reference_quality[1] > 0.86 && reference_quality[1] < 0.87);  // √3 / 2
+static_assert(reference_quality[2] == 0.8);
+static_assert(reference_quality[3] > 0. && reference_quality[3] < 1.);
+
+static_assert(MI internal::constexpr_sqrt(0.) == 0.);
+static_assert(MI internal::constexpr_sqrt(16.) == 4.);
+static_assert(MI internal::constexpr_sqrt(0.0625) == 0.25);
+}  // namespace
+
+TEST(ConstexprQuality, ReferenceTable) {
+  EXPECT_NEAR(reference_quality[0], 1., 1e-15);
+  EXPECT_NEAR(reference_quality[1], STD sqrt(3.) / 2., 1e-15);
+  EXPECT_NEAR(reference_quality[3],
+              MI mean_ratio_quality(STD array<MI point3d, 4>{
+                {{0., 0., 0.}, {1., 0., 0.}, {1., 1., 0.}, {0., 1., 1.}}
+              }),
+              1e-15);
+}
+
+TEST(ConstexprQuality, MatchesMeanRatioQuality) {
+  STD mt19937                            generator(7);
+  STD uniform_real_distribution<double> coordinate(-1., 1.);
+
+  for (size_t n_test = 0; n_test < 1000; ++n_test) {
+    double                   p[4][3];
+    double                   t[3][3];
+    STD array<MI point3d, 4> quad;
+    STD array<MI point3d, 3> triangle;
+
+    for (size_t i = 0; i < 4; ++i) {
+      for (size_t axis = 0; axis < 3; ++axis) {
+        p[i][axis] = coordinate(generator);
+
+        if (i < 3) {
+          t[i][axis] = p[i][axis];
+        }
+      }
+
+      quad[i] = {p[i][0], p[i][1], p[i][2]};
+    }
+
+    triangle = {quad[0], quad[1], quad[2]};
+
+    EXPECT_NEAR(MI constexpr_quality(p), MI mean_ratio_quality(quad), 1e-14);
+    EXPECT_NEAR(MI constexpr_quality(t), MI mean_ratio_quality(triangle), 1e-14);
+  }
+}
+
+TEST(ConstexprQuality, Sqrt) {
+  for (const double value: {1e-300, 1e-5, 0.5, 2., 3., 12345.678, 1e300}) {
+    EXPECT_NEAR(MI internal::constexpr_sqrt(value), STD sqrt(value), 2e-16 * STD sqrt(value));
+  }
+}
+}  // namespace mi::test
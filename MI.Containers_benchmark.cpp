@@ -0,0 +1,224 @@
+#include <benchmark/benchmark.h>
+
+#include <deque>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "Container/MI.ConcurrentStaticVector.h"
+#include "Container/MI.Sortable.h"
+#include "Container/MI.StaticDeque.h"
+#include "Container/MI.StaticVector.h"
+
+// Производительность static_vector, concurrent_static_vector, static_deque и sortable.
+//
+// Запуск с сохранением результатов для сравнения между коммитами:
+// MI.Containers_benchmark --benchmark_format=json --benchmark_out=containers.json
+
+namespace mi::benchmark {
+namespace {
+template<class Ty>
+Ty make_value(const size_t i) {
+  return static_cast<Ty>(i * 7 + 3);
+}
+
+template<class Ty, size_t Size>
+MI static_vector<Ty, Size> make_full() {
+  MI static_vector<Ty, Size> result;
+
+  for (size_t i = 0; i < Size; ++i) {
+    result.emplace_back(make_value<Ty>(i));
+  }
+
+  return result;
+}
+}  // namespace
+
+template<class Ty, size_t Size>
+void BM_StaticVectorConstruct(::benchmark::State& state) {
+  for (auto _: state) {
+    MI static_vector<Ty, Size> value;
+    ::benchmark::DoNotOptimize(value);
+  }
+}
+
+template<class Ty, size_t Size>
+void BM_StaticVectorCopy(::benchmark::State& state) {
+  const MI static_vector<Ty, Size> source = make_full<Ty, Size>();
+
+  for (auto _: state) {
+    MI static_vector<Ty, Size> copy(source);
+    ::benchmark::DoNotOptimize(copy);
+  }
+}
+
+template<class Ty, size_t Size>
+void BM_StaticVectorMove(::benchmark::State& state) {
+  MI static_vector<Ty, Size> source = make_full<Ty, Size>();
+
+  for (auto _: state) {
+    MI static_vector<Ty, Size> moved(STD move(source));
+    ::benchmark::DoNotOptimize(moved);
+    source = STD move(moved);
+  }
+}
+
+template<class Ty, size_t Size>
+void BM_StaticVectorClear(::benchmark::State& state) {
+  MI static_vector<Ty, Size> value = make_full<Ty, Size>();
+
+  for (auto _: state) {
+    value.clear();
+    ::benchmark::DoNotOptimize(value);
+  }
+}
+
+template<class Ty, size_t Size>
+void BM_StaticVectorEmplaceBack(::benchmark::State& state) {
+  for (auto _: state) {
+    MI static_vector<Ty, Size> value;
+
+    for (size_t i = 0; i < Size; ++i) {
+      value.emplace_back(make_value<Ty>(i));
+    }
+
+    ::benchmark::DoNotOptimize(value);
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(Size));
+}
+
+template<class Ty, size_t Size>
+void BM_StaticVectorContains(::benchmark::State& state) {
+  const MI static_vector<Ty, Size> value = make_full<Ty, Size>();
+
+  // Худший случай - значения нет.
+  const Ty missing = make_value<Ty>(Size + 1);
+
+  for (auto _: state) {
+    ::benchmark::DoNotOptimize(value.contains(missing));
+  }
+}
+
+template<class Ty, size_t Size>
+void BM_StaticVectorHash(::benchmark::State& state) {
+  const MI static_vector<Ty, Size> value = make_full<Ty, Size>();
+
+  for (auto _: state) {
+    ::benchmark::DoNotOptimize(MI hash<MI static_vector<Ty, Size>>{}(value));
+  }
+}
+
+// Добавление в concurrent_static_vector из одного потока пачками по Batch значений (1 - try_push_back): стоимость
+// fetch_add без конкуренции по сравнению с BM_StaticVectorEmplaceBack.
+template<size_t Size, size_t Batch>
+void BM_ConcurrentStaticVectorPushBack(::benchmark::State& state) {
+  const auto value = STD make_unique<MI concurrent_static_vector<size_t, Size>>();
+
+  for (auto _: state) {
+    value->clear();
+
+    for (size_t i = 0; i < Size; i += Batch) {
+      if constexpr (Batch == 1) {
+        ::benchmark::DoNotOptimize(value->try_push_back(make_value<size_t>(i)));
+      } else {
+        size_t n_value = i;
+
+        for (size_t& slot: value->reserve(Batch)) {
+          slot = make_value<size_t>(n_value++);
+        }
+      }
+    }
+
+    ::benchmark::DoNotOptimize(value->data());
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(Size));
+}
+
+// Очередь обхода в ширину полного двоичного дерева из 63 вершин: из начала извлекается вершина, в конец добавляются ее
+// потомки. Deque - MI static_deque<size_t, 64> или STD deque<size_t>.
+template<class Deque>
+void BM_DequeBreadthFirst(::benchmark::State& state) {
+  constexpr size_t n_values = 64;
+
+  for (auto _: state) {
+    Deque  queue;
+    size_t sum = 0;
+
+    queue.push_back(size_t{0});
+
+    while (!queue.empty()) {
+      const size_t value = queue.front();
+      queue.pop_front();
+      sum += value;
+
+      if (2 * value + 2 < n_values) {
+        queue.push_back(2 * value + 1);
+        queue.push_back(2 * value + 2);
+      }
+    }
+
+    ::benchmark::DoNotOptimize(sum);
+  }
+}
+
+// Построение sortable из неотсортированных значений (худший случай - обратный порядок).
+template<size_t Size>
+void BM_SortableConstruct(::benchmark::State& state) {
+  STD array<int, Size> values{};
+  STD iota(values.rbegin(), values.rend(), 0);
+
+  for (auto _: state) {
+    MI sortable<int, Size> value(values.begin(), values.end());
+    ::benchmark::DoNotOptimize(value);
+  }
+}
+
+#define MI_STATIC_VECTOR_BENCHMARKS(Name)                                                                              \
+  BENCHMARK_TEMPLATE(Name, int, 3);                                                                                    \
+  BENCHMARK_TEMPLATE(Name, int, 8);                                                                                    \
+  BENCHMARK_TEMPLATE(Name, int, 27);                                                                                   \
+  BENCHMARK_TEMPLATE(Name, size_t, 3);                                                                                 \
+  BENCHMARK_TEMPLATE(Name, size_t, 27);                                                                                \
+  BENCHMARK_TEMPLATE(Name, double, 3);                                                                                 \
+  BENCHMARK_TEMPLATE(Name, double, 27)
+
+MI_STATIC_VECTOR_BENCHMARKS(BM_StaticVectorConstruct);
+MI_STATIC_VECTOR_BENCHMARKS(BM_StaticVectorCopy);
+MI_STATIC_VECTOR_BENCHMARKS(BM_StaticVectorMove);
+MI_STATIC_VECTOR_BENCHMARKS(BM_StaticVectorClear);
+MI_STATIC_VECTOR_BENCHMARKS(BM_StaticVectorEmplaceBack);
+MI_STATIC_VECTOR_BENCHMARKS(BM_StaticVectorContains);
+MI_STATIC_VECTOR_BENCHMARKS(BM_StaticVectorHash);
+
+BENCHMARK_TEMPLATE(BM_StaticVectorEmplaceBack, size_t, 4096);
+BENCHMARK_TEMPLATE(BM_ConcurrentStaticVectorPushBack, 4096, 1);
+BENCHMARK_TEMPLATE(BM_ConcurrentStaticVectorPushBack, 4096, 8);
+BENCHMARK_TEMPLATE(BM_ConcurrentStaticVectorPushBack, 4096, 64);
+
+BENCHMARK_TEMPLATE(BM_DequeBreadthFirst, MI static_deque<size_t, 64>);
+BENCHMARK_TEMPLATE(BM_DequeBreadthFirst, STD deque<size_t>);
+
+BENCHMARK_TEMPLATE(BM_SortableConstruct, 2);
+BENCHMARK_TEMPLATE(BM_SortableConstruct, 3);
+BENCHMARK_TEMPLATE(BM_SortableConstruct, 4);
+BENCHMARK_TEMPLATE(BM_SortableConstruct, 5);
+BENCHMARK_TEMPLATE(BM_SortableConstruct, 6);
+BENCHMARK_TEMPLATE(BM_SortableConstruct, 7);
+BENCHMARK_TEMPLATE(BM_SortableConstruct, 8);
+BENCHMARK_TEMPLATE(BM_SortableConstruct, 9);
+BENCHMARK_TEMPLATE(BM_SortableConstruct, 10);
+BENCHMARK_TEMPLATE(BM_SortableConstruct, 11);
+BENCHMARK_TEMPLATE(BM_SortableConstruct, 12);
+BENCHMARK_TEMPLATE(BM_SortableConstruct, 13);
+BENCHMARK_TEMPLATE(BM_SortableConstruct, 14);
+BENCHMARK_TEMPLATE(BM_SortableConstruct, 15);
+BENCHMARK_TEMPLATE(BM_SortableConstruct, 16);
+BENCHMARK_TEMPLATE(BM_SortableConstruct, 17);
+BENCHMARK_TEMPLATE(BM_SortableConstruct, 18);
+BENCHMARK_TEMPLATE(BM_SortableConstruct, 19);
+}  // namespace mi::benchmark
+
+BENCHMARK_MAIN();
@@ -0,0 +1,326 @@
+﻿#pragma once
+
+#include "Common/MI.Check.h"
+
+#if MI_CPP_VERSION == 20
+  #include <condition_variable>
+  #include <coroutine>
+  #include <deque>
+  #include <exception>
+  #include <mutex>
+  #include <optional>
+  #include <thread>
+  #include <utility>
+  #include <vector>
+
+  #include "Common/MI.ParallelFor.h"
+
+// Минимальный набор для конвейеров на сопрограммах C++20.
+// =====================================================
+//
+// - coroutine_pool        - пул потоков, выполняющий готовые к продолжению сопрограммы. co_await pool.schedule()
+//                           переносит сопрограмму в пул.
+// - detached_task         - сопрограмма, которая запускается сразу и сама уничтожает свой кадр по завершении.
+//                           Ожидание завершения - на стороне вызывающего (например, STD latch).
+// - async_bounded_queue   - очередь ограниченной емкости. push приостанавливает сопрограмму, пока очередь
+//                           заполнена, pop - пока она пуста, поток при этом не блокируется. Приостановленная
+//                           сопрограмма продолжается в пуле, переданном в push/pop.
+//
+// Пример:
+//
+// MI coroutine_pool             pool(4);
+// MI async_bounded_queue<block> queue(8);
+//
+// MI detached_task consume(MI coroutine_pool& pool, MI async_bounded_queue<block>& queue, STD latch& done) {
+//   co_await pool.schedule();
+//
+//   while (STD optional<block> item = co_await queue.pop(pool)) {
+//     ...
+//   }
+//
+//   done.count_down();
+// }
+namespace mi {
+class coroutine_pool {
+  public:
+    explicit coroutine_pool(const size_t n_threads = MI default_thread_count()) {
+      const size_t count = STD max(n_threads, size_t{1});
+
+      _threads.reserve(count);
+
+      for (size_t i = 0; i < count; ++i) {
+        _threads.emplace_back([this]() {
+          run();
+        });
+      }
+    }
+
+    coroutine_pool(const coroutine_pool&)            = delete;
+    coroutine_pool& operator=(const coroutine_pool&) = delete;
+
+    // Дожидается выполнения всех поставленных в очередь сопрограмм.
+    ~coroutine_pool() {
+      {
+        const STD lock_guard lock(_mutex);
+        _is_stopped = true;
+      }
+
+      _has_work.notify_all();
+
+      for (auto& thread: _threads) {
+        thread.join();
+      }
+    }
+
+  public:
+    MI_NODISCARD size_t size() const noexcept {
+      return _threads.size();
+    }
+
+    // Продолжить сопрограмму в одном из потоков пула.
+    void post(const STD coroutine_handle<> handle) {
+      {
+        const STD lock_guard lock(_mutex);
+        _ready.push_back(handle);
+      }
+
+      _has_work.notify_one();
+    }
+
+    MI_NODISCARD auto schedule() noexcept {
+      struct awaiter {
+          coroutine_pool& pool;
+
+          bool await_ready() const noexcept {
+            return false;
+          }
+
+          void await_suspend(const STD coroutine_handle<> handle) const {
+            pool.post(handle);
+          }
+
+          void await_resume() const noexcept {
+          }
+      };
+
+      return awaiter{*this};
+    }
+
+  private:
+    void run() {
+      for (;;) {
+        STD coroutine_handle<> handle;
+
+        {
+          STD unique_lock lock(_mutex);
+          _has_work.wait(lock, [this]() {
+            return _is_stopped || !_ready.empty();
+          });
+
+          if (_ready.empty()) {
+            return;
+          }
+
+          handle = _ready.front();
+          _ready.pop_front();
+        }
+
+        handle.resume();
+      }
+    }
+
+  private:
+    STD mutex                         _mutex;
+    STD condition_variable            _has_work;
+    STD deque<STD coroutine_handle<>> _ready;
+    bool                              _is_stopped = false;
+    STD vector<STD thread>            _threads;
+};
+
+struct detached_task {
+    struct promise_type {
+        detached_task get_return_object() const noexcept {
+          return {};
+        }
+
+        STD suspend_never initial_suspend() const noexcept {
+          return {};
+        }
+
+        STD suspend_never final_suspend() const noexcept {
+          return {};
+        }
+
+        void return_void() const noexcept {
+        }
+
+        // Исключения в проекте не используются.
+        void unhandled_exception() const noexcept {
+          STD terminate();
+        }
+    };
+};
+
+template<class Ty>
+class async_bounded_queue {
+  public:
+    using value_type = Ty;
+
+  public:
+    explicit async_bounded_queue(const size_t capacity)
+        : _capacity(capacity) {
+      MI_CHECK(capacity > 0);
+    }
+
+    async_bounded_queue(const async_bounded_queue&)            = delete;
+    async_bounded_queue& operator=(const async_bounded_queue&) = delete;
+
+  public:
+    // co_await queue.push(value, pool): значение передается ожидающему pop или кладется в очередь. Если очередь
+    // заполнена, сопрограмма приостанавливается и продолжается в pool, когда место освободится.
+    MI_NODISCARD auto push(Ty value, coroutine_pool& pool) {
+      struct awaiter {
+          async_bounded_queue& queue;
+          coroutine_pool&      pool;
+          Ty                   value;
+
+          bool await_ready() const noexcept {
+            return false;
+          }
+
+          bool await_suspend(const STD coroutine_handle<> handle) {
+            return queue.suspend_push(handle, pool, value);
+          }
+
+          void await_resume() const noexcept {
+          }
+      };
+
+      return awaiter{*this, pool, STD move(value)};
+    }
+
+    // co_await queue.pop(pool): очередное значение или STD nullopt, если очередь закрыта и пуста. Если очередь
+    // пуста, сопрограмма приостанавливается и продолжается в pool, когда появится значение или очередь закроется.
+    MI_NODISCARD auto pop(coroutine_pool& pool) {
+      struct awaiter {
+          async_bounded_queue& queue;
+          coroutine_pool&      pool;
+          STD optional<Ty>     result;
+
+          bool await_ready() const noexcept {
+            return false;
+          }
+
+          bool await_suspend(const STD coroutine_handle<> handle) {
+            return queue.suspend_pop(handle, pool, result);
+          }
+
+          STD optional<Ty> await_resume() {
+            return STD move(result);
+          }
+      };
+
+      return awaiter{*this, pool, STD nullopt};
+    }
+
+    // Больше значений не будет: ожидающие pop получают STD nullopt. push после close недопустим.
+    void close() {
+      STD vector<pop_waiter> poppers;
+
+      {
+        const STD lock_guard lock(_mutex);
+        MI_DCHECK(_pushers.empty());
+
+        _is_closed = true;
+        poppers.assign(_poppers.begin(), _poppers.end());
+        _poppers.clear();
+      }
+
+      for (const pop_waiter& waiter: poppers) {
+        waiter.pool->post(waiter.handle);
+      }
+    }
+
+  private:
+    struct push_waiter {
+        STD coroutine_handle<> handle;
+        coroutine_pool*        pool;
+        Ty*                    value;
+    };
+
+    struct pop_waiter {
+        STD coroutine_handle<> handle;
+        coroutine_pool*        pool;
+        STD optional<Ty>*      result;
+    };
+
+  private:
+    // true - сопрограмма приостановлена до освобождения места.
+    bool suspend_push(const STD coroutine_handle<> handle, coroutine_pool& pool, Ty& value) {
+      STD unique_lock lock(_mutex);
+      MI_DCHECK(!_is_closed);
+
+      if (!_poppers.empty()) {
+        const pop_waiter waiter = _poppers.front();
+        _poppers.pop_front();
+        lock.unlock();
+
+        *waiter.result = STD move(value);
+        waiter.pool->post(waiter.handle);
+
+        return false;
+      }
+
+      if (_items.size() < _capacity) {
+        _items.push_back(STD move(value));
+
+        return false;
+      }
+
+      _pushers.push_back({handle, &pool, &value});
+
+      return true;
+    }
+
+    // true - сопрограмма приостановлена до появления значения или закрытия очереди.
+    bool suspend_pop(const STD coroutine_handle<> handle, coroutine_pool& pool, STD optional<Ty>& result) {
+      STD unique_lock lock(_mutex);
+
+      if (!_items.empty()) {
+        result = STD move(_items.front());
+        _items.pop_front();
+
+        // Освободилось место: значение первой ожидающей push сопрограммы переходит в очередь.
+        if (!_pushers.empty()) {
+          const push_waiter waiter = _pushers.front();
+          _pushers.pop_front();
+
+          _items.push_back(STD move(*waiter.value));
+          lock.unlock();
+
+          waiter.pool->post(waiter.handle);
+        }
+
+        return false;
+      }
+
+      if (_is_closed) {
+        return false;
+      }
+
+      _poppers.push_back({handle, &pool, &result});
+
+      return true;
+    }
+
+  private:
+    const size_t _capacity;
+
+    STD mutex              _mutex;
+    STD deque<Ty>          _items;
+    STD deque<push_waiter> _pushers;
+    STD deque<pop_waiter>  _poppers;
+    bool                   _is_closed = false;
+};
+}  // namespace mi
+#endif
@@ -0,0 +1,111 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "Common/MI.Check.h"
+
+#if MI_CPP_VERSION == 20
+  #include <atomic>
+  #include <latch>
+  #include <vector>
+
+  #include "Common/MI.Coroutine.h"
+
+namespace mi::test {
+namespace {
+MI detached_task produce(MI coroutine_pool&           pool,
+                         MI async_bounded_queue<int>& queue,
+                         const int                    count,
+                         STD atomic<int>&             in_flight,
+                         STD atomic<int>&             max_in_flight,
+                         STD latch&                   done) {
+  co_await pool.schedule();
+
+  for (int i = 0; i < count; ++i) {
+    const int current = ++in_flight;
+    int       maximum = max_in_flight.load();
+
+    while (current > maximum && !max_in_flight.compare_exchange_weak(maximum, current)) {
+    }
+
+    co_await queue.push(i, pool);
+  }
+
+  queue.close();
+  done.count_down();
+}
+
+MI detached_task consume(MI coroutine_pool&           pool,
+                         MI async_bounded_queue<int>& queue,
+                         STD vector<int>&             received,
+                         STD atomic<int>&             in_flight,
+                         STD latch&                   done) {
+  co_await pool.schedule();
+
+  while (const STD optional<int> value = co_await queue.pop(pool)) {
+    received.push_back(*value);
+    --in_flight;
+  }
+
+  done.count_down();
+}
+}  // namespace
+
+TEST(Coroutine, QueuePreservesOrder) {
+  STD vector<int> received;
+  STD atomic<int> in_flight     = 0;
+  STD atomic<int> max_in_flight = 0;
+
+  {
+    STD latch                   done(2);
+    MI async_bounded_queue<int> queue(2);
+    MI coroutine_pool           producer_pool(1);
+    MI coroutine_pool           consumer_pool(1);
+
+    consume(consumer_pool, queue, received, in_flight, done);
+    produce(producer_pool, queue, 1000, in_flight, max_in_flight, done);
+
+    done.wait();
+  }
+
+  ASSERT_EQ(received.size(), 1000);
+
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_EQ(received[i], i);
+  }
+
+  // Емкость 2 плюс значение, которое ждет места, и значение, которое уже передано потребителю.
+  EXPECT_LE(max_in_flight.load(), 4);
+}
+
+TEST(Coroutine, CloseWakesAllConsumers) {
+  constexpr size_t n_consumers = 8;
+
+  STD vector<STD vector<int>> received(n_consumers);
+  STD atomic<int>             in_flight     = 0;
+  STD atomic<int>             max_in_flight = 0;
+
+  {
+    STD latch                   done(n_consumers + 1);
+    MI async_bounded_queue<int> queue(1);
+    MI coroutine_pool           pool(3);
+
+    for (auto& local: received) {
+      consume(pool, queue, local, in_flight, done);
+    }
+
+    produce(pool, queue, 500, in_flight, max_in_flight, done);
+
+    done.wait();
+  }
+
+  size_t total = 0;
+
+  for (const auto& local: received) {
+    EXPECT_TRUE(STD is_sorted(local.begin(), local.end()));
+    total += local.size();
+  }
+
+  EXPECT_EQ(total, 500);
+}
+}  // namespace mi::test
+#endif
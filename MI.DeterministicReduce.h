@@ -0,0 +1,232 @@
+﻿#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+#include "Common/MI.Check.h"
+#include "Common/MI.ParallelFor.h"
+
+// Воспроизводимые параллельные суммы.
+// ===================================
+//
+// Сложение double не ассоциативно: если каждый поток суммирует свой кусок, а затем суммы кусков складываются,
+// результат зависит от количества потоков в последних битах, и эталонные значения в регрессионных тестах перестают
+// совпадать при смене числа ядер.
+//
+// Здесь порядок сложения зависит только от количества слагаемых:
+//
+// 1. Слагаемые делятся на листья по reduction_block_size подряд идущих значений (граница листа не зависит от кусков
+//    потоков). Внутри листа значение i добавляется в накопитель i % reduction_lanes, затем накопители складываются
+//    попарно. Независимые накопители компилятор векторизует без переупорядочения сложений (без -ffast-math).
+// 2. Суммы листьев складываются деревом попарного суммирования, форма которого задается только числом листьев.
+//
+// Потоки считают только суммы своих листьев, поэтому результат побитово совпадает при любом n_threads, а скорость
+// близка к обычной параллельной сумме. Попарное суммирование к тому же точнее последовательного: ошибка растет как
+// O(log n), а не O(n).
+//
+// Несколько сумм за один проход - deterministic_sums<N>(count, n_threads, fn), где fn(i) возвращает
+// STD array<double, N>.
+namespace mi {
+namespace internal {
+constexpr size_t reduction_block_size = 1024;
+constexpr size_t reduction_lanes      = 8;
+
+template<size_t N>
+MI_NODISCARD STD array<double, N> add(const STD array<double, N>& left, const STD array<double, N>& right) noexcept {
+  STD array<double, N> result;
+
+  for (size_t k = 0; k < N; ++k) {
+    result[k] = left[k] + right[k];
+  }
+
+  return result;
+}
+
+// Сумма листа [first; last), first кратно reduction_block_size.
+template<size_t N, class Fn>
+MI_NODISCARD STD array<double, N> leaf_sum(const size_t first, const size_t last, Fn& fn) {
+  double lanes[reduction_lanes][N] = {};
+
+  size_t i = first;
+
+  for (; i + reduction_lanes <= last; i += reduction_lanes) {
+    for (size_t lane = 0; lane < reduction_lanes; ++lane) {
+      const STD array<double, N> value = fn(i + lane);
+
+      for (size_t k = 0; k < N; ++k) {
+        lanes[lane][k] += value[k];
+      }
+    }
+  }
+
+  for (size_t lane = 0; i < last; ++i, ++lane) {
+    const STD array<double, N> value = fn(i);
+
+    for (size_t k = 0; k < N; ++k) {
+      lanes[lane][k] += value[k];
+    }
+  }
+
+  // Попарно: (0 + 1) + (2 + 3), ... .
+  for (size_t width = 1; width < reduction_lanes; width *= 2) {
+    for (size_t lane = 0; lane < reduction_lanes; lane += 2 * width) {
+      for (size_t k = 0; k < N; ++k) {
+        lanes[lane][k] += lanes[lane + width][k];
+      }
+    }
+  }
+
+  STD array<double, N> result;
+
+  for (size_t k = 0; k < N; ++k) {
+    result[k] = lanes[0][k];
+  }
+
+  return result;
+}
+
+// Попарная сумма [first; last), форма дерева зависит только от last - first.
+template<size_t N>
+MI_NODISCARD STD array<double, N> pairwise_sum(const STD array<double, N>* const sums,
+                                               const size_t                      first,
+                                               const size_t                      last) {
+  MI_DCHECK(first < last);
+
+  if (last - first == 1) {
+    return sums[first];
+  }
+
+  const size_t middle = first + (last - first) / 2;
+
+  return add(pairwise_sum(sums, first, middle), pairwise_sum(sums, middle, last));
+}
+}  // namespace internal
+
+template<size_t N, class Fn>
+MI_NODISCARD STD array<double, N> deterministic_sums(const size_t count, const size_t n_threads, Fn&& fn) {
+  using internal::reduction_block_size;
+
+  if (count == 0) {
+    return {};
+  }
+
+  const size_t n_leaves = (count + reduction_block_size - 1) / reduction_block_size;
+
+  STD vector<STD array<double, N>> leaves(n_leaves);
+
+  parallel_chunks(n_leaves, STD min(n_threads, n_leaves), [&](size_t, const size_t first_leaf, const size_t last_leaf) {
+    for (size_t n_leaf = first_leaf; n_leaf < last_leaf; ++n_leaf) {
+      const size_t first = n_leaf * reduction_block_size;
+      const size_t last  = STD min(first + reduction_block_size, count);
+
+      leaves[n_leaf] = internal::leaf_sum<N>(first, last, fn);
+    }
+  });
+
+  return internal::pairwise_sum(leaves.data(), 0, n_leaves);
+}
+
+MI_NODISCARD inline double deterministic_sum(const STD vector<double>& values,
+                                             const size_t n_threads = MI default_thread_count()) {
+  return deterministic_sums<1>(values.size(), n_threads, [&values](const size_t i) {
+    return STD array<double, 1>{values[i]};
+  })[0];
+}
+
+// Моменты распределения качества элементов. Все поля не зависят от количества потоков.
+struct quality_moments {
+    size_t count                  = 0;
+    double min                    = 0.;
+    double max                    = 0.;
+    double sum                    = 0.;
+    double sum_squared_deviations = 0.;  // Сумма (value - mean())^2
+
+    MI_NODISCARD double mean() const noexcept {
+      return count == 0 ? 0. : sum / static_cast<double>(count);
+    }
+
+    // Дисперсия генеральной совокупности.
+    MI_NODISCARD double variance() const noexcept {
+      return count == 0 ? 0. : sum_squared_deviations / static_cast<double>(count);
+    }
+
+    MI_NODISCARD double standard_deviation() const noexcept {
+      return STD sqrt(variance());
+    }
+};
+
+MI_NODISCARD inline quality_moments deterministic_moments(const STD vector<double>& values,
+                                                          const size_t n_threads = MI default_thread_count()) {
+  quality_moments result;
+  result.count = values.size();
+
+  if (values.empty()) {
+    return result;
+  }
+
+  result.sum = deterministic_sum(values, n_threads);
+
+  // Второй проход по отклонениям от среднего: sum(x^2) / n - mean^2 теряет все значащие цифры, когда разброс мал
+  // по сравнению со средним. Сумма отклонений (ноль в точной арифметике) поправляет ошибку округления среднего.
+  const double mean = result.mean();
+
+  const STD array<double, 2> deviations = deterministic_sums<2>(values.size(), n_threads, [&](const size_t i) {
+    const double deviation = values[i] - mean;
+
+    return STD array<double, 2>{deviation, deviation * deviation};
+  });
+
+  const double correction = deviations[0] * deviations[0] / static_cast<double>(values.size());
+
+  result.sum_squared_deviations = STD max(deviations[1] - correction, 0.);
+
+  // min и max не зависят от порядка, достаточно одного прохода.
+  const auto [min, max] = STD minmax_element(values.begin(), values.end());
+
+  result.min = *min;
+  result.max = *max;
+
+  return result;
+}
+
+// Гистограмма значений на [min; max) из n_bins равных интервалов, значения вне интервала попадают в крайние.
+// NaN и бесконечности не учитываются. Счетчики целые, поэтому результат точный при любом n_threads.
+MI_NODISCARD inline STD vector<size_t> deterministic_histogram(const STD vector<double>& values,
+                                                               const size_t              n_bins,
+                                                               const double              min       = 0.,
+                                                               const double              max       = 1.,
+                                                               const size_t n_threads = MI default_thread_count()) {
+  MI_CHECK(n_bins > 0 && min < max);
+
+  const size_t n_chunks = STD max(STD min(n_threads, values.size()), size_t{1});
+  const double scale    = static_cast<double>(n_bins) / (max - min);
+
+  STD vector<STD vector<size_t>> local(n_chunks, STD vector<size_t>(n_bins, 0));
+
+  parallel_chunks(values.size(), n_chunks, [&](const size_t n_chunk, const size_t first, const size_t last) {
+    STD vector<size_t>& bins = local[n_chunk];
+
+    for (size_t i = first; i < last; ++i) {
+      if (!STD isfinite(values[i])) {
+        continue;
+      }
+
+      const double position = STD clamp((values[i] - min) * scale, 0., static_cast<double>(n_bins - 1));
+
+      ++bins[static_cast<size_t>(position)];
+    }
+  });
+
+  STD vector<size_t> result(n_bins, 0);
+
+  for (const STD vector<size_t>& bins: local) {
+    for (size_t n_bin = 0; n_bin < n_bins; ++n_bin) {
+      result[n_bin] += bins[n_bin];
+    }
+  }
+
+  return result;
+}
+}  // namespace mi
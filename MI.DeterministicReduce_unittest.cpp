@@ -0,0 +1,117 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "Common/MI.DeterministicReduce.h"
+
+namespace mi::test {
+namespace {
+// Значения разного порядка, чтобы порядок сложения влиял на младшие биты.
+STD vector<double> random_values(const size_t count) {
+  STD mt19937                            random(7);
+  STD uniform_real_distribution<double> unit(0., 1.);
+  STD uniform_int_distribution<int>     exponent(-20, 20);
+
+  STD vector<double> result(count);
+
+  for (double& value: result) {
+    value = STD ldexp(unit(random), exponent(random));
+  }
+
+  return result;
+}
+
+bool is_bitwise_equal(const double left, const double right) {
+  return STD memcmp(&left, &right, sizeof(double)) == 0;
+}
+}  // namespace
+
+TEST(DeterministicReduce, SumDoesNotDependOnThreadCount) {
+  for (const size_t count: {size_t{1}, size_t{7}, size_t{1'024}, size_t{1'025}, size_t{100'003}}) {
+    const STD vector<double> values = random_values(count);
+    const double             sum    = MI deterministic_sum(values, 1);
+
+    for (const size_t n_threads: {2, 3, 7, 16}) {
+      EXPECT_TRUE(is_bitwise_equal(MI deterministic_sum(values, n_threads), sum)) << count << " " << n_threads;
+    }
+  }
+}
+
+TEST(DeterministicReduce, SumIsAccurate) {
+  const STD vector<double> values = random_values(1'000'000);
+
+  long double reference = 0.;
+
+  for (const double value: values) {
+    reference += value;
+  }
+
+  EXPECT_NEAR(MI deterministic_sum(values, 4), static_cast<double>(reference), 1e-15 * static_cast<double>(reference));
+  EXPECT_EQ(MI deterministic_sum({}, 4), 0.);
+}
+
+TEST(DeterministicReduce, Moments) {
+  const STD vector<double> values  = random_values(50'000);
+  const MI quality_moments moments = MI deterministic_moments(values, 1);
+
+  EXPECT_EQ(moments.count, values.size());
+  EXPECT_EQ(moments.min, *STD min_element(values.begin(), values.end()));
+  EXPECT_EQ(moments.max, *STD max_element(values.begin(), values.end()));
+  EXPECT_GE(moments.variance(), 0.);
+
+  for (const size_t n_threads: {2, 5, 16}) {
+    const MI quality_moments other = MI deterministic_moments(values, n_threads);
+
+    EXPECT_TRUE(is_bitwise_equal(other.sum, moments.sum));
+    EXPECT_TRUE(is_bitwise_equal(other.sum_squared_deviations, moments.sum_squared_deviations));
+  }
+
+  const MI quality_moments constant = MI deterministic_moments(STD vector<double>(10, 0.5), 3);
+
+  EXPECT_DOUBLE_EQ(constant.mean(), 0.5);
+  EXPECT_NEAR(constant.variance(), 0., 1e-15);
+}
+
+TEST(DeterministicReduce, VarianceWithLargeMean) {
+  // Разброс 0.5 при среднем 1e8: sum(x^2) / n - mean^2 дает ошибку порядка единицы.
+  STD vector<double> values(10'001);
+
+  for (size_t i = 0; i < values.size(); ++i) {
+    values[i] = 1e8 + static_cast<double>(i % 2);
+  }
+
+  const double n        = static_cast<double>(values.size());
+  const double expected = 0.25 * (n * n - 1.) / (n * n);
+
+  for (const size_t n_threads: {1, 3, 16}) {
+    const MI quality_moments moments = MI deterministic_moments(values, n_threads);
+
+    EXPECT_NEAR(moments.variance(), expected, 1e-12);
+  }
+}
+
+TEST(DeterministicReduce, Histogram) {
+  const STD vector<double> values = {-1., 0., 0.05, 0.1, 0.55, 0.999, 1., 2.};
+  const STD vector<size_t> bins   = MI deterministic_histogram(values, 10, 0., 1., 3);
+
+  EXPECT_THAT(bins, ::testing::ElementsAre(3, 1, 0, 0, 0, 1, 0, 0, 0, 3));
+  EXPECT_EQ(MI deterministic_histogram(values, 10, 0., 1., 1), bins);
+}
+
+TEST(DeterministicReduce, HistogramSkipsNonFiniteValues) {
+  const double nan      = STD numeric_limits<double>::quiet_NaN();
+  const double infinity = STD numeric_limits<double>::infinity();
+
+  const STD vector<double> values = {nan, 0.25, -infinity, 0.75, infinity, -nan};
+
+  for (const size_t n_threads: {1, 2, 6}) {
+    EXPECT_THAT(MI deterministic_histogram(values, 2, 0., 1., n_threads), ::testing::ElementsAre(1, 1));
+  }
+}
+}  // namespace mi::test
@@ -0,0 +1,276 @@
+﻿#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "Common/MI.Check.h"
+#include "Common/MI.Predicates.h"
+#include "Container/MI.Matrix.h"
+#include "Mesh/MI.FlatMesh.h"
+#include "Mesh/MI.QualityGradient.h"
+
+// Кэш геометрии элементов.
+// ========================
+//
+// MI quality для quad сначала вызывает MI internal::is_curved, затем для каждого из 4 симплекс-узлов заново читает
+// 3 вершины, считает ребра и строит локальный базис. is_degenerated и angle_between_normals снова считают те же ребра
+// и нормали. element_geometry хранит все это для одного элемента:
+//
+// - points[i]         = p[i],
+// - edges[i]          = p[(i + 1) % N] - p[i],
+// - corner_normals[i] = edges[i] x (-edges[i - 1]) - нормаль симплекс-узла с центром в вершине i (e1 x e2),
+// - corner_areas[i]   = |corner_normals[i]|,
+// - normal            = MI element_normal(p), axis_x/axis_y/axis_z - локальный ортонормированный базис,
+// - signed_area       - площадь элемента со знаком относительно опорной нормали.
+//
+// Для треугольника используется один симплекс-узел (вершина 0), остальные углы тоже заполнены.
+//
+// Ориентация углов относительно normal решается точным предикатом MI orient_along по points, как в
+// MI mean_ratio_quality: у почти вырожденного угла знак corner_normals[i] · normal в double может быть неверным.
+//
+// Кэш заполняется лениво, при первом обращении к элементу. Актуальность проверяется счетчиком поколений: сдвиг вершины
+// (touch_vertex) записывает в нее новое поколение, элемент пересчитывается, если поколение хотя бы одной из его вершин
+// новее поколения, в котором он был заполнен. Массового сброса кэша при движении вершин не требуется.
+//
+// get() можно вызывать параллельно для разных элементов, touch_vertex() - только когда get() не выполняется.
+namespace mi {
+template<size_t NodesPerElement>
+struct element_geometry {
+    STD array<MI point3d, NodesPerElement> points;
+    STD array<MI point3d, NodesPerElement> edges;
+    STD array<MI point3d, NodesPerElement> corner_normals;
+    STD array<double, NodesPerElement>     corner_areas;
+
+    MI point3d normal;
+    MI point3d axis_x;
+    MI point3d axis_y;
+    MI point3d axis_z;
+    double     signed_area = 0.;
+};
+
+// Геометрия элемента по координатам вершин. reference_normal задает знак signed_area, нулевой вектор - нормаль
+// самого элемента.
+template<size_t NodesPerElement>
+MI_NODISCARD element_geometry<NodesPerElement> make_element_geometry(const STD array<MI point3d, NodesPerElement>& p,
+                                                                     const MI point3d& reference_normal) {
+  element_geometry<NodesPerElement> result;
+  result.points = p;
+
+  for (size_t i = 0; i < NodesPerElement; ++i) {
+    result.edges[i] = p[(i + 1) % NodesPerElement] - p[i];
+  }
+
+  for (size_t i = 0; i < NodesPerElement; ++i) {
+    const MI point3d& e1 = result.edges[i];
+    const MI point3d  e2 = result.edges[(i + NodesPerElement - 1) % NodesPerElement] * -1.;
+
+    result.corner_normals[i] = e1.cross(e2);
+    result.corner_areas[i]   = STD sqrt(result.corner_normals[i].squared_euclidean_norm());
+  }
+
+  result.normal = MI element_normal(p);
+
+  const double normal_length = STD sqrt(result.normal.squared_euclidean_norm());
+  const double edge_length   = STD sqrt(result.edges[0].squared_euclidean_norm());
+
+  if (normal_length > 0. && edge_length > 0.) {
+    result.axis_z = result.normal / normal_length;
+
+    // Для неплоского quad первое ребро не лежит в плоскости normal, поэтому ось x - его проекция на эту плоскость.
+    const MI point3d edge_x = result.edges[0] / edge_length;
+
+    result.axis_x = edge_x - result.axis_z * edge_x.dot(result.axis_z);
+    result.axis_x = result.axis_x / STD sqrt(result.axis_x.squared_euclidean_norm());
+    result.axis_y = result.axis_z.cross(result.axis_x);
+  }
+
+  // Для треугольника и quad площадь (проекции на плоскость, перпендикулярную normal) равна |normal| / 2.
+  const bool   has_reference = reference_normal.squared_euclidean_norm() > 0.;
+  const double sign          = !has_reference || result.normal.dot(reference_normal) >= 0. ? 1. : -1.;
+
+  result.signed_area = sign * 0.5 * normal_length;
+
+  return result;
+}
+
+namespace internal {
+// Нормаль угла i направлена в сторону нормали элемента (точно).
+template<size_t NodesPerElement>
+MI_NODISCARD bool is_oriented_corner(const element_geometry<NodesPerElement>& geometry, const size_t i) {
+  const MI point3d& left  = geometry.points[(i + NodesPerElement - 1) % NodesPerElement];
+  const MI point3d& mid   = geometry.points[i];
+  const MI point3d& right = geometry.points[(i + 1) % NodesPerElement];
+
+  return MI orient_along(mid, right, left, geometry.normal) > 0.;
+}
+}  // namespace internal
+
+// Mean ratio quality по кэшированной геометрии, совпадает с MI quality. Для недействительного элемента (вырожденный
+// симплекс-узел или симплекс-узел, вывернутый относительно normal) возвращает 0.
+template<size_t NodesPerElement>
+MI_NODISCARD double quality(const element_geometry<NodesPerElement>& geometry) {
+  constexpr size_t n_nodes = NodesPerElement == 3 ? 1 : NodesPerElement;
+
+  const internal::mean_ratio_weights& w =
+    NodesPerElement == 3 ? internal::triangle_mean_ratio_weights : internal::quad_mean_ratio_weights;
+
+  double result = 0.;
+
+  for (size_t i = 0; i < n_nodes; ++i) {
+    if (!(geometry.corner_areas[i] > 0.) || !internal::is_oriented_corner(geometry, i)) {
+      return 0.;
+    }
+
+    const MI point3d& e1 = geometry.edges[i];
+    const MI point3d  e2 = geometry.edges[(i + NodesPerElement - 1) % NodesPerElement] * -1.;
+    const MI point3d  s1 = e1 * w.a;
+    const MI point3d  s2 = e1 * w.b + e2 * w.d;
+
+    result += 2. * w.a * w.d * geometry.corner_areas[i] /
+              (s1.squared_euclidean_norm() + s2.squared_euclidean_norm());
+  }
+
+  return result / static_cast<double>(n_nodes);
+}
+
+// Элемент вырожден, если площадь хотя бы одного симплекс-узла не больше
+// relative_tolerance * (квадрат длины наибольшего ребра).
+template<size_t NodesPerElement>
+MI_NODISCARD bool is_degenerated(const element_geometry<NodesPerElement>& geometry,
+                                 const double                             relative_tolerance = 1e-12) {
+  double max_edge = 0.;
+
+  for (const MI point3d& edge: geometry.edges) {
+    max_edge = STD max(max_edge, edge.squared_euclidean_norm());
+  }
+
+  for (const double area: geometry.corner_areas) {
+    if (!(area > relative_tolerance * max_edge)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+// Элемент выпуклый, если нормали всех углов направлены в одну сторону с нормалью элемента.
+template<size_t NodesPerElement>
+MI_NODISCARD bool is_convex(const element_geometry<NodesPerElement>& geometry) {
+  for (size_t i = 0; i < NodesPerElement; ++i) {
+    if (!internal::is_oriented_corner(geometry, i)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// Наибольший угол (в радианах) между нормалями углов элемента: 0 для плоского элемента.
+template<size_t NodesPerElement>
+MI_NODISCARD double max_angle_between_normals(const element_geometry<NodesPerElement>& geometry) {
+  double min_cos = 1.;
+
+  for (size_t i = 0; i < NodesPerElement; ++i) {
+    for (size_t j = i + 1; j < NodesPerElement; ++j) {
+      const double lengths = geometry.corner_areas[i] * geometry.corner_areas[j];
+
+      if (lengths > 0.) {
+        min_cos = STD min(min_cos, geometry.corner_normals[i].dot(geometry.corner_normals[j]) / lengths);
+      }
+    }
+  }
+
+  return STD acos(STD clamp(min_cos, -1., 1.));
+}
+
+template<size_t NodesPerElement>
+class element_geometry_cache {
+  public:
+    using geometry_type = element_geometry<NodesPerElement>;
+
+  public:
+    explicit element_geometry_cache(const flat_mesh<NodesPerElement>& mesh,
+                                    const MI point3d&                 reference_normal = {0., 0., 0.})
+        : _mesh(mesh),
+          _reference_normal(reference_normal),
+          _geometry(mesh.n_elements()),
+          _element_generation(mesh.n_elements(), 0),
+          _vertex_generation(mesh.n_vertices(), 0) {
+    }
+
+  public:
+    // Геометрия элемента, пересчитывается, если после заполнения сдвигалась хотя бы одна его вершина.
+    MI_NODISCARD const geometry_type& get(const size_t n_element) {
+      MI_DCHECK(n_element < _geometry.size());
+
+      if (!is_actual(n_element)) {
+        const STD array<MI point3d, NodesPerElement> p = internal::gather(_mesh, n_element);
+
+        _geometry[n_element]           = MI make_element_geometry(p, _reference_normal);
+        _element_generation[n_element] = _generation;
+      }
+
+      return _geometry[n_element];
+    }
+
+    MI_NODISCARD double quality(const size_t n_element) {
+      return MI quality(get(n_element));
+    }
+
+    MI_NODISCARD bool is_degenerated(const size_t n_element) {
+      return MI is_degenerated(get(n_element));
+    }
+
+    MI_NODISCARD bool is_convex(const size_t n_element) {
+      return MI is_convex(get(n_element));
+    }
+
+    MI_NODISCARD double max_angle_between_normals(const size_t n_element) {
+      return MI max_angle_between_normals(get(n_element));
+    }
+
+  public:
+    // Отмечает, что вершина n_vertex сдвинулась: все ее элементы будут пересчитаны при следующем обращении.
+    void touch_vertex(const size_t n_vertex) {
+      MI_DCHECK(n_vertex < _vertex_generation.size());
+
+      _vertex_generation[n_vertex] = ++_generation;
+    }
+
+    // Сбрасывает весь кэш (например, после изменения связности сетки).
+    void reset() {
+      _geometry.resize(_mesh.n_elements());
+      _element_generation.assign(_mesh.n_elements(), 0);
+      _vertex_generation.assign(_mesh.n_vertices(), 0);
+      _generation = 1;
+    }
+
+    MI_NODISCARD bool is_actual(const size_t n_element) const {
+      const STD uint64_t element_generation = _element_generation[n_element];
+
+      if (element_generation == 0) {
+        return false;
+      }
+
+      for (const size_t n_vertex: _mesh.elements[n_element]) {
+        if (_vertex_generation[n_vertex] > element_generation) {
+          return false;
+        }
+      }
+
+      return true;
+    }
+
+  private:
+    const flat_mesh<NodesPerElement>& _mesh;
+    const MI point3d                  _reference_normal;
+
+    STD vector<geometry_type> _geometry;
+    STD vector<STD uint64_t>  _element_generation;  // Поколение, в котором заполнен элемент (0 - не заполнен)
+    STD vector<STD uint64_t>  _vertex_generation;   // Поколение последнего сдвига вершины
+    STD uint64_t              _generation = 1;
+};
+}  // namespace mi
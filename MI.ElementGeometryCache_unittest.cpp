@@ -0,0 +1,155 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+
+#include "Mesh/MI.ElementGeometryCache.h"
+#include "Mesh/MI.Quality.h"
+#include "Mesh/MI.QualityGradient.h"
+
+namespace mi::test {
+namespace {
+// Два quad 0-1-4-3 и 1-2-5-4 в плоскости z = 0.
+MI flat_quad_mesh two_quads() {
+  MI flat_quad_mesh mesh;
+  mesh.vertices = {
+    {0., 0., 0.}, {1., 0., 0.}, {2., 0., 0.}, {0., 1., 0.}, {1.2, 1.1, 0.}, {2., 1., 0.}
+  };
+  mesh.elements = {
+    {0, 1, 4, 3},
+    {1, 2, 5, 4}
+  };
+
+  return mesh;
+}
+}  // namespace
+
+TEST(ElementGeometryCache, Geometry) {
+  const MI flat_quad_mesh mesh     = two_quads();
+  const auto              geometry = MI make_element_geometry<4>(
+    {mesh.vertices[0], mesh.vertices[1], mesh.vertices[4], mesh.vertices[3]}, {0., 0., 1.});
+
+  EXPECT_EQ(geometry.edges[0], MI point3d(1., 0., 0.));
+  EXPECT_EQ(geometry.edges[3], MI point3d(0., -1., 0.));
+  EXPECT_EQ(geometry.corner_normals[0], MI point3d(0., 0., 1.));
+  EXPECT_NEAR(geometry.signed_area, 0.5 * (1.1 + 1.2), 1e-14);
+  EXPECT_EQ(geometry.axis_x, MI point3d(1., 0., 0.));
+  EXPECT_EQ(geometry.axis_y, MI point3d(0., 1., 0.));
+  EXPECT_EQ(geometry.axis_z, MI point3d(0., 0., 1.));
+
+  EXPECT_TRUE(MI is_convex(geometry));
+  EXPECT_FALSE(MI is_degenerated(geometry));
+  EXPECT_NEAR(MI max_angle_between_normals(geometry), 0., 1e-7);
+
+  const auto flipped = MI make_element_geometry<4>(
+    {mesh.vertices[0], mesh.vertices[1], mesh.vertices[4], mesh.vertices[3]}, {0., 0., -1.});
+
+  EXPECT_NEAR(flipped.signed_area, -geometry.signed_area, 1e-14);
+}
+
+TEST(ElementGeometryCache, QualityMatchesQuality) {
+  const MI flat_quad_mesh mesh = two_quads();
+
+  MI element_geometry_cache<4> cache(mesh);
+
+  for (size_t n_element = 0; n_element < mesh.n_elements(); ++n_element) {
+    EXPECT_NEAR(cache.quality(n_element), MI element_quality(mesh, n_element), 1e-14);
+  }
+
+  const STD array<MI point3d, 3> triangle = {
+    {{0.1, -0.2, 0.3}, {1.3, 0.1, 0.5}, {0.4, 0.9, -0.2}}
+  };
+
+  EXPECT_NEAR(MI quality(MI make_element_geometry(triangle, {0., 0., 0.})),
+              MI quality(triangle[0], triangle[1], triangle[2]),
+              1e-14);
+}
+
+TEST(ElementGeometryCache, NearlyCollinearCornersMatchMeanRatioQuality) {
+  STD mt19937_64                         random(1);
+  STD uniform_real_distribution<double> coordinate(-1., 1.);
+
+  const auto random_point = [&] {
+    return MI point3d(coordinate(random), coordinate(random), coordinate(random));
+  };
+
+  // Вершина 1 лежит на отрезке 0-2 с точностью до округления: знак нормали угла в double часто неверный.
+  for (size_t n_case = 0; n_case < 1'000; ++n_case) {
+    const MI point3d a = random_point();
+    const MI point3d c = random_point();
+    const MI point3d d = random_point();
+    const MI point3d b = a + (c - a) * (0.5 + 0.25 * coordinate(random));
+
+    const STD array<MI point3d, 4> p        = {a, b, c, d};
+    const auto                     geometry = MI make_element_geometry(p, {0., 0., 0.});
+    const double                   expected = MI mean_ratio_quality(p);
+
+    ASSERT_EQ(MI quality(geometry) > 0., expected > 0.) << n_case;
+    EXPECT_NEAR(MI quality(geometry), expected, 1e-14);
+
+    bool is_convex = true;
+
+    for (size_t i = 0; i < 4; ++i) {
+      is_convex = is_convex && MI orient_along(p[i], p[(i + 1) % 4], p[(i + 3) % 4], geometry.normal) > 0.;
+    }
+
+    EXPECT_EQ(MI is_convex(geometry), is_convex) << n_case;
+  }
+}
+
+TEST(ElementGeometryCache, ConcaveAndDegenerate) {
+  const STD array<MI point3d, 4> concave = {
+    {{0., 0., 0.}, {1., 0., 0.}, {0.2, 0.2, 0.}, {0., 1., 0.}}
+  };
+  const STD array<MI point3d, 4> degenerate = {
+    {{0., 0., 0.}, {1., 0., 0.}, {2., 0., 0.}, {0., 1., 0.}}
+  };
+
+  const auto concave_geometry = MI make_element_geometry(concave, {0., 0., 0.});
+
+  EXPECT_FALSE(MI is_convex(concave_geometry));
+  EXPECT_EQ(MI quality(concave_geometry), 0.);
+  EXPECT_NEAR(MI max_angle_between_normals(concave_geometry), STD acos(-1.), 1e-7);
+
+  EXPECT_TRUE(MI is_degenerated(MI make_element_geometry(degenerate, {0., 0., 0.})));
+}
+
+TEST(ElementGeometryCache, TouchVertexInvalidatesIncidentElements) {
+  MI flat_quad_mesh mesh = two_quads();
+
+  MI element_geometry_cache<4> cache(mesh);
+
+  EXPECT_FALSE(cache.is_actual(0));
+  EXPECT_FALSE(cache.is_actual(1));
+
+  const double q0 = cache.quality(0);
+  const double q1 = cache.quality(1);
+
+  EXPECT_TRUE(cache.is_actual(0));
+  EXPECT_TRUE(cache.is_actual(1));
+
+  // Вершина 0 принадлежит только первому элементу.
+  mesh.vertices[0] = {0.1, 0.05, 0.};
+  cache.touch_vertex(0);
+
+  EXPECT_FALSE(cache.is_actual(0));
+  EXPECT_TRUE(cache.is_actual(1));
+  EXPECT_NE(cache.quality(0), q0);
+  EXPECT_EQ(cache.quality(1), q1);
+  EXPECT_NEAR(cache.quality(0), MI element_quality(mesh, 0), 1e-14);
+
+  // Вершина 4 общая.
+  mesh.vertices[4] = {1., 1., 0.};
+  cache.touch_vertex(4);
+
+  EXPECT_FALSE(cache.is_actual(0));
+  EXPECT_FALSE(cache.is_actual(1));
+  EXPECT_NEAR(cache.quality(1), 1., 1e-14);
+
+  cache.reset();
+
+  EXPECT_FALSE(cache.is_actual(0));
+  EXPECT_NEAR(cache.quality(0), MI element_quality(mesh, 0), 1e-14);
+}
+}  // namespace mi::test
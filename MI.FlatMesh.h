@@ -0,0 +1,199 @@
+﻿#pragma once
+
+#include <array>
+#include <vector>
+
+#include "Common/MI.Check.h"
+#include "Container/MI.Matrix.h"
+#include "Container/MI.RadixSort.h"
+#include "Container/MI.RaggedArray.h"
+#include "Container/MI.SortedArray.h"
+#include "Mesh/MI.Quality.h"
+#include "Mesh/MI.QualityGradient.h"
+
+// Плоское представление сетки из элементов одного типа для массовых операций над качеством.
+// ========================================================================================
+//
+// vertices - координаты вершин, elements - глобальные индексы вершин каждого элемента в порядке обхода
+// (NodesPerElement == 3 - треугольники, NodesPerElement == 4 - quad). Квадратичные элементы (6 - треугольник, 8 и 9 -
+// quad) хранят сначала угловые узлы, затем узлы на ребрах (и центральный), см. MI evaluate_quadratic_quality.
+//
+// В отличие от полноценной сетки не хранит свойств элементов и связей, зато данные лежат в двух непрерывных
+// массивах, что нужно для параллельных проходов, оптимизации и потоковой обработки.
+namespace mi {
+template<size_t NodesPerElement>
+struct flat_mesh {
+    static_assert(NodesPerElement == 3 || NodesPerElement == 4 || NodesPerElement == 6 || NodesPerElement == 8 ||
+                    NodesPerElement == 9,
+                  "flat_mesh: only linear and quadratic triangles and quads are supported");
+
+    using element_type = STD array<size_t, NodesPerElement>;
+
+    static constexpr size_t n_nodes = NodesPerElement;
+
+    STD vector<MI point3d>  vertices;
+    STD vector<element_type> elements;
+
+    MI_NODISCARD const MI point3d& get_vertex(const size_t n_vertex) const {
+      MI_DCHECK(n_vertex < vertices.size());
+
+      return vertices[n_vertex];
+    }
+
+    MI_NODISCARD size_t n_vertices() const noexcept {
+      return vertices.size();
+    }
+
+    MI_NODISCARD size_t n_elements() const noexcept {
+      return elements.size();
+    }
+};
+
+using flat_triangle_mesh = flat_mesh<3>;
+using flat_quad_mesh     = flat_mesh<4>;
+
+using flat_quadratic_triangle_mesh = flat_mesh<6>;
+using flat_serendipity_quad_mesh   = flat_mesh<8>;
+using flat_quadratic_quad_mesh     = flat_mesh<9>;
+
+namespace internal {
+template<size_t NodesPerElement>
+constexpr size_t n_corner_nodes = NodesPerElement == 3 || NodesPerElement == 6 ? 3 : 4;
+
+// Отрезки контура элемента (пары номеров узлов в элементе): ребра линейного элемента, для квадратичного - половины
+// ребер угол i - середина ребра i - угол i + 1. Квадратичное ребро между узлами нельзя брать из соседних по номеру
+// узлов: углы хранятся раньше середин ребер.
+template<size_t NodesPerElement>
+constexpr auto contour_segments() {
+  constexpr size_t n_corners  = n_corner_nodes<NodesPerElement>;
+  constexpr bool   is_linear  = NodesPerElement == n_corners;
+  constexpr size_t n_segments = is_linear ? n_corners : 2 * n_corners;
+
+  STD array<STD array<size_t, 2>, n_segments> result{};
+
+  for (size_t i = 0; i < n_corners; ++i) {
+    if constexpr (is_linear) {
+      result[i] = {i, (i + 1) % n_corners};
+    } else {
+      result[2 * i]     = {i, n_corners + i};
+      result[2 * i + 1] = {n_corners + i, (i + 1) % n_corners};
+    }
+  }
+
+  return result;
+}
+
+// Отрезки внутри элемента: центр 9-узлового quad соединен с серединами ребер.
+template<size_t NodesPerElement>
+constexpr auto interior_segments() {
+  if constexpr (NodesPerElement == 9) {
+    return STD array<STD array<size_t, 2>, 4>{{{8, 4}, {8, 5}, {8, 6}, {8, 7}}};
+  } else {
+    return STD array<STD array<size_t, 2>, 0>{};
+  }
+}
+
+// Координаты вершин элемента n_element в порядке обхода.
+template<size_t NodesPerElement>
+MI_NODISCARD STD array<MI point3d, NodesPerElement> gather(const flat_mesh<NodesPerElement>& mesh,
+                                                           const size_t                      n_element) {
+  STD array<MI point3d, NodesPerElement> p;
+
+  for (size_t i = 0; i < NodesPerElement; ++i) {
+    p[i] = mesh.vertices[mesh.elements[n_element][i]];
+  }
+
+  return p;
+}
+
+// Опорная нормаль элемента: reference_normal, если он ненулевой (общая нормаль плоской сетки), иначе нормаль самого
+// элемента (MI element_normal).
+template<size_t NodesPerElement>
+MI_NODISCARD MI point3d select_normal(const STD array<MI point3d, NodesPerElement>& p,
+                                      const MI point3d&                             reference_normal) {
+  return reference_normal.squared_euclidean_norm() > 0. ? reference_normal : MI element_normal(p);
+}
+}  // namespace internal
+
+// Качество элемента n_element через MI quality по координатам.
+// Для quad проверка на вогнутость не выполняется (см. MI quality(v0, v1, v2, v3)).
+template<size_t NodesPerElement>
+MI_NODISCARD double element_quality(const flat_mesh<NodesPerElement>& mesh, const size_t n_element) {
+  static_assert(NodesPerElement == 3 || NodesPerElement == 4, "element_quality: only linear elements are supported");
+
+  const auto& element = mesh.elements[n_element];
+
+  if constexpr (NodesPerElement == 3) {
+    return MI quality(mesh.vertices[element[0]], mesh.vertices[element[1]], mesh.vertices[element[2]]);
+  } else {
+    return MI quality(mesh.vertices[element[0]],
+                      mesh.vertices[element[1]],
+                      mesh.vertices[element[2]],
+                      mesh.vertices[element[3]]);
+  }
+}
+
+// Элементы, которым принадлежит каждая вершина (CSR: строка n_vertex - номера элементов по возрастанию).
+template<size_t NodesPerElement>
+MI_NODISCARD MI ragged_array<size_t> vertex_elements(const flat_mesh<NodesPerElement>& mesh) {
+  STD vector<size_t> offsets(mesh.n_vertices() + 1, 0);
+
+  for (const auto& element: mesh.elements) {
+    for (const size_t n_vertex: element) {
+      ++offsets[n_vertex + 1];
+    }
+  }
+
+  for (size_t n_vertex = 0; n_vertex < mesh.n_vertices(); ++n_vertex) {
+    offsets[n_vertex + 1] += offsets[n_vertex];
+  }
+
+  STD vector<size_t> payload(offsets.back());
+  STD vector<size_t> positions(offsets.begin(), offsets.end() - 1);
+
+  for (size_t n_element = 0; n_element < mesh.n_elements(); ++n_element) {
+    for (const size_t n_vertex: mesh.elements[n_element]) {
+      payload[positions[n_vertex]++] = n_element;
+    }
+  }
+
+  return MI ragged_array<size_t>(STD move(offsets), STD move(payload));
+}
+
+// Вершины на границе сетки: концы ребер (для квадратичных элементов - половин ребер, см.
+// MI internal::contour_segments), которые принадлежат только одному элементу.
+template<size_t NodesPerElement>
+MI_NODISCARD STD vector<bool> boundary_vertices(const flat_mesh<NodesPerElement>& mesh) {
+  constexpr auto segments = internal::contour_segments<NodesPerElement>();
+
+  STD vector<MI sorted_array2n> edges;
+  edges.reserve(mesh.n_elements() * segments.size());
+
+  for (const auto& element: mesh.elements) {
+    for (const auto& segment: segments) {
+      edges.push_back({element[segment[0]], element[segment[1]]});
+    }
+  }
+
+  MI radix_sort(edges.begin(), edges.end());
+
+  STD vector<bool> is_boundary(mesh.n_vertices(), false);
+
+  for (size_t first = 0; first < edges.size();) {
+    size_t last = first + 1;
+
+    while (last < edges.size() && edges[last] == edges[first]) {
+      ++last;
+    }
+
+    if (last - first == 1) {
+      is_boundary[edges[first][0]] = true;
+      is_boundary[edges[first][1]] = true;
+    }
+
+    first = last;
+  }
+
+  return is_boundary;
+}
+}  // namespace mi
@@ -0,0 +1,175 @@
+﻿#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+
+#include "Common/MI.Check.h"
+#include "Common/MI.MappedFile.h"
+#include "Container/MI.Matrix.h"
+#include "Mesh/MI.FlatMesh.h"
+
+// Бинарный файл плоской сетки.
+// ============================
+//
+// | flat_mesh_file_header | n_vertices * 3 double (x, y, z) | n_elements * NodesPerElement uint64 |
+//
+// Все числа в порядке байт машины, которая пишет файл. Заголовок занимает 32 байта, поэтому массивы выровнены
+// по 8 байт и читаются из отображенного файла без копирования.
+namespace mi {
+struct flat_mesh_file_header {
+    char         magic[8];
+    STD uint32_t version;
+    STD uint32_t nodes_per_element;
+    STD uint64_t n_vertices;
+    STD uint64_t n_elements;
+};
+
+static_assert(sizeof(flat_mesh_file_header) == 32, "flat_mesh_file_header must not have padding");
+
+namespace internal {
+constexpr char         flat_mesh_file_magic[8] = {'M', 'I', 'F', 'L', 'A', 'T', '\0', '\0'};
+constexpr STD uint32_t flat_mesh_file_version  = 1;
+}  // namespace internal
+
+// Записывает сетку в файл, возвращает false при ошибке записи.
+template<size_t NodesPerElement>
+MI_NODISCARD bool write_flat_mesh(const STD string& path, const flat_mesh<NodesPerElement>& mesh) {
+  STD ofstream stream(path, STD ios::binary | STD ios::trunc);
+
+  if (!stream) {
+    return false;
+  }
+
+  flat_mesh_file_header header;
+  STD memcpy(header.magic, internal::flat_mesh_file_magic, sizeof(header.magic));
+  header.version           = internal::flat_mesh_file_version;
+  header.nodes_per_element = static_cast<STD uint32_t>(NodesPerElement);
+  header.n_vertices        = mesh.n_vertices();
+  header.n_elements        = mesh.n_elements();
+
+  stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+  for (const MI point3d& vertex: mesh.vertices) {
+    const double xyz[3] = {vertex.x(), vertex.y(), vertex.z()};
+    stream.write(reinterpret_cast<const char*>(xyz), sizeof(xyz));
+  }
+
+  for (const auto& element: mesh.elements) {
+    STD uint64_t indices[NodesPerElement];
+
+    for (size_t i = 0; i < NodesPerElement; ++i) {
+      indices[i] = element[i];
+    }
+
+    stream.write(reinterpret_cast<const char*>(indices), sizeof(indices));
+  }
+
+  return static_cast<bool>(stream);
+}
+
+// Сетка из файла, отображенного в память. Вершины и элементы читаются напрямую из отображения, в память целиком
+// не загружаются.
+template<size_t NodesPerElement>
+class mapped_flat_mesh {
+  public:
+    using element_type = STD array<STD uint64_t, NodesPerElement>;
+
+    static_assert(sizeof(element_type) == NodesPerElement * sizeof(STD uint64_t), "element_type must be packed");
+
+  public:
+    // Возвращает false, если файл не открылся, имеет другой формат, тип элементов или обрезан.
+    MI_NODISCARD bool open(const STD string& path) {
+      _vertices = nullptr;
+      _elements = nullptr;
+
+      if (!_file.open(path) || _file.size() < sizeof(flat_mesh_file_header)) {
+        return false;
+      }
+
+      STD memcpy(&_header, _file.data(), sizeof(_header));
+
+      if (STD memcmp(_header.magic, internal::flat_mesh_file_magic, sizeof(_header.magic)) != 0 ||
+          _header.version != internal::flat_mesh_file_version || _header.nodes_per_element != NodesPerElement) {
+        _file.close();
+
+        return false;
+      }
+
+      // Количества из заголовка не проверены: сначала сравниваются с размером файла делением, чтобы произведения
+      // ниже не переполнялись.
+      constexpr STD uint64_t vertex_size = 3 * sizeof(double);
+
+      const STD uint64_t payload_size = _file.size() - sizeof(flat_mesh_file_header);
+
+      if (_header.n_vertices > payload_size / vertex_size) {
+        _file.close();
+
+        return false;
+      }
+
+      const STD uint64_t vertices_size = _header.n_vertices * vertex_size;
+
+      if (_header.n_elements > (payload_size - vertices_size) / sizeof(element_type) ||
+          payload_size != vertices_size + _header.n_elements * sizeof(element_type)) {
+        _file.close();
+
+        return false;
+      }
+
+      _vertices = reinterpret_cast<const double*>(_file.data() + sizeof(flat_mesh_file_header));
+      _elements = reinterpret_cast<const element_type*>(_file.data() + sizeof(flat_mesh_file_header) + vertices_size);
+
+      return true;
+    }
+
+  public:
+    MI_NODISCARD bool is_open() const noexcept {
+      return _file.is_open();
+    }
+
+    MI_NODISCARD size_t n_vertices() const noexcept {
+      return is_open() ? static_cast<size_t>(_header.n_vertices) : 0;
+    }
+
+    MI_NODISCARD size_t n_elements() const noexcept {
+      return is_open() ? static_cast<size_t>(_header.n_elements) : 0;
+    }
+
+    MI_NODISCARD MI point3d get_vertex(const size_t n_vertex) const {
+      MI_DCHECK(n_vertex < n_vertices());
+
+      const double* const xyz = _vertices + 3 * n_vertex;
+
+      return {xyz[0], xyz[1], xyz[2]};
+    }
+
+    // Адрес вершины для программной предвыборки.
+    MI_NODISCARD const double* vertex_data(const size_t n_vertex) const noexcept {
+      return _vertices + 3 * n_vertex;
+    }
+
+    MI_NODISCARD const element_type& element(const size_t n_element) const {
+      MI_DCHECK(n_element < n_elements());
+
+      return _elements[n_element];
+    }
+
+    // Смещение элемента n_element от начала файла.
+    MI_NODISCARD size_t element_offset(const size_t n_element) const noexcept {
+      return static_cast<size_t>(reinterpret_cast<const STD byte*>(_elements + n_element) - _file.data());
+    }
+
+    MI_NODISCARD const mapped_file& file() const noexcept {
+      return _file;
+    }
+
+  private:
+    mapped_file           _file;
+    flat_mesh_file_header _header{};
+    const double*         _vertices = nullptr;
+    const element_type*   _elements = nullptr;
+};
+}  // namespace mi
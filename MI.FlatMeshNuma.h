@@ -0,0 +1,20 @@
+﻿#pragma once
+
+#include "Common/MI.NumaAllocator.h"
+#include "Mesh/MI.FlatMesh.h"
+
+// Размещение MI flat_mesh по узлам NUMA. Отдельный заголовок, чтобы MI.FlatMesh.h не тянул системные заголовки
+// MI.NumaAllocator.h во всех пользователей сетки.
+namespace mi {
+// Переносит страницы вершин и элементов на узлы NUMA кусками MI chunk_bounds, как их читают параллельные проходы
+// с тем же n_threads и привязкой MI thread_affinity::pinned (MI first_touch_redistribute).
+template<size_t NodesPerElement>
+bool first_touch_redistribute(flat_mesh<NodesPerElement>& mesh,
+                              const size_t                n_threads,
+                              const page_policy           policy = page_policy::normal) {
+  const bool is_vertices_placed = first_touch_redistribute(mesh.vertices, n_threads, policy);
+  const bool is_elements_placed = first_touch_redistribute(mesh.elements, n_threads, policy);
+
+  return is_vertices_placed && is_elements_placed;
+}
+}  // namespace mi
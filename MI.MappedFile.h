@@ -0,0 +1,240 @@
+﻿#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <utility>
+
+#include "Common/MI.Check.h"
+
+#if defined(_WIN32)
+  #ifndef NOMINMAX
+    #define NOMINMAX
+  #endif
+  #include <windows.h>
+#else
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+// Файл, отображенный в память только для чтения.
+// ============================================
+//
+// Страницы подгружаются операционной системой по мере обращения и могут быть вытеснены без записи на диск, поэтому
+// файл может быть больше свободной памяти. Для последовательного прохода:
+//
+// MI mapped_file file;
+//
+// if (!file.open(path)) {
+//   return false;
+// }
+//
+// file.advise_sequential();   // Агрессивное чтение вперед
+// file.load(offset, size);    // Дождаться чтения диапазона с диска
+// ...
+// file.release(offset, size); // Прочитанный диапазон больше не нужен
+namespace mi {
+class mapped_file {
+  public:
+    mapped_file() = default;
+
+    mapped_file(const mapped_file&)            = delete;
+    mapped_file& operator=(const mapped_file&) = delete;
+
+    mapped_file(mapped_file&& other) noexcept
+        : _data(STD exchange(other._data, nullptr)),
+          _size(STD exchange(other._size, 0)) {
+    }
+
+    mapped_file& operator=(mapped_file&& other) noexcept {
+      if (this != &other) {
+        close();
+
+        _data = STD exchange(other._data, nullptr);
+        _size = STD exchange(other._size, 0);
+      }
+
+      return *this;
+    }
+
+    ~mapped_file() {
+      close();
+    }
+
+  public:
+    // Возвращает false, если файл не удалось открыть или он пустой.
+    MI_NODISCARD bool open(const STD string& path) {
+      close();
+
+#if defined(_WIN32)
+      const HANDLE file = CreateFileA(path.c_str(),
+                                      GENERIC_READ,
+                                      FILE_SHARE_READ,
+                                      nullptr,
+                                      OPEN_EXISTING,
+                                      FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+                                      nullptr);
+
+      if (file == INVALID_HANDLE_VALUE) {
+        return false;
+      }
+
+      LARGE_INTEGER file_size;
+
+      if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0) {
+        CloseHandle(file);
+
+        return false;
+      }
+
+      const HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+      CloseHandle(file);
+
+      if (mapping == nullptr) {
+        return false;
+      }
+
+      void* const data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+      CloseHandle(mapping);
+
+      if (data == nullptr) {
+        return false;
+      }
+
+      _data = static_cast<const STD byte*>(data);
+      _size = static_cast<size_t>(file_size.QuadPart);
+#else
+      const int file = ::open(path.c_str(), O_RDONLY);
+
+      if (file < 0) {
+        return false;
+      }
+
+      struct stat file_stat;
+
+      if (::fstat(file, &file_stat) != 0 || file_stat.st_size == 0) {
+        ::close(file);
+
+        return false;
+      }
+
+      const size_t size = static_cast<size_t>(file_stat.st_size);
+      void* const  data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+      ::close(file);
+
+      if (data == MAP_FAILED) {
+        return false;
+      }
+
+      _data = static_cast<const STD byte*>(data);
+      _size = size;
+#endif
+
+      return true;
+    }
+
+    void close() noexcept {
+      if (_data == nullptr) {
+        return;
+      }
+
+#if defined(_WIN32)
+      UnmapViewOfFile(_data);
+#else
+      ::munmap(const_cast<STD byte*>(_data), _size);
+#endif
+
+      _data = nullptr;
+      _size = 0;
+    }
+
+  public:
+    MI_NODISCARD bool is_open() const noexcept {
+      return _data != nullptr;
+    }
+
+    MI_NODISCARD const STD byte* data() const noexcept {
+      return _data;
+    }
+
+    MI_NODISCARD size_t size() const noexcept {
+      return _size;
+    }
+
+  public:
+    // Подсказка ОС: файл читается последовательно.
+    void advise_sequential() const noexcept {
+#if !defined(_WIN32)
+      if (_data != nullptr) {
+        ::madvise(const_cast<STD byte*>(_data), _size, MADV_SEQUENTIAL);
+      }
+#endif
+    }
+
+    // Подгружает страницы диапазона [offset; offset + size) в память: возвращается, когда они прочитаны с диска.
+    // Используется, чтобы ожидание ввода-вывода приходилось на поток загрузки, а не на вычисляющие потоки.
+    // Пустой диапазон ничего не читает.
+    void load(const size_t offset, const size_t size) const noexcept {
+      if (_data == nullptr || offset >= _size || size == 0) {
+        return;
+      }
+
+      const size_t page = page_size();
+      const size_t last = offset + STD min(size, _size - offset);
+
+#if !defined(_WIN32)
+      const size_t first = offset / page * page;
+
+      ::madvise(const_cast<STD byte*>(_data) + first, last - first, MADV_WILLNEED);
+#endif
+
+      // По одному чтению на страницу, volatile не дает компилятору убрать чтения.
+      const volatile STD byte* const data = _data;
+
+      for (size_t i = offset; i < last; i += page) {
+        static_cast<void>(data[i]);
+      }
+
+      static_cast<void>(data[last - 1]);
+    }
+
+    // Подсказка ОС: страницы диапазона [offset; offset + size) больше не нужны и могут быть вытеснены сразу.
+    // Границы выравниваются внутрь диапазона по размеру страницы. Данные остаются доступными (будут прочитаны заново).
+    void release(const size_t offset, const size_t size) const noexcept {
+#if !defined(_WIN32)
+      if (_data == nullptr || offset >= _size) {
+        return;
+      }
+
+      const size_t page  = page_size();
+      const size_t first = (offset + page - 1) / page * page;
+      const size_t last  = (offset + STD min(size, _size - offset)) / page * page;
+
+      if (first < last) {
+        ::madvise(const_cast<STD byte*>(_data) + first, last - first, MADV_DONTNEED);
+      }
+#else
+      static_cast<void>(offset);
+      static_cast<void>(size);
+#endif
+    }
+
+  private:
+    MI_NODISCARD static size_t page_size() noexcept {
+#if defined(_WIN32)
+      SYSTEM_INFO info;
+      GetSystemInfo(&info);
+
+      return static_cast<size_t>(info.dwPageSize);
+#else
+      return static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+#endif
+    }
+
+  private:
+    const STD byte* _data = nullptr;
+    size_t          _size = 0;
+};
+}  // namespace mi
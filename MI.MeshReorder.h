@@ -0,0 +1,410 @@
+﻿#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+#include "Common/MI.Check.h"
+#include "Common/MI.ParallelFor.h"
+#include "Common/MI.StrongAlias.h"
+#include "Container/MI.Matrix.h"
+#include "Container/MI.RadixSort.h"
+#include "Container/MI.SortedArray.h"
+#include "Container/MI.TypedVector.h"
+#include "Mesh/MI.FlatMesh.h"
+
+// Перенумерация вершин и элементов для локальности памяти.
+// ======================================================
+//
+// Сетки из генератора нумеруют вершины и элементы почти случайно, поэтому проход по элементам с чтением вершин
+// (MI quality, поиск соседей) на каждом элементе промахивается мимо кэша. После перенумерации соседние в пространстве
+// вершины получают близкие номера, а элементы идут в порядке своих вершин.
+//
+// - reorder_method::hilbert - вершины сортируются по ключу кривой Гильберта (21 бит на ось) их координат.
+// - reorder_method::rcm     - обратный алгоритм Катхилла-Макки по графу ребер элементов: уменьшает ширину ленты,
+//                             не зависит от координат.
+//
+// Элементы в обоих случаях сортируются по наименьшему новому номеру своей вершины (сортировка стабильная).
+// Сортировки выполняются MI radix_sort_by_key.
+//
+// Перестановки возвращаются как typed_vector, индексируемые и заполненные strong_alias, поэтому старый номер нельзя
+// случайно использовать как новый, а массивы номеров (свойства вершин, граничные условия) перенумеровываются
+// MI remap(values, permutation.vertex_old_to_new):
+//
+// const MI mesh_permutation permutation = MI reorder(mesh, MI reorder_method::hilbert);
+// MI remap(boundary_vertices.span(), permutation.vertex_old_to_new.span());
+namespace mi {
+MI_NEW_STRONG_ALIAS(vertex_index, size_t);
+MI_NEW_STRONG_ALIAS(element_index, size_t);
+
+enum class reorder_method {
+  hilbert,
+  rcm
+};
+
+struct mesh_permutation {
+    typed_vector<vertex_index, vertex_index>   vertex_old_to_new;   // [старый номер] -> новый номер
+    typed_vector<vertex_index, vertex_index>   vertex_new_to_old;   // [новый номер] -> старый номер
+    typed_vector<element_index, element_index> element_old_to_new;  // [старый номер] -> новый номер
+    typed_vector<element_index, element_index> element_new_to_old;  // [новый номер] -> старый номер
+};
+
+namespace internal {
+constexpr STD uint32_t hilbert_bits = 21;
+
+// Номер точки на трехмерной кривой Гильберта порядка hilbert_bits (J. Skilling, "Programming the Hilbert curve", 2004).
+MI_NODISCARD inline STD uint64_t hilbert_key(STD array<STD uint32_t, 3> x) noexcept {
+  constexpr STD uint32_t top = STD uint32_t{1} << (hilbert_bits - 1);
+
+  // Обратное преобразование осей.
+  for (STD uint32_t q = top; q > 1; q >>= 1) {
+    const STD uint32_t p = q - 1;
+
+    // Без ветвлений: биты координат случайны, и ветвление по (x[i] & q) почти всегда предсказывается неверно.
+    // Если бит установлен - x[0] ^= p, иначе младшие биты x[0] и x[i] меняются местами.
+    for (size_t i = 0; i < 3; ++i) {
+      const STD uint32_t is_set = STD uint32_t{0} - static_cast<STD uint32_t>((x[i] & q) != 0);
+      const STD uint32_t t      = (x[0] ^ x[i]) & p & ~is_set;
+
+      x[0] ^= (p & is_set) | t;
+      x[i] ^= t;
+    }
+  }
+
+  // Код Грея.
+  x[1] ^= x[0];
+  x[2] ^= x[1];
+
+  STD uint32_t t = 0;
+
+  for (STD uint32_t q = top; q > 1; q >>= 1) {
+    if (x[2] & q) {
+      t ^= q - 1;
+    }
+  }
+
+  for (auto& value: x) {
+    value ^= t;
+  }
+
+  // Перемежение битов транспонированного представления.
+  STD uint64_t key = 0;
+
+  for (STD uint32_t bit = hilbert_bits; bit-- > 0;) {
+    for (size_t i = 0; i < 3; ++i) {
+      key = (key << 1) | ((x[i] >> bit) & 1);
+    }
+  }
+
+  return key;
+}
+
+// Координата, приведенная к целому [0; 2^hilbert_bits) внутри [min; min + extent].
+MI_NODISCARD inline STD uint32_t quantize(const double value, const double min, const double extent) noexcept {
+  constexpr double max_cell = static_cast<double>((STD uint32_t{1} << hilbert_bits) - 1);
+
+  if (!(extent > 0.)) {
+    return 0;
+  }
+
+  return static_cast<STD uint32_t>(STD clamp((value - min) / extent, 0., 1.) * max_cell);
+}
+
+template<size_t NodesPerElement>
+MI_NODISCARD STD vector<size_t> hilbert_vertex_order(const flat_mesh<NodesPerElement>& mesh, const size_t n_threads) {
+  const size_t n_vertices = mesh.n_vertices();
+
+  double min[3] = {STD numeric_limits<double>::max(), STD numeric_limits<double>::max(),
+                   STD numeric_limits<double>::max()};
+  double max[3] = {STD numeric_limits<double>::lowest(), STD numeric_limits<double>::lowest(),
+                   STD numeric_limits<double>::lowest()};
+
+  for (const MI point3d& vertex: mesh.vertices) {
+    const double xyz[3] = {vertex.x(), vertex.y(), vertex.z()};
+
+    for (size_t i = 0; i < 3; ++i) {
+      min[i] = STD min(min[i], xyz[i]);
+      max[i] = STD max(max[i], xyz[i]);
+    }
+  }
+
+  // Общий масштаб по всем осям сохраняет пропорции сетки.
+  const double extent = STD max({max[0] - min[0], max[1] - min[1], max[2] - min[2]});
+
+  STD vector<MI sorted_array1u64> keys(n_vertices);
+  STD vector<size_t>              order(n_vertices);
+
+  parallel_chunks(n_vertices, n_threads, [&](size_t, const size_t first, const size_t last) {
+    for (size_t n_vertex = first; n_vertex < last; ++n_vertex) {
+      const MI point3d& vertex = mesh.vertices[n_vertex];
+
+      keys[n_vertex]  = {hilbert_key({quantize(vertex.x(), min[0], extent),
+                                      quantize(vertex.y(), min[1], extent),
+                                      quantize(vertex.z(), min[2], extent)})};
+      order[n_vertex] = n_vertex;
+    }
+  });
+
+  MI radix_sort_by_key(keys.begin(), keys.end(), order.begin(), n_threads);
+
+  return order;
+}
+
+// Соседи вершин по ребрам элементов (CSR: offsets + payload). Для квадратичных элементов - по половинам ребер
+// и от центра к серединам ребер (MI internal::contour_segments, MI internal::interior_segments).
+template<size_t NodesPerElement>
+void vertex_neighbors(const flat_mesh<NodesPerElement>& mesh,
+                      STD vector<size_t>&               offsets,
+                      STD vector<size_t>&               neighbors) {
+  constexpr auto contour  = contour_segments<NodesPerElement>();
+  constexpr auto interior = interior_segments<NodesPerElement>();
+
+  const auto for_each_segment = [&](const auto& element, const auto& fn) {
+    for (const auto& segment: contour) {
+      fn(element[segment[0]], element[segment[1]]);
+    }
+
+    for (const auto& segment: interior) {
+      fn(element[segment[0]], element[segment[1]]);
+    }
+  };
+
+  offsets.assign(mesh.n_vertices() + 1, 0);
+
+  for (const auto& element: mesh.elements) {
+    for_each_segment(element, [&](const size_t first, const size_t second) {
+      ++offsets[first + 1];
+      ++offsets[second + 1];
+    });
+  }
+
+  STD partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+  neighbors.resize(offsets.back());
+  STD vector<size_t> positions(offsets.begin(), offsets.end() - 1);
+
+  for (const auto& element: mesh.elements) {
+    for_each_segment(element, [&](const size_t first, const size_t second) {
+      neighbors[positions[first]++]  = second;
+      neighbors[positions[second]++] = first;
+    });
+  }
+
+  // Убираем повторы (каждое внутреннее ребро встречается в двух элементах) и сжимаем CSR.
+  size_t write = 0;
+
+  for (size_t n_vertex = 0; n_vertex < mesh.n_vertices(); ++n_vertex) {
+    const auto first = neighbors.begin() + static_cast<STD ptrdiff_t>(offsets[n_vertex]);
+    const auto last  = neighbors.begin() + static_cast<STD ptrdiff_t>(offsets[n_vertex + 1]);
+
+    STD sort(first, last);
+
+    const auto unique_last = STD unique(first, last);
+
+    offsets[n_vertex] = write;
+    write = static_cast<size_t>(STD copy(first, unique_last, neighbors.begin() + static_cast<STD ptrdiff_t>(write)) -
+                                neighbors.begin());
+  }
+
+  offsets.back() = write;
+  neighbors.resize(write);
+}
+
+// Обход в ширину от start, соседи посещаются по возрастанию степени. Возвращает последний уровень.
+inline void cuthill_mckee_level(const STD vector<size_t>& offsets,
+                                const STD vector<size_t>& neighbors,
+                                const size_t              start,
+                                STD vector<char>&         visited,
+                                STD vector<size_t>&       order,
+                                STD vector<size_t>&       last_level) {
+  const auto degree = [&](const size_t n_vertex) {
+    return offsets[n_vertex + 1] - offsets[n_vertex];
+  };
+
+  size_t level_first = order.size();
+
+  visited[start] = 1;
+  order.push_back(start);
+
+  STD vector<size_t> adjacent;
+
+  for (size_t head = level_first; head < order.size();) {
+    const size_t level_last = order.size();
+
+    for (; head < level_last; ++head) {
+      const size_t n_vertex = order[head];
+
+      adjacent.clear();
+
+      for (size_t i = offsets[n_vertex]; i < offsets[n_vertex + 1]; ++i) {
+        if (!visited[neighbors[i]]) {
+          visited[neighbors[i]] = 1;
+          adjacent.push_back(neighbors[i]);
+        }
+      }
+
+      STD stable_sort(adjacent.begin(), adjacent.end(), [&](const size_t lhs, const size_t rhs) {
+        return degree(lhs) < degree(rhs);
+      });
+
+      order.insert(order.end(), adjacent.begin(), adjacent.end());
+    }
+
+    if (level_last == order.size()) {
+      last_level.assign(order.begin() + static_cast<STD ptrdiff_t>(level_first),
+                        order.begin() + static_cast<STD ptrdiff_t>(level_last));
+    }
+
+    level_first = level_last;
+  }
+}
+
+template<size_t NodesPerElement>
+MI_NODISCARD STD vector<size_t> rcm_vertex_order(const flat_mesh<NodesPerElement>& mesh) {
+  const size_t n_vertices = mesh.n_vertices();
+
+  STD vector<size_t> offsets;
+  STD vector<size_t> neighbors;
+  vertex_neighbors(mesh, offsets, neighbors);
+
+  const auto degree = [&](const size_t n_vertex) {
+    return offsets[n_vertex + 1] - offsets[n_vertex];
+  };
+
+  STD vector<size_t> by_degree(n_vertices);
+  STD iota(by_degree.begin(), by_degree.end(), size_t{0});
+  STD stable_sort(by_degree.begin(), by_degree.end(), [&](const size_t lhs, const size_t rhs) {
+    return degree(lhs) < degree(rhs);
+  });
+
+  STD vector<size_t> order;
+  order.reserve(n_vertices);
+
+  STD vector<char>   visited(n_vertices, 0);
+  STD vector<char>   probe_visited(n_vertices, 0);
+  STD vector<size_t> probe_order;
+  STD vector<size_t> last_level;
+
+  for (const size_t seed: by_degree) {
+    if (visited[seed]) {
+      continue;
+    }
+
+    // Псевдопериферийная вершина компоненты: вершина наименьшей степени на последнем уровне обхода из seed.
+    // Компоненты обходятся целиком, поэтому в компоненте seed посещенных вершин нет и пробный обход не смотрит на
+    // visited. После него сбрасываются только посещенные им вершины: O(размер компоненты), а не O(V) на компоненту.
+    probe_order.clear();
+    cuthill_mckee_level(offsets, neighbors, seed, probe_visited, probe_order, last_level);
+
+    for (const size_t n_vertex: probe_order) {
+      probe_visited[n_vertex] = 0;
+    }
+
+    const size_t start = *STD min_element(last_level.begin(), last_level.end(), [&](const size_t lhs,
+                                                                                      const size_t rhs) {
+      return degree(lhs) < degree(rhs);
+    });
+
+    cuthill_mckee_level(offsets, neighbors, start, visited, order, last_level);
+  }
+
+  STD reverse(order.begin(), order.end());
+
+  return order;
+}
+}  // namespace internal
+
+// Перестановка вершин и элементов, сетка не меняется.
+template<size_t NodesPerElement>
+MI_NODISCARD mesh_permutation compute_reordering(const flat_mesh<NodesPerElement>& mesh,
+                                                 const reorder_method              method    = reorder_method::hilbert,
+                                                 const size_t                      n_threads = MI default_thread_count()) {
+  const size_t n_vertices = mesh.n_vertices();
+  const size_t n_elements = mesh.n_elements();
+
+  const STD vector<size_t> vertex_order = method == reorder_method::hilbert
+                                            ? internal::hilbert_vertex_order(mesh, n_threads)
+                                            : internal::rcm_vertex_order(mesh);
+
+  MI_CHECK(vertex_order.size() == n_vertices);
+
+  mesh_permutation result;
+  result.vertex_old_to_new.resize(n_vertices);
+  result.vertex_new_to_old.resize(n_vertices);
+
+  for (size_t n_new = 0; n_new < n_vertices; ++n_new) {
+    result.vertex_new_to_old[vertex_index(n_new)]               = vertex_index(vertex_order[n_new]);
+    result.vertex_old_to_new[vertex_index(vertex_order[n_new])] = vertex_index(n_new);
+  }
+
+  STD vector<MI sorted_array1u64> keys(n_elements);
+  STD vector<size_t>              element_order(n_elements);
+
+  parallel_chunks(n_elements, n_threads, [&](size_t, const size_t first, const size_t last) {
+    for (size_t n_element = first; n_element < last; ++n_element) {
+      size_t min_vertex = n_vertices;
+
+      for (const size_t n_vertex: mesh.elements[n_element]) {
+        min_vertex = STD min(min_vertex, result.vertex_old_to_new[vertex_index(n_vertex)].value());
+      }
+
+      keys[n_element]          = {static_cast<STD uint64_t>(min_vertex)};
+      element_order[n_element] = n_element;
+    }
+  });
+
+  MI radix_sort_by_key(keys.begin(), keys.end(), element_order.begin(), n_threads);
+
+  result.element_old_to_new.resize(n_elements);
+  result.element_new_to_old.resize(n_elements);
+
+  for (size_t n_new = 0; n_new < n_elements; ++n_new) {
+    result.element_new_to_old[element_index(n_new)]                = element_index(element_order[n_new]);
+    result.element_old_to_new[element_index(element_order[n_new])] = element_index(n_new);
+  }
+
+  return result;
+}
+
+// Переставляет вершины и элементы сетки согласно permutation.
+template<size_t NodesPerElement>
+void apply_reordering(flat_mesh<NodesPerElement>& mesh, const mesh_permutation& permutation) {
+  MI_CHECK(permutation.vertex_new_to_old.size() == mesh.n_vertices());
+  MI_CHECK(permutation.element_new_to_old.size() == mesh.n_elements());
+
+  STD vector<MI point3d> vertices(mesh.n_vertices());
+
+  for (size_t n_new = 0; n_new < mesh.n_vertices(); ++n_new) {
+    vertices[n_new] = mesh.vertices[permutation.vertex_new_to_old[vertex_index(n_new)].value()];
+  }
+
+  using element_type = typename flat_mesh<NodesPerElement>::element_type;
+
+  STD vector<element_type> elements(mesh.n_elements());
+
+  for (size_t n_new = 0; n_new < mesh.n_elements(); ++n_new) {
+    const element_type& old_element = mesh.elements[permutation.element_new_to_old[element_index(n_new)].value()];
+
+    for (size_t i = 0; i < NodesPerElement; ++i) {
+      elements[n_new][i] = permutation.vertex_old_to_new[vertex_index(old_element[i])].value();
+    }
+  }
+
+  mesh.vertices = STD move(vertices);
+  mesh.elements = STD move(elements);
+}
+
+// Перенумеровывает сетку, возвращает примененную перестановку.
+template<size_t NodesPerElement>
+mesh_permutation reorder(flat_mesh<NodesPerElement>& mesh,
+                         const reorder_method        method    = reorder_method::hilbert,
+                         const size_t                n_threads = MI default_thread_count()) {
+  mesh_permutation result = compute_reordering(mesh, method, n_threads);
+  apply_reordering(mesh, result);
+
+  return result;
+}
+}  // namespace mi
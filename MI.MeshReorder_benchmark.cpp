@@ -0,0 +1,113 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "Mesh/MI.FlatMesh.h"
+#include "Mesh/MI.MeshReorder.h"
+
+// Проход MI quality по сетке со случайной нумерацией (как после генератора) и после перенумерации.
+//
+// Аргументы: количество элементов и порядок (0 - случайный, 1 - кривая Гильберта, 2 - RCM). Разница между
+// BM_QualityScan/N/0 и BM_QualityScan/N/1 - цена промахов кэша при чтении вершин, арифметика одинаковая.
+//
+// MI.MeshReorder_benchmark --benchmark_format=json --benchmark_out=reorder.json
+
+namespace mi::benchmark {
+namespace {
+// Решетка quad в плоскости z = 0 со случайной нумерацией вершин и элементов.
+MI flat_quad_mesh make_shuffled_quad_mesh(const size_t n_elements) {
+  size_t n = 1;
+
+  while (n * n < n_elements) {
+    ++n;
+  }
+
+  const size_t n_vertices = (n + 1) * (n + 1);
+
+  STD mt19937                            generator(42);
+  STD uniform_real_distribution<double> jitter(-0.2, 0.2);
+
+  STD vector<size_t> vertex_ids(n_vertices);
+  STD iota(vertex_ids.begin(), vertex_ids.end(), size_t{0});
+  STD shuffle(vertex_ids.begin(), vertex_ids.end(), generator);
+
+  MI flat_quad_mesh mesh;
+  mesh.vertices.resize(n_vertices);
+  mesh.elements.reserve(n * n);
+
+  for (size_t j = 0; j <= n; ++j) {
+    for (size_t i = 0; i <= n; ++i) {
+      const bool inner = i > 0 && j > 0 && i < n && j < n;
+
+      mesh.vertices[vertex_ids[j * (n + 1) + i]] = {static_cast<double>(i) + (inner ? jitter(generator) : 0.),
+                                                    static_cast<double>(j) + (inner ? jitter(generator) : 0.),
+                                                    0.};
+    }
+  }
+
+  for (size_t j = 0; j < n; ++j) {
+    for (size_t i = 0; i < n; ++i) {
+      const size_t v0 = j * (n + 1) + i;
+
+      mesh.elements.push_back({vertex_ids[v0], vertex_ids[v0 + 1], vertex_ids[v0 + n + 2], vertex_ids[v0 + n + 1]});
+    }
+  }
+
+  STD shuffle(mesh.elements.begin(), mesh.elements.end(), generator);
+
+  return mesh;
+}
+}  // namespace
+
+void BM_QualityScan(::benchmark::State& state) {
+  MI flat_quad_mesh mesh = make_shuffled_quad_mesh(static_cast<size_t>(state.range(0)));
+
+  if (state.range(1) == 1) {
+    static_cast<void>(MI reorder(mesh, MI reorder_method::hilbert));
+  } else if (state.range(1) == 2) {
+    static_cast<void>(MI reorder(mesh, MI reorder_method::rcm));
+  }
+
+  for (auto _: state) {
+    double sum = 0.;
+
+    for (size_t n_element = 0; n_element < mesh.n_elements(); ++n_element) {
+      sum += MI element_quality(mesh, n_element);
+    }
+
+    ::benchmark::DoNotOptimize(sum);
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(mesh.n_elements()));
+}
+
+// Стоимость самой перенумерации.
+void BM_Reorder(::benchmark::State& state) {
+  const MI flat_quad_mesh original = make_shuffled_quad_mesh(static_cast<size_t>(state.range(0)));
+  const auto              method   = state.range(1) == 1 ? MI reorder_method::hilbert : MI reorder_method::rcm;
+
+  for (auto _: state) {
+    state.PauseTiming();
+    MI flat_quad_mesh mesh = original;
+    state.ResumeTiming();
+
+    ::benchmark::DoNotOptimize(MI reorder(mesh, method));
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(original.n_elements()));
+}
+
+BENCHMARK(BM_QualityScan)
+  ->ArgsProduct({{1 << 16, 1 << 20, 1 << 23}, {0, 1, 2}})
+  ->ArgNames({"elements", "order"})
+  ->Unit(::benchmark::kMillisecond);
+BENCHMARK(BM_Reorder)
+  ->ArgsProduct({{1 << 16, 1 << 20, 1 << 23}, {1, 2}})
+  ->ArgNames({"elements", "method"})
+  ->Unit(::benchmark::kMillisecond);
+}  // namespace mi::benchmark
+
+BENCHMARK_MAIN();
@@ -0,0 +1,216 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "Container/MI.StrongAliasAlgorithm.h"
+#include "Mesh/MI.MeshReorder.h"
+#include "Mesh/MI.MeshTestUtil.h"
+
+namespace mi::test {
+MI_NEW_STRONG_ALIAS(corner_id, size_t);
+
+namespace {
+// Решетка n x n quad со случайной нумерацией вершин и элементов.
+MI flat_quad_mesh shuffled_grid(const size_t n) {
+  grid_options options;
+  options.shuffle = true;
+
+  return make_grid(n, options);
+}
+
+// Наибольшая разность номеров вершин одного элемента.
+size_t bandwidth(const MI flat_quad_mesh& mesh) {
+  size_t result = 0;
+
+  for (const auto& element: mesh.elements) {
+    const auto [min, max] = STD minmax_element(element.begin(), element.end());
+    result                = STD max(result, *max - *min);
+  }
+
+  return result;
+}
+
+// Средняя разность номеров вершин одного элемента.
+double mean_spread(const MI flat_quad_mesh& mesh) {
+  double result = 0.;
+
+  for (const auto& element: mesh.elements) {
+    const auto [min, max] = STD minmax_element(element.begin(), element.end());
+    result += static_cast<double>(*max - *min);
+  }
+
+  return result / static_cast<double>(mesh.n_elements());
+}
+
+template<class Alias>
+void expect_inverse(const MI typed_vector<Alias, Alias>& old_to_new, const MI typed_vector<Alias, Alias>& new_to_old) {
+  ASSERT_EQ(old_to_new.size(), new_to_old.size());
+
+  for (size_t i = 0; i < old_to_new.size(); ++i) {
+    EXPECT_EQ(new_to_old[old_to_new[Alias(i)]], Alias(i));
+  }
+}
+
+void expect_reordered(const MI reorder_method method) {
+  const MI flat_quad_mesh original = shuffled_grid(32);
+  MI flat_quad_mesh       mesh     = original;
+
+  const MI mesh_permutation permutation = MI reorder(mesh, method, 4);
+
+  expect_inverse(permutation.vertex_old_to_new, permutation.vertex_new_to_old);
+  expect_inverse(permutation.element_old_to_new, permutation.element_new_to_old);
+
+  // Геометрия и связность не изменились.
+  for (size_t n_old = 0; n_old < original.n_elements(); ++n_old) {
+    const auto& old_element = original.elements[n_old];
+    const auto& new_element = mesh.elements[permutation.element_old_to_new[MI element_index(n_old)].value()];
+
+    for (size_t i = 0; i < 4; ++i) {
+      EXPECT_EQ(mesh.vertices[new_element[i]], original.vertices[old_element[i]]);
+    }
+  }
+
+  // Элементы идут по возрастанию наименьшего номера вершины.
+  EXPECT_TRUE(STD is_sorted(mesh.elements.begin(), mesh.elements.end(), [](const auto& lhs, const auto& rhs) {
+    return *STD min_element(lhs.begin(), lhs.end()) < *STD min_element(rhs.begin(), rhs.end());
+  }));
+
+  EXPECT_LT(mean_spread(mesh), mean_spread(original) / 8);
+}
+}  // namespace
+
+TEST(MeshReorder, HilbertKeyIsBijectiveOnSmallCube) {
+  STD vector<STD uint64_t> keys;
+
+  for (STD uint32_t x = 0; x < 4; ++x) {
+    for (STD uint32_t y = 0; y < 4; ++y) {
+      for (STD uint32_t z = 0; z < 4; ++z) {
+        keys.push_back(MI internal::hilbert_key({x, y, z}));
+      }
+    }
+  }
+
+  STD sort(keys.begin(), keys.end());
+
+  EXPECT_EQ(STD unique(keys.begin(), keys.end()), keys.end());
+}
+
+TEST(MeshReorder, Hilbert) {
+  expect_reordered(MI reorder_method::hilbert);
+}
+
+TEST(MeshReorder, Rcm) {
+  expect_reordered(MI reorder_method::rcm);
+
+  // Для решетки RCM дает ленту порядка ширины решетки.
+  MI flat_quad_mesh mesh = shuffled_grid(32);
+  static_cast<void>(MI reorder(mesh, MI reorder_method::rcm));
+
+  EXPECT_LE(bandwidth(mesh), 2 * 34);
+}
+
+TEST(MeshReorder, RcmKeepsComponentsContiguous) {
+  // 200 отдельных quad: вершины перемешаны, каждый элемент - своя компонента связности.
+  constexpr size_t n_components = 200;
+
+  STD mt19937        generator(11);
+  STD vector<size_t> vertex_ids(4 * n_components);
+  STD iota(vertex_ids.begin(), vertex_ids.end(), size_t{0});
+  STD shuffle(vertex_ids.begin(), vertex_ids.end(), generator);
+
+  MI flat_quad_mesh mesh;
+  mesh.vertices.resize(vertex_ids.size());
+
+  for (size_t n_component = 0; n_component < n_components; ++n_component) {
+    const double x = 2. * static_cast<double>(n_component);
+
+    mesh.vertices[vertex_ids[4 * n_component]]     = {x, 0., 0.};
+    mesh.vertices[vertex_ids[4 * n_component + 1]] = {x + 1., 0., 0.};
+    mesh.vertices[vertex_ids[4 * n_component + 2]] = {x + 1., 1., 0.};
+    mesh.vertices[vertex_ids[4 * n_component + 3]] = {x, 1., 0.};
+    mesh.elements.push_back({vertex_ids[4 * n_component],
+                             vertex_ids[4 * n_component + 1],
+                             vertex_ids[4 * n_component + 2],
+                             vertex_ids[4 * n_component + 3]});
+  }
+
+  static_cast<void>(MI reorder(mesh, MI reorder_method::rcm));
+
+  // Вершины каждой компоненты получают подряд идущие номера.
+  EXPECT_EQ(bandwidth(mesh), 3);
+
+  for (const auto& element: mesh.elements) {
+    EXPECT_EQ(mesh.vertices[element[1]] - mesh.vertices[element[0]], MI point3d(1., 0., 0.));
+  }
+}
+
+TEST(MeshReorder, QuadraticNeighbors) {
+  // 2 9-узловых quad рядом: узлы (i, j) сетки 5 x 3 с номерами j * 5 + i.
+  MI flat_quadratic_quad_mesh mesh;
+
+  for (size_t j = 0; j < 3; ++j) {
+    for (size_t i = 0; i < 5; ++i) {
+      mesh.vertices.push_back({static_cast<double>(i), static_cast<double>(j), 0.});
+    }
+  }
+
+  mesh.elements = {
+    {0, 2, 12, 10, 1, 7, 11, 5, 6},
+    {2, 4, 14, 12, 3, 9, 13, 7, 8}
+  };
+
+  STD vector<size_t> offsets;
+  STD vector<size_t> neighbors;
+  MI internal::vertex_neighbors(mesh, offsets, neighbors);
+
+  const auto neighbors_of = [&](const size_t n_vertex) {
+    return STD vector<size_t>(neighbors.begin() + static_cast<STD ptrdiff_t>(offsets[n_vertex]),
+                              neighbors.begin() + static_cast<STD ptrdiff_t>(offsets[n_vertex + 1]));
+  };
+
+  // Угол - только середины своих ребер, середина ребра - концы ребра и центры элементов, центр - середины ребер.
+  EXPECT_THAT(neighbors_of(0), testing::ElementsAre(1, 5));
+  EXPECT_THAT(neighbors_of(2), testing::ElementsAre(1, 3, 7));
+  EXPECT_THAT(neighbors_of(7), testing::ElementsAre(2, 6, 8, 12));
+  EXPECT_THAT(neighbors_of(6), testing::ElementsAre(1, 5, 7, 11));
+
+  STD vector<size_t> order = MI internal::rcm_vertex_order(mesh);
+  STD sort(order.begin(), order.end());
+
+  STD vector<size_t> expected(mesh.n_vertices());
+  STD iota(expected.begin(), expected.end(), size_t{0});
+
+  EXPECT_EQ(order, expected);
+}
+
+TEST(MeshReorder, RemapVertexProperty) {
+  MI flat_quad_mesh mesh = shuffled_grid(4);
+
+  // Номера угловых вершин в старой нумерации.
+  MI typed_vector<corner_id, MI vertex_index> corners;
+
+  for (size_t n_vertex = 0; n_vertex < mesh.n_vertices(); ++n_vertex) {
+    const MI point3d& p = mesh.vertices[n_vertex];
+
+    if ((p.x() == 0. || p.x() == 4.) && (p.y() == 0. || p.y() == 4.)) {
+      corners.push_back(MI vertex_index(n_vertex));
+    }
+  }
+
+  const STD vector<MI point3d> old_vertices = mesh.vertices;
+  const MI mesh_permutation     permutation  = MI reorder(mesh);
+
+  MI remap(corners.span(), permutation.vertex_old_to_new.span());
+
+  ASSERT_EQ(corners.size(), 4);
+
+  for (const MI vertex_index corner: corners) {
+    EXPECT_EQ(mesh.vertices[corner.value()],
+              old_vertices[permutation.vertex_new_to_old[corner].value()]);
+  }
+}
+}  // namespace mi::test
@@ -0,0 +1,83 @@
+﻿#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "Mesh/MI.FlatMesh.h"
+
+// Сетки для тестов.
+// =================
+//
+// make_grid<NodesPerElement>(n, options) - решетка n x n ячеек в плоскости z = 0 с шагом 1 по x и options.step_y
+// по y. Ячейка - один quad (v00, v10, v11, v01) или два треугольника (v00, v10, v11) и (v00, v11, v01). Без
+// перемешивания вершина (i, j) имеет номер j * (n + 1) + i, а элементы идут по строкам.
+//
+// Случайные смещения и перемешивание задаются зерном options.seed, поэтому сетка воспроизводима.
+namespace mi::test {
+struct grid_options {
+    double       step_y  = 1.;     // Шаг решетки по y
+    double       jitter  = 0.;     // Наибольшее смещение внутренних вершин по x и y
+    double       warp    = 0.;     // Наибольшее смещение всех вершин по z
+    bool         shuffle = false;  // Случайная нумерация вершин и элементов
+    STD uint32_t seed    = 7;      // Зерно генератора смещений и перемешивания
+};
+
+template<size_t NodesPerElement = 4>
+MI flat_mesh<NodesPerElement> make_grid(const size_t n, const grid_options& options = {}) {
+  static_assert(NodesPerElement == 3 || NodesPerElement == 4, "make_grid: only triangles and quads are supported");
+
+  STD mt19937                            generator(options.seed);
+  STD uniform_real_distribution<double> shift(-options.jitter, options.jitter);
+  STD uniform_real_distribution<double> height(-options.warp, options.warp);
+
+  const size_t n_vertices = (n + 1) * (n + 1);
+
+  // Номер вершины (i, j) решетки в сетке.
+  STD vector<size_t> vertex_ids(n_vertices);
+  STD iota(vertex_ids.begin(), vertex_ids.end(), size_t{0});
+
+  if (options.shuffle) {
+    STD shuffle(vertex_ids.begin(), vertex_ids.end(), generator);
+  }
+
+  MI flat_mesh<NodesPerElement> mesh;
+  mesh.vertices.resize(n_vertices);
+
+  for (size_t j = 0; j <= n; ++j) {
+    for (size_t i = 0; i <= n; ++i) {
+      const bool   is_inner = i > 0 && j > 0 && i < n && j < n;
+      const double dx       = is_inner && options.jitter > 0. ? shift(generator) : 0.;
+      const double dy       = is_inner && options.jitter > 0. ? shift(generator) : 0.;
+      const double dz       = options.warp > 0. ? height(generator) : 0.;
+
+      mesh.vertices[vertex_ids[j * (n + 1) + i]] = {
+        static_cast<double>(i) + dx, static_cast<double>(j) * options.step_y + dy, dz};
+    }
+  }
+
+  for (size_t j = 0; j < n; ++j) {
+    for (size_t i = 0; i < n; ++i) {
+      const size_t v00 = vertex_ids[j * (n + 1) + i];
+      const size_t v10 = vertex_ids[j * (n + 1) + i + 1];
+      const size_t v01 = vertex_ids[(j + 1) * (n + 1) + i];
+      const size_t v11 = vertex_ids[(j + 1) * (n + 1) + i + 1];
+
+      if constexpr (NodesPerElement == 3) {
+        mesh.elements.push_back({v00, v10, v11});
+        mesh.elements.push_back({v00, v11, v01});
+      } else {
+        mesh.elements.push_back({v00, v10, v11, v01});
+      }
+    }
+  }
+
+  if (options.shuffle) {
+    STD shuffle(mesh.elements.begin(), mesh.elements.end(), generator);
+  }
+
+  return mesh;
+}
+}  // namespace mi::test
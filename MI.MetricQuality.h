@@ -0,0 +1,190 @@
+﻿#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+#include "Common/MI.Check.h"
+#include "Common/MI.ParallelFor.h"
+#include "Common/MI.Predicates.h"
+#include "Container/MI.Matrix.h"
+#include "Mesh/MI.FlatMesh.h"
+#include "Mesh/MI.QualityGradient.h"
+
+// Mean ratio quality в анизотропной метрике.
+// ==========================================
+//
+// MI quality и MI mean_ratio_quality сравнивают элемент с правильным треугольником или квадратом в евклидовой метрике.
+// Адаптивному перестроению сетки нужна та же мера относительно поля метрики M (симметричная положительно определенная
+// матрица 3 x 3): длина ребра e в метрике - √(e^T * M * e). Если M = U^T * U (разложение Холецкого, U - верхняя
+// треугольная), то длины и площади в метрике - евклидовы длины и площади после отображения e -> U * e, поэтому
+// mean ratio в метрике - формула симплекс-узла (MI internal::mean_ratio_weights) для U * e1 и U * e2. При M = I
+// результат совпадает с MI mean_ratio_quality.
+//
+// Ориентация симплекс-узлов проверяется в исходном пространстве (MI orient_along): U сохраняет ориентацию.
+//
+// Разложение считается один раз на элемент и хранится (metric_factor, 6 чисел): оценка кандидата перестроения
+// в цикле - одно умножение треугольной матрицы на ребро сверх изотропного расчета.
+//
+// const STD vector<MI metric_factor> factors = MI element_metric_factors(mesh, vertex_metrics);  // Один раз
+// const STD vector<double>           quality = MI evaluate_metric_quality(mesh, factors);
+// const double candidate = MI metric_mean_ratio_quality(p, factors[n_element], normal);          // Во внутреннем цикле
+namespace mi {
+// Верхняя треугольная матрица U разложения метрики M = U^T * U.
+struct metric_factor {
+    double xx = 0.;
+    double xy = 0.;
+    double xz = 0.;
+    double yy = 0.;
+    double yz = 0.;
+    double zz = 0.;
+
+    MI_NODISCARD MI point3d operator*(const MI point3d& v) const {
+      return {xx * v.x() + xy * v.y() + xz * v.z(), yy * v.y() + yz * v.z(), zz * v.z()};
+    }
+
+    // Нулевой множитель - метрика не положительно определена, качество элементов с ним 0.
+    MI_NODISCARD bool is_valid() const noexcept {
+      return xx > 0. && yy > 0. && zz > 0.;
+    }
+};
+
+// Разложение Холецкого. Возвращает нулевой множитель, если метрика не положительно определена.
+MI_NODISCARD inline metric_factor factorize_metric(const MI symmetric_matrix3d& metric) {
+  metric_factor result;
+
+  if (!(metric.xx > 0.)) {
+    return {};
+  }
+
+  result.xx = STD sqrt(metric.xx);
+  result.xy = metric.xy / result.xx;
+  result.xz = metric.xz / result.xx;
+
+  const double yy = metric.yy - result.xy * result.xy;
+
+  if (!(yy > 0.)) {
+    return {};
+  }
+
+  result.yy = STD sqrt(yy);
+  result.yz = (metric.yz - result.xy * result.xz) / result.yy;
+
+  const double zz = metric.zz - result.xz * result.xz - result.yz * result.yz;
+
+  if (!(zz > 0.)) {
+    return {};
+  }
+
+  result.zz = STD sqrt(zz);
+
+  return result;
+}
+
+// Качество элемента в метрике U^T * U, 0 для недействительного элемента или недействительной метрики.
+template<size_t NodesPerElement>
+MI_NODISCARD double metric_mean_ratio_quality(const STD array<MI point3d, NodesPerElement>& p,
+                                              const metric_factor&                          factor,
+                                              const MI point3d&                             reference_normal) {
+  double result   = 0.;
+  bool   is_valid = factor.is_valid();
+
+  internal::for_each_simplex_node<NodesPerElement>([&](const size_t                        left,
+                                                       const size_t                        mid,
+                                                       const size_t                        right,
+                                                       const internal::mean_ratio_weights& w,
+                                                       const double                        scale) {
+    if (!is_valid) {
+      return;
+    }
+
+    const MI point3d e1   = factor * (p[right] - p[mid]);
+    const MI point3d e2   = factor * (p[left] - p[mid]);
+    const double     area = STD sqrt(e1.cross(e2).squared_euclidean_norm());
+
+    if (!(area > 0.) || !(MI orient_along(p[mid], p[right], p[left], reference_normal) > 0.)) {
+      is_valid = false;
+
+      return;
+    }
+
+    const MI point3d s1 = e1 * w.a;
+    const MI point3d s2 = e1 * w.b + e2 * w.d;
+
+    result += scale * 2. * w.a * w.d * area / (s1.squared_euclidean_norm() + s2.squared_euclidean_norm());
+  });
+
+  return is_valid ? result : 0.;
+}
+
+// Множители метрик, заданных на элементах.
+MI_NODISCARD inline STD vector<metric_factor> element_metric_factors(
+  const STD vector<MI symmetric_matrix3d>& metrics,
+  const size_t                             n_threads = MI default_thread_count()) {
+  STD vector<metric_factor> result(metrics.size());
+
+  parallel_chunks(metrics.size(), n_threads, [&](size_t, const size_t first, const size_t last) {
+    for (size_t n_element = first; n_element < last; ++n_element) {
+      result[n_element] = factorize_metric(metrics[n_element]);
+    }
+  });
+
+  return result;
+}
+
+// Множители метрик, заданных в вершинах: метрика элемента - среднее арифметическое метрик его вершин.
+template<size_t NodesPerElement>
+MI_NODISCARD STD vector<metric_factor> element_metric_factors(const flat_mesh<NodesPerElement>&        mesh,
+                                                              const STD vector<MI symmetric_matrix3d>& vertex_metrics,
+                                                              const size_t n_threads = MI default_thread_count()) {
+  MI_CHECK(vertex_metrics.size() == mesh.n_vertices());
+
+  STD vector<metric_factor> result(mesh.n_elements());
+
+  parallel_chunks(mesh.n_elements(), n_threads, [&](size_t, const size_t first, const size_t last) {
+    for (size_t n_element = first; n_element < last; ++n_element) {
+      MI symmetric_matrix3d metric;
+
+      for (const size_t n_vertex: mesh.elements[n_element]) {
+        const MI symmetric_matrix3d& vertex = vertex_metrics[n_vertex];
+
+        metric.xx += vertex.xx;
+        metric.xy += vertex.xy;
+        metric.xz += vertex.xz;
+        metric.yy += vertex.yy;
+        metric.yz += vertex.yz;
+        metric.zz += vertex.zz;
+      }
+
+      // Масштаб метрики не влияет на mean ratio, поэтому сумма не делится на число вершин.
+      result[n_element] = factorize_metric(metric);
+    }
+  });
+
+  return result;
+}
+
+// Качество всех элементов сетки в метрике. reference_normal - общая опорная нормаль для плоских сеток, нулевой
+// вектор - нормаль каждого элемента (MI element_normal).
+template<size_t NodesPerElement>
+MI_NODISCARD STD vector<double> evaluate_metric_quality(const flat_mesh<NodesPerElement>& mesh,
+                                                        const STD vector<metric_factor>&  factors,
+                                                        const MI point3d& reference_normal = {0., 0., 0.},
+                                                        const size_t n_threads = MI default_thread_count()) {
+  MI_CHECK(factors.size() == mesh.n_elements());
+
+  STD vector<double> result(mesh.n_elements());
+
+  parallel_chunks(mesh.n_elements(), n_threads, [&](size_t, const size_t first, const size_t last) {
+    for (size_t n_element = first; n_element < last; ++n_element) {
+      const STD array<MI point3d, NodesPerElement> p = internal::gather(mesh, n_element);
+
+      result[n_element] =
+        metric_mean_ratio_quality(p, factors[n_element], internal::select_normal(p, reference_normal));
+    }
+  });
+
+  return result;
+}
+}  // namespace mi
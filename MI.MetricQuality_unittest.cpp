@@ -0,0 +1,145 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cmath>
+
+#include "Mesh/MI.FlatMesh.h"
+#include "Mesh/MI.MetricQuality.h"
+#include "Mesh/MI.QualityGradient.h"
+
+namespace mi::test {
+namespace {
+MI symmetric_matrix3d identity() {
+  MI symmetric_matrix3d result;
+  result.add_diagonal(1.);
+
+  return result;
+}
+
+// Метрика, в которой растяжение по x в stretch раз компенсируется: M = diag(1 / stretch^2, 1, 1).
+MI symmetric_matrix3d stretched_x(const double stretch) {
+  MI symmetric_matrix3d result = identity();
+  result.xx                    = 1. / (stretch * stretch);
+
+  return result;
+}
+}  // namespace
+
+TEST(MetricQuality, FactorizationReproducesMetric) {
+  MI symmetric_matrix3d metric;
+  metric.xx = 4.;
+  metric.xy = 1.;
+  metric.xz = 0.5;
+  metric.yy = 3.;
+  metric.yz = -0.2;
+  metric.zz = 2.;
+
+  const MI metric_factor factor = MI factorize_metric(metric);
+
+  ASSERT_TRUE(factor.is_valid());
+
+  for (const MI point3d& e: {MI point3d{1., 0., 0.}, MI point3d{0.3, -1.2, 2.}, MI point3d{-0.7, 0.1, 0.4}}) {
+    EXPECT_NEAR((factor * e).squared_euclidean_norm(), metric.quadratic_form(e), 1e-14);
+  }
+
+  MI symmetric_matrix3d indefinite = identity();
+  indefinite.xy                    = 2.;
+
+  EXPECT_FALSE(MI factorize_metric(indefinite).is_valid());
+  EXPECT_FALSE(MI factorize_metric(MI symmetric_matrix3d{}).is_valid());
+}
+
+TEST(MetricQuality, IdentityMetricMatchesMeanRatioQuality) {
+  const MI metric_factor factor = MI factorize_metric(identity());
+
+  const STD array<MI point3d, 3> triangle = {
+    MI point3d{0., 0., 0.},
+    MI point3d{2., 0.3, 0.1},
+    MI point3d{0.4, 1.1, -0.2}
+  };
+  const STD array<MI point3d, 4> quad = {
+    MI point3d{0., 0., 0.},
+    MI point3d{2., 0., 0.},
+    MI point3d{1.7, 1.2, 0.},
+    MI point3d{0.1, 0.9, 0.}
+  };
+
+  EXPECT_NEAR(MI metric_mean_ratio_quality(triangle, factor, MI element_normal(triangle)),
+              MI mean_ratio_quality(triangle),
+              1e-15);
+  EXPECT_NEAR(
+    MI metric_mean_ratio_quality(quad, factor, MI element_normal(quad)), MI mean_ratio_quality(quad), 1e-15);
+}
+
+TEST(MetricQuality, StretchedElementIsIdealInMatchingMetric) {
+  const double stretch = 10.;
+
+  // Правильный треугольник и квадрат, растянутые по x.
+  const STD array<MI point3d, 3> triangle = {
+    MI point3d{0., 0., 0.},
+    MI point3d{stretch, 0., 0.},
+    MI point3d{0.5 * stretch, STD sqrt(3.) / 2., 0.}
+  };
+  const STD array<MI point3d, 4> quad = {
+    MI point3d{0., 0., 0.},
+    MI point3d{stretch, 0., 0.},
+    MI point3d{stretch, 1., 0.},
+    MI point3d{0., 1., 0.}
+  };
+
+  const MI metric_factor factor = MI factorize_metric(stretched_x(stretch));
+  const MI point3d       normal = {0., 0., 1.};
+
+  EXPECT_LT(MI mean_ratio_quality(triangle, normal), 0.3);
+  EXPECT_NEAR(MI metric_mean_ratio_quality(triangle, factor, normal), 1., 1e-14);
+  EXPECT_NEAR(MI metric_mean_ratio_quality(quad, factor, normal), 1., 1e-14);
+
+  // Вывернутый элемент недействителен в любой метрике.
+  const STD array<MI point3d, 3> inverted = {triangle[0], triangle[2], triangle[1]};
+
+  EXPECT_EQ(MI metric_mean_ratio_quality(inverted, factor, normal), 0.);
+}
+
+TEST(MetricQuality, EvaluatesMeshWithVertexMetrics) {
+  MI flat_quad_mesh mesh;
+
+  const size_t n = 8;
+
+  for (size_t j = 0; j <= n; ++j) {
+    for (size_t i = 0; i <= n; ++i) {
+      mesh.vertices.push_back({4. * static_cast<double>(i), static_cast<double>(j), 0.});
+    }
+  }
+
+  for (size_t j = 0; j < n; ++j) {
+    for (size_t i = 0; i < n; ++i) {
+      const size_t v00 = j * (n + 1) + i;
+
+      mesh.elements.push_back({v00, v00 + 1, v00 + n + 2, v00 + n + 1});
+    }
+  }
+
+  const STD vector<MI symmetric_matrix3d> vertex_metrics(mesh.n_vertices(), stretched_x(4.));
+
+  for (const size_t n_threads: {1, 3}) {
+    const STD vector<MI metric_factor> factors = MI element_metric_factors(mesh, vertex_metrics, n_threads);
+    const STD vector<double>           quality = MI evaluate_metric_quality(mesh, factors, {0., 0., 1.}, n_threads);
+
+    ASSERT_EQ(quality.size(), mesh.n_elements());
+
+    for (const double value: quality) {
+      EXPECT_NEAR(value, 1., 1e-14);
+    }
+  }
+
+  // Метрики, заданные на элементах, и недействительная метрика.
+  STD vector<MI symmetric_matrix3d> element_metrics(mesh.n_elements(), identity());
+  element_metrics[5] = MI symmetric_matrix3d{};
+
+  const STD vector<double> quality = MI evaluate_metric_quality(mesh, MI element_metric_factors(element_metrics));
+
+  EXPECT_NEAR(quality[0], 2. * 4. / 17., 1e-14);
+  EXPECT_EQ(quality[5], 0.);
+}
+}  // namespace mi::test
@@ -0,0 +1,356 @@
+﻿#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Common/MI.Check.h"
+#include "Common/MI.ParallelFor.h"
+
+#if defined(_WIN32)
+  #ifndef NOMINMAX
+    #define NOMINMAX
+  #endif
+  #include <windows.h>
+#elif defined(__linux__)
+  #include <sys/mman.h>
+  #include <sys/syscall.h>
+  #include <unistd.h>
+#endif
+
+// Размещение массивов сетки по узлам NUMA и большие страницы.
+// ==========================================================
+//
+// Операционная система выделяет физическую страницу на узле NUMA того потока, который первым обратился к ней (first
+// touch). Если координаты вершин, связность и результаты заполняет один поток загрузчика, все страницы оказываются
+// на одном сокете, и потоки параллельного прохода по качеству на другом сокете читают их через межсокетную шину.
+// Кроме того, для массивов в гигабайты не хватает TLB на страницы по 4 КБ.
+//
+// Параллельные проходы по качеству делят элементы на куски MI chunk_bounds(count, n_threads), которые зависят только
+// от count и n_threads. Потоки кусков создаются заново при каждом проходе, поэтому сами по себе они могут оказаться
+// на любом сокете. С привязкой MI thread_affinity::pinned кусок n_chunk всегда выполняется на одном и том же
+// процессоре. Функции ниже обращаются к кускам массива из привязанных потоков, и страницы куска оказываются на узле
+// того процессора, который будет их читать, если проходы тоже выполняются с привязкой:
+//
+// MI set_default_thread_affinity(MI thread_affinity::pinned);
+//
+// - numa_vector<Ty> - вектор с numa_allocator: память берется у системы (mmap / VirtualAlloc) без обращения к ней,
+//   конструктор без аргументов ничего не записывает, поэтому resize не трогает страницы. first_touch_resize задает
+//   размер и заполняет каждый кусок нулями в своем потоке, first_touch_copy копирует обычный вектор в новый
+//   numa_vector по кускам. Столбцы качества после resize можно сразу передать проходу (MI evaluate_quality_metrics
+//   с MI quality_metric_outputs): каждый элемент первым запишет поток его куска;
+// - first_touch_redistribute(STD vector<Ty>&) - для векторов, которые должны остаться STD vector (MI flat_mesh,
+//   см. Mesh/MI.FlatMeshNuma.h): память принадлежит распределителю, поэтому страницы не освобождаются, а переносятся
+//   на узел потока куска системным вызовом move_pages с сохранением содержимого. Работает только в Linux, в остальных
+//   системах ничего не делает и возвращает false.
+//
+// page_policy задает размер страниц: transparent_huge - просьба к ядру собрать большие страницы (madvise
+// MADV_HUGEPAGE), explicit_huge - явные большие страницы (MAP_HUGETLB, MEM_LARGE_PAGES) с откатом на обычные, если
+// они не зарезервированы в системе.
+//
+// Разбиение по вершинам совпадает с разбиением по элементам только приближенно, поэтому сетку стоит предварительно
+// упорядочить (MI reorder): тогда вершины куска элементов в основном лежат в том же куске вершин.
+namespace mi {
+enum class page_policy {
+  normal,
+  transparent_huge,
+  explicit_huge,
+};
+
+namespace internal {
+MI_NODISCARD inline size_t system_page_size() noexcept {
+#if defined(_WIN32)
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+
+  return static_cast<size_t>(info.dwPageSize);
+#elif defined(__linux__)
+  return static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+#else
+  return 4096;
+#endif
+}
+
+// Размер большой страницы x86-64 и AArch64 с 4 КБ страницами.
+constexpr size_t huge_page_size = size_t{2} << 20;
+
+// Размер отображения: для больших страниц кратен huge_page_size, чтобы освобождение не зависело от того, удалось ли
+// получить явные большие страницы.
+MI_NODISCARD inline size_t mapping_size(const size_t n_bytes, const page_policy policy) noexcept {
+  const size_t page = policy == page_policy::normal ? system_page_size() : huge_page_size;
+
+  return (n_bytes + page - 1) / page * page;
+}
+
+MI_NODISCARD inline void* map_pages(const size_t n_bytes, const page_policy policy) {
+  const size_t size = mapping_size(n_bytes, policy);
+
+#if defined(_WIN32)
+  void* result = nullptr;
+
+  if (policy == page_policy::explicit_huge) {
+    result = VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+  }
+
+  if (result == nullptr) {
+    result = VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+  }
+
+  MI_CHECK(result != nullptr);
+
+  return result;
+#elif defined(__linux__)
+  void* result = MAP_FAILED;
+
+  #if defined(MAP_HUGETLB)
+  if (policy == page_policy::explicit_huge) {
+    result = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+  }
+  #endif
+
+  if (result == MAP_FAILED) {
+    result = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+    MI_CHECK(result != MAP_FAILED);
+
+  #if defined(MADV_HUGEPAGE)
+    if (policy != page_policy::normal) {
+      ::madvise(result, size, MADV_HUGEPAGE);
+    }
+  #endif
+  }
+
+  return result;
+#else
+  static_cast<void>(policy);
+
+  return ::operator new(size);
+#endif
+}
+
+inline void unmap_pages(void* const data, const size_t n_bytes, const page_policy policy) noexcept {
+#if defined(_WIN32)
+  static_cast<void>(n_bytes);
+  static_cast<void>(policy);
+
+  VirtualFree(data, 0, MEM_RELEASE);
+#elif defined(__linux__)
+  ::munmap(data, mapping_size(n_bytes, policy));
+#else
+  static_cast<void>(n_bytes);
+  static_cast<void>(policy);
+
+  ::operator delete(data);
+#endif
+}
+}  // namespace internal
+
+template<class Ty>
+class numa_allocator {
+  public:
+    using value_type = Ty;
+
+    template<class Other>
+    struct rebind {
+        using other = numa_allocator<Other>;
+    };
+
+  public:
+    numa_allocator() noexcept = default;
+
+    explicit numa_allocator(const page_policy policy) noexcept
+        : _policy(policy) {
+    }
+
+    template<class Other>
+    numa_allocator(const numa_allocator<Other>& other) noexcept
+        : _policy(other.policy()) {
+    }
+
+  public:
+    MI_NODISCARD Ty* allocate(const size_t count) {
+      static_assert(alignof(Ty) <= alignof(STD max_align_t), "numa_allocator: over-aligned types are not supported");
+
+      return static_cast<Ty*>(internal::map_pages(count * sizeof(Ty), _policy));
+    }
+
+    void deallocate(Ty* const data, const size_t count) noexcept {
+      internal::unmap_pages(data, count * sizeof(Ty), _policy);
+    }
+
+    // Без аргументов - инициализация по умолчанию: для тривиальных типов ничего не записывается и страницы
+    // остаются нетронутыми.
+    template<class Other>
+    void construct(Other* const data) noexcept(STD is_nothrow_default_constructible_v<Other>) {
+      ::new (static_cast<void*>(data)) Other;
+    }
+
+    template<class Other, class... Args>
+    void construct(Other* const data, Args&&... args) {
+      ::new (static_cast<void*>(data)) Other(STD forward<Args>(args)...);
+    }
+
+    MI_NODISCARD page_policy policy() const noexcept {
+      return _policy;
+    }
+
+    template<class Other>
+    MI_NODISCARD bool operator==(const numa_allocator<Other>& other) const noexcept {
+      return _policy == other.policy();
+    }
+
+    template<class Other>
+    MI_NODISCARD bool operator!=(const numa_allocator<Other>& other) const noexcept {
+      return !(*this == other);
+    }
+
+  private:
+    page_policy _policy = page_policy::normal;
+};
+
+template<class Ty>
+using numa_vector = STD vector<Ty, numa_allocator<Ty>>;
+
+// Задает размер count, каждый кусок MI chunk_bounds(count, n_threads) обнуляется своим привязанным потоком. Прежнее
+// содержимое не сохраняется.
+template<class Ty>
+void first_touch_resize(numa_vector<Ty>& values, const size_t count, const size_t n_threads) {
+  static_assert(STD is_trivially_default_constructible_v<Ty> && STD is_trivially_copyable_v<Ty>,
+                "first_touch_resize: only trivial types are supported");
+
+  // Новое отображение: страницы прежнего буфера уже могли быть тронуты.
+  numa_vector<Ty> result(values.get_allocator());
+  result.resize(count);
+
+  parallel_chunks(
+    count,
+    n_threads,
+    [&result](size_t, const size_t first, const size_t last) {
+      if (first < last) {
+        STD memset(static_cast<void*>(result.data() + first), 0, (last - first) * sizeof(Ty));
+      }
+    },
+    thread_affinity::pinned);
+
+  values = STD move(result);
+}
+
+// Копия values в новом буфере numa_vector, каждый кусок MI chunk_bounds(size, n_threads) копируется своим привязанным
+// потоком.
+template<class Ty>
+MI_NODISCARD numa_vector<Ty> first_touch_copy(const STD vector<Ty>& values,
+                                              const size_t          n_threads,
+                                              const page_policy     policy = page_policy::normal) {
+  static_assert(STD is_trivially_default_constructible_v<Ty> && STD is_trivially_copyable_v<Ty>,
+                "first_touch_copy: only trivial types are supported");
+
+  numa_vector<Ty> result{numa_allocator<Ty>(policy)};
+  result.resize(values.size());
+
+  parallel_chunks(
+    values.size(),
+    n_threads,
+    [&](size_t, const size_t first, const size_t last) {
+      if (first < last) {
+        STD memcpy(static_cast<void*>(result.data() + first),
+                   static_cast<const void*>(values.data() + first),
+                   (last - first) * sizeof(Ty));
+      }
+    },
+    thread_affinity::pinned);
+
+  return result;
+}
+
+// Переносит страницы заполненного вектора на узлы NUMA: страницы куска MI chunk_bounds(size, n_threads) - на узел
+// процессора, к которому привязан поток куска. Содержимое и адреса не меняются. Страницы, которые вектор делит
+// с другими данными (начало и конец буфера), остаются на месте, страницы, которые ядро отказалось перенести, тоже.
+// Возвращает false, если перенос не поддерживается.
+template<class Ty>
+bool first_touch_redistribute(STD vector<Ty>&   values,
+                              const size_t      n_threads,
+                              const page_policy policy = page_policy::normal) {
+#if defined(__linux__) && defined(SYS_move_pages) && defined(SYS_getcpu)
+  // MPOL_MF_MOVE из <numaif.h>: переносить только страницы, которые принадлежат только этому процессу.
+  constexpr int move_own_pages = 1 << 1;
+  // Страниц за один системный вызов.
+  constexpr size_t n_batch_pages = 1024;
+
+  const size_t n_bytes = values.size() * sizeof(Ty);
+  const size_t page    = internal::system_page_size();
+
+  const STD uintptr_t data  = reinterpret_cast<STD uintptr_t>(values.data());
+  const STD uintptr_t first = (data + page - 1) / page * page;
+  const STD uintptr_t last  = (data + n_bytes) / page * page;
+
+  if (values.empty() || !(first < last)) {
+    return true;
+  }
+
+  #if defined(MADV_HUGEPAGE)
+  if (policy != page_policy::normal) {
+    ::madvise(reinterpret_cast<void*>(first), static_cast<size_t>(last - first), MADV_HUGEPAGE);
+  }
+  #else
+  static_cast<void>(policy);
+  #endif
+
+  STD atomic<bool> is_supported{true};
+
+  parallel_chunks(
+    values.size(),
+    n_threads,
+    [&](size_t, const size_t first_value, const size_t last_value) {
+      // Только страницы, которые целиком лежат внутри куска: граничную страницу читают два куска.
+      const STD uintptr_t chunk_first = STD max(first, (data + first_value * sizeof(Ty) + page - 1) / page * page);
+      const STD uintptr_t chunk_last  = STD min(last, (data + last_value * sizeof(Ty)) / page * page);
+
+      unsigned cpu  = 0;
+      unsigned node = 0;
+
+      if (!(chunk_first < chunk_last) || ::syscall(SYS_getcpu, &cpu, &node, nullptr) != 0) {
+        return;
+      }
+
+      STD vector<void*> pages;
+      pages.reserve(n_batch_pages);
+
+      for (STD uintptr_t batch = chunk_first; batch < chunk_last; batch += n_batch_pages * page) {
+        pages.clear();
+
+        for (STD uintptr_t address = batch; address < chunk_last && pages.size() < n_batch_pages; address += page) {
+          pages.push_back(reinterpret_cast<void*>(address));
+        }
+
+        const STD vector<int> nodes(pages.size(), static_cast<int>(node));
+        STD vector<int>       status(pages.size(), 0);
+
+        const long result =
+          ::syscall(SYS_move_pages, 0, pages.size(), pages.data(), nodes.data(), status.data(), move_own_pages);
+
+        if (result < 0) {
+          is_supported.store(false, STD memory_order_relaxed);
+
+          return;
+        }
+      }
+    },
+    thread_affinity::pinned);
+
+  return is_supported.load(STD memory_order_relaxed);
+#else
+  static_cast<void>(values);
+  static_cast<void>(n_threads);
+  static_cast<void>(policy);
+
+  return false;
+#endif
+}
+}  // namespace mi
@@ -0,0 +1,181 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <numeric>
+#include <vector>
+
+#if defined(__linux__)
+  #include <sched.h>
+  #include <sys/mman.h>
+  #include <unistd.h>
+#endif
+
+#include "Common/MI.NumaAllocator.h"
+#include "Common/MI.ParallelFor.h"
+#include "Mesh/MI.FlatMeshNuma.h"
+#include "Mesh/MI.MeshTestUtil.h"
+#include "Mesh/MI.QualityGradient.h"
+#include "Mesh/MI.QualityMetrics.h"
+
+namespace mi::test {
+#if defined(__linux__)
+namespace {
+// Количество страниц [data; data + n_bytes), которые уже есть в памяти. data выровнен по странице.
+size_t n_resident_pages(const void* const data, const size_t n_bytes) {
+  const size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+
+  STD vector<unsigned char> status((n_bytes + page - 1) / page, 0);
+
+  if (::mincore(const_cast<void*>(data), n_bytes, status.data()) != 0) {
+    return 0;
+  }
+
+  return static_cast<size_t>(STD count_if(status.begin(), status.end(), [](const unsigned char value) {
+    return (value & 1) != 0;
+  }));
+}
+}  // namespace
+#endif
+
+TEST(NumaAllocator, VectorWithEveryPagePolicy) {
+  for (const MI page_policy policy:
+       {MI page_policy::normal, MI page_policy::transparent_huge, MI page_policy::explicit_huge}) {
+    MI numa_vector<size_t> values{MI numa_allocator<size_t>(policy)};
+
+    for (size_t i = 0; i < 100'000; ++i) {
+      values.push_back(i);
+    }
+
+    EXPECT_EQ(values.get_allocator().policy(), policy);
+    EXPECT_EQ(STD accumulate(values.begin(), values.end(), size_t{0}), size_t{99'999} * 100'000 / 2);
+
+    MI numa_vector<size_t> copy = values;
+
+    EXPECT_EQ(copy, values);
+  }
+}
+
+TEST(NumaAllocator, FirstTouchResizeZeroesEveryChunk) {
+  MI numa_vector<double> values(10, 1.);
+
+  for (const size_t n_threads: {1, 3, 8}) {
+    MI first_touch_resize(values, 1'000'003, n_threads);
+
+    ASSERT_EQ(values.size(), 1'000'003);
+    EXPECT_EQ(STD count(values.begin(), values.end(), 0.), 1'000'003);
+  }
+
+  using element_type = STD array<size_t, 4>;
+
+  MI numa_vector<element_type> elements{MI numa_allocator<element_type>(MI page_policy::transparent_huge)};
+  MI first_touch_resize(elements, 5, 8);
+
+  EXPECT_THAT(elements, testing::Each(element_type{}));
+}
+
+TEST(NumaAllocator, FirstTouchCopy) {
+  for (const size_t size: {0, 1, 1000, 3'000'017}) {
+    STD vector<double> values(size);
+    STD iota(values.begin(), values.end(), 0.5);
+
+    const MI numa_vector<double> copy = MI first_touch_copy(values, 4, MI page_policy::transparent_huge);
+
+    EXPECT_EQ(copy.get_allocator().policy(), MI page_policy::transparent_huge);
+    EXPECT_TRUE(STD equal(copy.begin(), copy.end(), values.begin(), values.end()));
+  }
+}
+
+#if defined(__linux__)
+TEST(NumaAllocator, PinnedChunksRunOnTheSameCpu) {
+  const STD vector<int> cpus = MI internal::allowed_cpus();
+
+  ASSERT_FALSE(cpus.empty());
+
+  const size_t n_threads = 5;
+
+  for (size_t n_pass = 0; n_pass < 3; ++n_pass) {
+    STD vector<int> chunk_cpus(n_threads, -1);
+
+    MI parallel_chunks(
+      n_threads,
+      n_threads,
+      [&](const size_t n_chunk, size_t, size_t) {
+        chunk_cpus[n_chunk] = ::sched_getcpu();
+      },
+      MI thread_affinity::pinned);
+
+    for (size_t n_chunk = 0; n_chunk < n_threads; ++n_chunk) {
+      EXPECT_EQ(chunk_cpus[n_chunk], cpus[n_chunk % cpus.size()]);
+    }
+  }
+
+  // Привязка вызывающего потока восстановлена.
+  EXPECT_EQ(MI internal::allowed_cpus(), cpus);
+}
+#endif
+
+TEST(NumaAllocator, FirstTouchRedistributeKeepsValues) {
+  for (const size_t size: {0, 1, 1000, 3'000'017}) {
+    STD vector<double> values(size);
+    STD iota(values.begin(), values.end(), 0.5);
+
+    const STD vector<double> expected = values;
+
+    for (const MI page_policy policy: {MI page_policy::normal, MI page_policy::transparent_huge}) {
+      MI first_touch_redistribute(values, 4, policy);
+
+      EXPECT_EQ(values, expected);
+    }
+  }
+}
+
+TEST(NumaAllocator, FirstTouchRedistributeMesh) {
+  grid_options options;
+  options.step_y = 1.5;
+
+  MI flat_quad_mesh mesh = make_grid(300, options);
+
+  const MI flat_quad_mesh expected = mesh;
+
+  MI first_touch_redistribute(mesh, 4);
+
+  ASSERT_EQ(mesh.elements, expected.elements);
+
+  for (size_t n_vertex = 0; n_vertex < mesh.n_vertices(); ++n_vertex) {
+    EXPECT_EQ(mesh.vertices[n_vertex].x(), expected.vertices[n_vertex].x());
+    EXPECT_EQ(mesh.vertices[n_vertex].y(), expected.vertices[n_vertex].y());
+  }
+}
+
+#if defined(__linux__)
+TEST(NumaAllocator, QualityOutputIsFirstTouchedByTheScan) {
+  grid_options options;
+  options.step_y = 1.5;
+
+  const MI flat_quad_mesh mesh = make_grid(300, options);
+
+  MI numa_vector<double> mean_ratio;
+  mean_ratio.resize(mesh.n_elements());
+
+  const size_t page    = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+  const size_t n_bytes = mean_ratio.size() * sizeof(double);
+
+  // resize не обращается к страницам, первыми их пишут потоки кусков прохода.
+  EXPECT_EQ(n_resident_pages(mean_ratio.data(), n_bytes), 0);
+
+  MI quality_metric_outputs output;
+  output.mean_ratio = mean_ratio.data();
+
+  MI evaluate_quality_metrics(mesh, output, {0., 0., 1.}, 4);
+
+  EXPECT_EQ(n_resident_pages(mean_ratio.data(), n_bytes), (n_bytes + page - 1) / page);
+
+  const STD vector<double> expected =
+    MI evaluate_quality_metrics(mesh, MI quality_metric::mean_ratio, {0., 0., 1.}, 1).mean_ratio;
+
+  EXPECT_TRUE(STD equal(mean_ratio.begin(), mean_ratio.end(), expected.begin(), expected.end()));
+}
+#endif
+}  // namespace mi::test
@@ -0,0 +1,174 @@
+﻿#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "Common/MI.Check.h"
+
+#if defined(__linux__)
+  #include <pthread.h>
+  #include <sched.h>
+#endif
+
+namespace mi {
+// Количество потоков, которое параллельные алгоритмы используют по умолчанию.
+MI_NODISCARD inline size_t default_thread_count() {
+  const unsigned int n_threads = STD thread::hardware_concurrency();
+
+  return n_threads == 0 ? size_t{1} : static_cast<size_t>(n_threads);
+}
+
+// Границы [first; last) куска с номером n_chunk при разбиении [0; count) на n_chunks непрерывных кусков.
+//
+// Разбиение зависит только от count и n_chunks. Несколько проходов с одинаковыми параметрами обрабатывают
+// в каждом куске одни и те же индексы, на этом построены многопроходные алгоритмы (radix sort и т.п.).
+MI_NODISCARD inline STD pair<size_t, size_t> chunk_bounds(const size_t count,
+                                                         const size_t n_chunks,
+                                                         const size_t n_chunk) {
+  MI_DCHECK(n_chunks > 0 && n_chunk < n_chunks);
+
+  const size_t base      = count / n_chunks;
+  const size_t remainder = count % n_chunks;
+  const size_t first     = n_chunk * base + STD min(n_chunk, remainder);
+  const size_t last      = first + base + (n_chunk < remainder ? 1 : 0);
+
+  return {first, last};
+}
+
+// Привязка потоков кусков к процессорам.
+//
+// any    - потоки кусков создаются заново при каждом вызове, планировщик ставит их на любой процессор;
+// pinned - кусок n_chunk выполняется на n_chunk-м (по модулю их количества) процессоре из разрешенных вызывающему
+//          потоку. Пока набор разрешенных процессоров не меняется, кусок с тем же номером во всех проходах
+//          выполняется на том же процессоре и, значит, на том же узле NUMA - на этом построено размещение страниц
+//          (MI first_touch_resize). Привязка вызывающего потока на время нулевого куска восстанавливается.
+//          Поддерживается только в Linux, в остальных системах равносильно any.
+enum class thread_affinity {
+  any,
+  pinned,
+};
+
+namespace internal {
+MI_NODISCARD inline STD atomic<thread_affinity>& default_thread_affinity_storage() noexcept {
+  static STD atomic<thread_affinity> affinity{thread_affinity::any};
+
+  return affinity;
+}
+
+#if defined(__linux__)
+// Привязка вызывающего потока на время жизни объекта: кусок n_chunk на процессор cpus[n_chunk % cpus.size()].
+class chunk_pin {
+  public:
+    chunk_pin(const STD vector<int>& cpus, const size_t n_chunk) noexcept {
+      if (cpus.empty()) {
+        return;
+      }
+
+      _is_restored = ::pthread_getaffinity_np(::pthread_self(), sizeof(_previous), &_previous) == 0;
+
+      cpu_set_t set;
+      CPU_ZERO(&set);
+      CPU_SET(cpus[n_chunk % cpus.size()], &set);
+
+      ::pthread_setaffinity_np(::pthread_self(), sizeof(set), &set);
+    }
+
+    chunk_pin(const chunk_pin&)            = delete;
+    chunk_pin& operator=(const chunk_pin&) = delete;
+
+    ~chunk_pin() {
+      if (_is_restored) {
+        ::pthread_setaffinity_np(::pthread_self(), sizeof(_previous), &_previous);
+      }
+    }
+
+  private:
+    cpu_set_t _previous;             // Привязка до вызова
+    bool      _is_restored = false;  // Привязку нужно восстановить
+};
+
+// Процессоры, разрешенные вызывающему потоку, по возрастанию номеров.
+MI_NODISCARD inline STD vector<int> allowed_cpus() {
+  cpu_set_t set;
+  CPU_ZERO(&set);
+
+  STD vector<int> result;
+
+  if (::pthread_getaffinity_np(::pthread_self(), sizeof(set), &set) == 0) {
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+      if (CPU_ISSET(cpu, &set)) {
+        result.push_back(cpu);
+      }
+    }
+  }
+
+  return result;
+}
+#else
+struct chunk_pin {
+    chunk_pin(const STD vector<int>&, size_t) noexcept {
+    }
+};
+
+MI_NODISCARD inline STD vector<int> allowed_cpus() {
+  return {};
+}
+#endif
+}  // namespace internal
+
+// Привязка, которую parallel_chunks использует по умолчанию, а с ней и все параллельные проходы по сетке. Для
+// размещения данных по узлам NUMA (MI first_touch_resize) проходы должны выполняться с pinned.
+MI_NODISCARD inline thread_affinity default_thread_affinity() noexcept {
+  return internal::default_thread_affinity_storage().load(STD memory_order_relaxed);
+}
+
+inline void set_default_thread_affinity(const thread_affinity affinity) noexcept {
+  internal::default_thread_affinity_storage().store(affinity, STD memory_order_relaxed);
+}
+
+// Вызывает fn(n_chunk, first, last) для каждого из n_threads кусков [0; count) в отдельном потоке.
+// Нулевой кусок обрабатывается в вызывающем потоке, функция возвращается после завершения всех кусков.
+template<class Fn>
+void parallel_chunks(const size_t          count,
+                     size_t                n_threads,
+                     Fn&&                  fn,
+                     const thread_affinity affinity = MI default_thread_affinity()) {
+  n_threads = STD max(n_threads, size_t{1});
+
+  const STD vector<int> cpus = affinity == thread_affinity::pinned ? internal::allowed_cpus() : STD vector<int>{};
+
+  if (n_threads == 1) {
+    const internal::chunk_pin pin(cpus, 0);
+
+    fn(size_t{0}, size_t{0}, count);
+
+    return;
+  }
+
+  STD vector<STD thread> threads;
+  threads.reserve(n_threads - 1);
+
+  for (size_t n_chunk = 1; n_chunk < n_threads; ++n_chunk) {
+    threads.emplace_back([&fn, &cpus, count, n_threads, n_chunk]() {
+      const internal::chunk_pin pin(cpus, n_chunk);
+
+      const auto [first, last] = chunk_bounds(count, n_threads, n_chunk);
+      fn(n_chunk, first, last);
+    });
+  }
+
+  {
+    const internal::chunk_pin pin(cpus, 0);
+
+    const auto [first, last] = chunk_bounds(count, n_threads, 0);
+    fn(size_t{0}, first, last);
+  }
+
+  for (auto& thread: threads) {
+    thread.join();
+  }
+}
+}  // namespace mi
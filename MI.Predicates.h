@@ -0,0 +1,277 @@
+﻿#pragma once
+
+#include <array>
+#include <cmath>
+#include <limits>
+
+#include "Common/MI.Check.h"
+#include "Container/MI.Matrix.h"
+
+// Точные геометрические предикаты ориентации.
+// ==========================================
+//
+// orient2d(a, b, c)     = det | a - c, b - c |           > 0, если a, b, c обходятся против часовой стрелки,
+// orient3d(a, b, c, d)  = det | a - d, b - d, c - d |    > 0, если d лежит под плоскостью (a, b, c), обход которой
+//                                                          виден сверху против часовой стрелки,
+// orient_along(a, b, c, n) = ((b - a) x (c - a)) · n     > 0, если нормаль треугольника (a, b, c) направлена в
+//                                                          полупространство n.
+//
+// Знак результата всегда точный (0 - точно вырожденный случай), величина - приближение определителя.
+//
+// Сначала определитель считается в double и сравнивается с априорной оценкой ошибки округления (Shewchuk,
+// "Adaptive Precision Floating-Point Arithmetic and Fast Robust Geometric Predicates"): если модуль больше оценки,
+// знак верен. Для почти вырожденных входов определитель пересчитывается точно в виде разложения (expansion) - суммы
+// неперекрывающихся double без округления. Для подавляющего большинства элементов точная ветка не выполняется,
+// и предикат стоит немногим дороже обычного определителя.
+namespace mi {
+namespace internal {
+// Разложение: сумма components[0] + ... + components[size - 1] без округления, компоненты по возрастанию модуля,
+// нулевые компоненты не хранятся. Емкости хватает для определителя 3 x 3 из точных разностей (не больше 192
+// компонент, как в orient3dexact у Shewchuk).
+class expansion {
+  public:
+    static constexpr size_t capacity = 192;
+
+  public:
+    expansion() = default;
+
+    explicit expansion(const double value) {
+      if (value != 0.) {
+        _components[_size++] = value;
+      }
+    }
+
+    // Точная разность a - b.
+    MI_NODISCARD static expansion difference(const double a, const double b) {
+      const double x = a - b;
+
+      expansion result;
+      result.append(two_sum_tail(a, -b, x));
+      result.append(x);
+
+      return result;
+    }
+
+  public:
+    // Знак суммы - знак компоненты с наибольшим модулем.
+    MI_NODISCARD double estimate() const noexcept {
+      return _size == 0 ? 0. : _components[_size - 1];
+    }
+
+    MI_NODISCARD expansion operator+(const expansion& other) const {
+      expansion result = *this;
+
+      for (size_t i = 0; i < other._size; ++i) {
+        result.grow(other._components[i]);
+      }
+
+      return result;
+    }
+
+    MI_NODISCARD expansion operator-(const expansion& other) const {
+      return *this + other * -1.;
+    }
+
+    MI_NODISCARD expansion operator*(const double scale) const {
+      expansion result;
+
+      for (size_t i = 0; i < _size; ++i) {
+        const double product = _components[i] * scale;
+
+        result.grow(STD fma(_components[i], scale, -product));
+        result.grow(product);
+      }
+
+      return result;
+    }
+
+    MI_NODISCARD expansion operator*(const expansion& other) const {
+      expansion result;
+
+      for (size_t i = 0; i < other._size; ++i) {
+        result = result + *this * other._components[i];
+      }
+
+      return result;
+    }
+
+  private:
+    // Хвост точной суммы: a + b = x + tail, x = fl(a + b).
+    MI_NODISCARD static double two_sum_tail(const double a, const double b, const double x) noexcept {
+      const double b_virtual = x - a;
+      const double a_virtual = x - b_virtual;
+
+      return (a - a_virtual) + (b - b_virtual);
+    }
+
+    void append(const double value) {
+      if (value != 0.) {
+        MI_CHECK(_size < capacity);
+        _components[_size++] = value;
+      }
+    }
+
+    // this += value (Grow-Expansion), порядок и неперекрываемость компонент сохраняются.
+    void grow(double value) {
+      size_t size = 0;
+
+      for (size_t i = 0; i < _size; ++i) {
+        const double sum  = value + _components[i];
+        const double tail = two_sum_tail(value, _components[i], sum);
+
+        value = sum;
+
+        if (tail != 0.) {
+          _components[size++] = tail;
+        }
+      }
+
+      _size = size;
+      append(value);
+    }
+
+  private:
+    STD array<double, capacity> _components;
+    size_t                      _size = 0;
+};
+
+// Оценки относительной ошибки фильтра (Shewchuk): ccwerrboundA и o3derrboundA.
+constexpr double predicate_epsilon    = STD numeric_limits<double>::epsilon() / 2.;
+constexpr double orient2d_error_bound = (3. + 16. * predicate_epsilon) * predicate_epsilon;
+constexpr double orient3d_error_bound = (7. + 56. * predicate_epsilon) * predicate_epsilon;
+
+MI_NODISCARD inline double orient2d_exact(const double ax,
+                                          const double ay,
+                                          const double bx,
+                                          const double by,
+                                          const double cx,
+                                          const double cy) {
+  const expansion acx = expansion::difference(ax, cx);
+  const expansion acy = expansion::difference(ay, cy);
+  const expansion bcx = expansion::difference(bx, cx);
+  const expansion bcy = expansion::difference(by, cy);
+
+  return (acx * bcy - acy * bcx).estimate();
+}
+
+// det | u, v, w | для строк из точных разностей.
+MI_NODISCARD inline double determinant3_exact(const STD array<expansion, 3>& u,
+                                              const STD array<expansion, 3>& v,
+                                              const STD array<expansion, 3>& w) {
+  return (u[0] * (v[1] * w[2] - v[2] * w[1]) +  //
+          u[1] * (v[2] * w[0] - v[0] * w[2]) +  //
+          u[2] * (v[0] * w[1] - v[1] * w[0]))
+    .estimate();
+}
+
+// Фильтр для определителя из трех пар произведений: det = z0 * (p0 - q0) + z1 * (p1 - q1) + z2 * (p2 - q2).
+MI_NODISCARD inline bool is_certain(const double det, const double permanent) noexcept {
+  return STD abs(det) > orient3d_error_bound * permanent;
+}
+}  // namespace internal
+
+MI_NODISCARD inline double orient2d(const double ax,
+                                    const double ay,
+                                    const double bx,
+                                    const double by,
+                                    const double cx,
+                                    const double cy) {
+  const double left  = (ax - cx) * (by - cy);
+  const double right = (ay - cy) * (bx - cx);
+  const double det   = left - right;
+
+  // Слагаемые разных знаков: вычитание не теряет точности.
+  if ((left > 0. && right <= 0.) || (left < 0. && right >= 0.) || left == 0.) {
+    return det;
+  }
+
+  if (STD abs(det) >= internal::orient2d_error_bound * STD abs(left + right)) {
+    return det;
+  }
+
+  return internal::orient2d_exact(ax, ay, bx, by, cx, cy);
+}
+
+MI_NODISCARD inline double orient3d(const MI point3d& a,
+                                    const MI point3d& b,
+                                    const MI point3d& c,
+                                    const MI point3d& d) {
+  const MI point3d ad = a - d;
+  const MI point3d bd = b - d;
+  const MI point3d cd = c - d;
+
+  const double bdx_cdy = bd.x() * cd.y();
+  const double cdx_bdy = cd.x() * bd.y();
+  const double cdx_ady = cd.x() * ad.y();
+  const double adx_cdy = ad.x() * cd.y();
+  const double adx_bdy = ad.x() * bd.y();
+  const double bdx_ady = bd.x() * ad.y();
+
+  const double det = ad.z() * (bdx_cdy - cdx_bdy) + bd.z() * (cdx_ady - adx_cdy) + cd.z() * (adx_bdy - bdx_ady);
+  const double permanent = (STD abs(bdx_cdy) + STD abs(cdx_bdy)) * STD abs(ad.z()) +
+                           (STD abs(cdx_ady) + STD abs(adx_cdy)) * STD abs(bd.z()) +
+                           (STD abs(adx_bdy) + STD abs(bdx_ady)) * STD abs(cd.z());
+
+  if (internal::is_certain(det, permanent)) {
+    return det;
+  }
+
+  using internal::expansion;
+
+  const STD array<expansion, 3> u = {expansion::difference(a.x(), d.x()),
+                                     expansion::difference(a.y(), d.y()),
+                                     expansion::difference(a.z(), d.z())};
+  const STD array<expansion, 3> v = {expansion::difference(b.x(), d.x()),
+                                     expansion::difference(b.y(), d.y()),
+                                     expansion::difference(b.z(), d.z())};
+  const STD array<expansion, 3> w = {expansion::difference(c.x(), d.x()),
+                                     expansion::difference(c.y(), d.y()),
+                                     expansion::difference(c.z(), d.z())};
+
+  return internal::determinant3_exact(u, v, w);
+}
+
+MI_NODISCARD inline double orient_along(const MI point3d& a,
+                                        const MI point3d& b,
+                                        const MI point3d& c,
+                                        const MI point3d& n) {
+  const MI point3d ba = b - a;
+  const MI point3d ca = c - a;
+
+  const double bay_caz = ba.y() * ca.z();
+  const double baz_cay = ba.z() * ca.y();
+  const double baz_cax = ba.z() * ca.x();
+  const double bax_caz = ba.x() * ca.z();
+  const double bax_cay = ba.x() * ca.y();
+  const double bay_cax = ba.y() * ca.x();
+
+  const double det = n.x() * (bay_caz - baz_cay) + n.y() * (baz_cax - bax_caz) + n.z() * (bax_cay - bay_cax);
+  const double permanent = (STD abs(bay_caz) + STD abs(baz_cay)) * STD abs(n.x()) +
+                           (STD abs(baz_cax) + STD abs(bax_caz)) * STD abs(n.y()) +
+                           (STD abs(bax_cay) + STD abs(bay_cax)) * STD abs(n.z());
+
+  if (internal::is_certain(det, permanent)) {
+    return det;
+  }
+
+  using internal::expansion;
+
+  const STD array<expansion, 3> u = {expansion(n.x()), expansion(n.y()), expansion(n.z())};
+  const STD array<expansion, 3> v = {expansion::difference(b.x(), a.x()),
+                                     expansion::difference(b.y(), a.y()),
+                                     expansion::difference(b.z(), a.z())};
+  const STD array<expansion, 3> w = {expansion::difference(c.x(), a.x()),
+                                     expansion::difference(c.y(), a.y()),
+                                     expansion::difference(c.z(), a.z())};
+
+  // n · (v x w) = det | n, v, w |.
+  return internal::determinant3_exact(u, v, w);
+}
+
+// Точки лежат на одной прямой (в точности): все три проекции (b - a) x (c - a) на координатные плоскости нулевые.
+MI_NODISCARD inline bool is_collinear(const MI point3d& a, const MI point3d& b, const MI point3d& c) {
+  return orient2d(a.x(), a.y(), b.x(), b.y(), c.x(), c.y()) == 0. &&
+         orient2d(a.y(), a.z(), b.y(), b.z(), c.y(), c.z()) == 0. &&
+         orient2d(a.z(), a.x(), b.z(), b.x(), c.z(), c.x()) == 0.;
+}
+}  // namespace mi
@@ -0,0 +1,125 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "Common/MI.Predicates.h"
+
+namespace mi::test {
+namespace {
+MI_NODISCARD int sign(const double value) {
+  return (value > 0.) - (value < 0.);
+}
+
+#if defined(__SIZEOF_INT128__)
+// Точный знак (a - c) x (b - c) для точек с координатами вида integer / scale, |integer| < 2^60: произведения
+// разностей помещаются в 128-битное целое.
+MI_NODISCARD int exact_orient2d(const double ax,
+                                const double ay,
+                                const double bx,
+                                const double by,
+                                const double cx,
+                                const double cy,
+                                const double scale) {
+  const auto to_integer = [scale](const double value) {
+    return static_cast<__int128>(STD llround(value * scale));
+  };
+
+  const __int128 det = (to_integer(ax) - to_integer(cx)) * (to_integer(by) - to_integer(cy)) -
+                       (to_integer(ay) - to_integer(cy)) * (to_integer(bx) - to_integer(cx));
+
+  return (det > 0) - (det < 0);
+}
+#endif
+}  // namespace
+
+#if defined(__SIZEOF_INT128__)
+TEST(Predicates, Orient2dSignIsExactNearCollinearPoints) {
+  // Kettner et al., "Classroom examples of robustness problems in geometric computations": точки сетки 256 x 256
+  // с шагом 1 ulp вокруг p = (0.5, 0.5) почти лежат на прямой (q, r). Обычный определитель ошибается в знаке
+  // для заметной части сетки.
+  const double qx = 12., qy = 12.;
+  const double rx = 24., ry = 24.;
+  const double step = STD ldexp(1., -53);
+
+  size_t n_wrong = 0;
+
+  for (int i = 0; i < 256; ++i) {
+    for (int j = 0; j < 256; ++j) {
+      const double px = 0.5 + i * step;
+      const double py = 0.5 + j * step;
+
+      const int expected = exact_orient2d(px, py, qx, qy, rx, ry, 1. / step);
+
+      n_wrong += sign(MI orient2d(px, py, qx, qy, rx, ry)) != expected;
+    }
+  }
+
+  EXPECT_EQ(n_wrong, 0);
+}
+#endif
+
+TEST(Predicates, Orient2dIsAntisymmetric) {
+  // a и c лежат на прямой y = x, b - на одно представимое число выше нее: тройка (a, b, c) обходится по часовой
+  // стрелке.
+  const double ax = 0.1, ay = 0.1;
+  const double bx = 0.3, by = STD nextafter(0.3, 1.);
+  const double cx = 0.7, cy = 0.7;
+
+  const int abc = sign(MI orient2d(ax, ay, bx, by, cx, cy));
+
+  ASSERT_NE(abc, 0);
+  EXPECT_EQ(abc, -1);
+
+  EXPECT_EQ(sign(MI orient2d(bx, by, cx, cy, ax, ay)), abc);
+  EXPECT_EQ(sign(MI orient2d(cx, cy, ax, ay, bx, by)), abc);
+  EXPECT_EQ(sign(MI orient2d(bx, by, ax, ay, cx, cy)), -abc);
+  EXPECT_EQ(sign(MI orient2d(ax, ay, cx, cy, bx, by)), -abc);
+}
+
+TEST(Predicates, Orient2dIsZeroForExactlyCollinearPoints) {
+  EXPECT_EQ(MI orient2d(0., 0., 1., 1., 3., 3.), 0.);
+  EXPECT_EQ(MI orient2d(0.5, 0.25, 1.5, 0.75, 1e10 + 0.5, 0.5e10 + 0.25), 0.);
+  EXPECT_GT(MI orient2d(0., 0., 1., 0., 0., 1.), 0.);
+  EXPECT_LT(MI orient2d(0., 0., 0., 1., 1., 0.), 0.);
+}
+
+TEST(Predicates, Orient3dSignIsExactNearCoplanarPoints) {
+  const MI point3d a = {1., 0., 0.};
+  const MI point3d b = {0., 1., 0.};
+  const MI point3d c = {0., 0., 1.};
+
+  // d на плоскости x + y + z = 1 и сдвинутые от нее на 1 ulp.
+  const MI point3d on_plane = {0.25, 0.25, 0.5};
+  const MI point3d above    = {0.25, 0.25, STD nextafter(0.5, 1.)};
+  const MI point3d below    = {0.25, 0.25, STD nextafter(0.5, 0.)};
+
+  EXPECT_EQ(MI orient3d(a, b, c, on_plane), 0.);
+  EXPECT_LT(MI orient3d(a, b, c, above), 0.);
+  EXPECT_GT(MI orient3d(a, b, c, below), 0.);
+
+  EXPECT_GT(MI orient3d(a, c, b, above), 0.);
+  EXPECT_LT(MI orient3d(b, a, c, below), 0.);
+}
+
+TEST(Predicates, OrientAlongSignIsExactForNearlyDegeneratedTriangle) {
+  const MI point3d n = {0., 0., 1.};
+
+  const MI point3d a = {0.1, 0.1, 0.};
+  const MI point3d b = {0.3, 0.3, 0.};
+  const MI point3d c = {0.7, STD nextafter(0.7, 1.), 0.};
+  const MI point3d d = {0.7, STD nextafter(0.7, 0.), 0.};
+
+  EXPECT_GT(MI orient_along(a, b, c, n), 0.);
+  EXPECT_LT(MI orient_along(a, b, d, n), 0.);
+  EXPECT_LT(MI orient_along(a, b, c, n * -1.), 0.);
+  EXPECT_EQ(MI orient_along(a, b, {0.5, 0.5, 0.}, n), 0.);
+}
+
+TEST(Predicates, IsCollinear) {
+  EXPECT_TRUE(MI is_collinear({0., 0., 0.}, {1., 2., 3.}, {2., 4., 6.}));
+  EXPECT_TRUE(MI is_collinear({1., 1., 1.}, {1., 1., 1.}, {5., 0., 2.}));
+  EXPECT_FALSE(MI is_collinear({0., 0., 0.}, {1., 2., 3.}, {2., 4., STD nextafter(6., 7.)}));
+  EXPECT_FALSE(MI is_collinear({0., 0., 0.}, {1., 0., 0.}, {0., 1., 0.}));
+}
+}  // namespace mi::test
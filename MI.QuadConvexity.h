@@ -0,0 +1,154 @@
+﻿#pragma once
+
+#include <algorithm>
+#include <cstdint>
+
+#include "Common/MI.Check.h"
+#include "Common/MI.ParallelFor.h"
+#include "Container/MI.Bitset.h"
+#include "Container/MI.Matrix.h"
+#include "Mesh/MI.FlatMesh.h"
+
+// Пакетная проверка quad на вогнутость и коробление.
+// ==================================================
+//
+// MI quality для quad_with сначала вызывает MI internal::is_curved, построенную на angle_between_normals: для каждого
+// элемента отдельно считаются нормали и арккосинусы углов между ними. quad_convexity_mask проверяет все quad сетки
+// без тригонометрии и корней, только по знакам и квадратам скалярных произведений.
+//
+// Для угла i (как в MI evaluate_quality_metrics) c[i] = (p[i + 1] - p[i]) x (p[i - 1] - p[i]) - удвоенная площадь
+// подтреугольника с нормалью, n - нормаль элемента (MI element_normal, векторное произведение диагоналей) или общая
+// опорная нормаль. Элемент проходит проверку, если для всех 4 углов:
+//
+// - s[i] = c[i] · n > 0                                  - площадь подтреугольника со знаком положительна (выпуклость,
+//                                                          невырожденность, для опорной нормали - не вывернут),
+// - s[i]^2 >= max_warp_cos^2 * |c[i]|^2 * |n|^2           - угол между c[i] и n не больше arccos(max_warp_cos)
+//                                                          (коробление), при max_warp_cos <= 0 проверка отключена.
+//
+// Элементы обходятся словами по 64 (1 бит результата на элемент): координаты вершин слова собираются в локальные
+// массивы по компонентам (SoA), затем проверка выполняется одним циклом без ветвлений по всем 64 элементам, который
+// компилятор векторизует. Результат - MI dynamic_bitset, его можно сразу пересекать с другими фильтрами
+// (MI scan_validity) и обходить только прошедшие элементы пакетного расчета качества:
+//
+// const MI dynamic_bitset convex = MI quad_convexity_mask(mesh, STD cos(max_warp_angle));
+//
+// convex.for_each_set([&](const size_t n_element) { ... });
+namespace mi {
+namespace internal {
+// Координаты вершин одного слова элементов: x[i][lane] - x вершины i элемента first + lane.
+struct quad_convexity_block {
+    static constexpr size_t n_lanes = dynamic_bitset::bits_per_word;
+
+    double x[4][n_lanes];
+    double y[4][n_lanes];
+    double z[4][n_lanes];
+};
+
+// Результат проверки элементов блока (по 1 байту на элемент), n_lanes <= quad_convexity_block::n_lanes.
+inline void check_quad_convexity(const quad_convexity_block& block,
+                                 const size_t                n_lanes,
+                                 const MI point3d&           reference_normal,
+                                 const double                max_warp_cos2,
+                                 STD uint8_t* const          passed) noexcept {
+  const bool   use_common_normal = reference_normal.squared_euclidean_norm() > 0.;
+  const double rx                = reference_normal.x();
+  const double ry                = reference_normal.y();
+  const double rz                = reference_normal.z();
+
+  for (size_t lane = 0; lane < n_lanes; ++lane) {
+    // Нормаль элемента - векторное произведение диагоналей (p2 - p0) x (p3 - p1).
+    const double d0x = block.x[2][lane] - block.x[0][lane];
+    const double d0y = block.y[2][lane] - block.y[0][lane];
+    const double d0z = block.z[2][lane] - block.z[0][lane];
+    const double d1x = block.x[3][lane] - block.x[1][lane];
+    const double d1y = block.y[3][lane] - block.y[1][lane];
+    const double d1z = block.z[3][lane] - block.z[1][lane];
+
+    const double nx = use_common_normal ? rx : d0y * d1z - d0z * d1y;
+    const double ny = use_common_normal ? ry : d0z * d1x - d0x * d1z;
+    const double nz = use_common_normal ? rz : d0x * d1y - d0y * d1x;
+    const double n2 = nx * nx + ny * ny + nz * nz;
+
+    bool is_passed = true;
+
+    for (size_t i = 0; i < 4; ++i) {
+      const size_t next     = (i + 1) % 4;
+      const size_t previous = (i + 3) % 4;
+
+      const double e1x = block.x[next][lane] - block.x[i][lane];
+      const double e1y = block.y[next][lane] - block.y[i][lane];
+      const double e1z = block.z[next][lane] - block.z[i][lane];
+      const double e2x = block.x[previous][lane] - block.x[i][lane];
+      const double e2y = block.y[previous][lane] - block.y[i][lane];
+      const double e2z = block.z[previous][lane] - block.z[i][lane];
+
+      const double cx = e1y * e2z - e1z * e2y;
+      const double cy = e1z * e2x - e1x * e2z;
+      const double cz = e1x * e2y - e1y * e2x;
+
+      const double s  = cx * nx + cy * ny + cz * nz;
+      const double c2 = cx * cx + cy * cy + cz * cz;
+
+      // & вместо &&: условие без ветвлений.
+      is_passed = is_passed & (s > 0.) & (s * s >= max_warp_cos2 * c2 * n2);
+    }
+
+    passed[lane] = static_cast<STD uint8_t>(is_passed);
+  }
+}
+}  // namespace internal
+
+// Бит n_element установлен, если quad выпуклый, невырожденный и не покороблен больше чем на arccos(max_warp_cos).
+// reference_normal - общая опорная нормаль для плоских сеток (тогда вывернутые элементы тоже не проходят проверку),
+// нулевой вектор - нормаль каждого элемента.
+MI_NODISCARD inline dynamic_bitset quad_convexity_mask(const flat_quad_mesh& mesh,
+                                                       const double          max_warp_cos     = 0.,
+                                                       const MI point3d&     reference_normal = {0., 0., 0.},
+                                                       const size_t          n_threads = MI default_thread_count()) {
+  using internal::quad_convexity_block;
+
+  const size_t n_elements    = mesh.n_elements();
+  const double max_warp_cos2 = max_warp_cos > 0. ? max_warp_cos * max_warp_cos : 0.;
+
+  dynamic_bitset result(n_elements);
+
+  const size_t n_words = result.n_words();
+
+  parallel_chunks(n_words, STD min(n_threads, n_words), [&](size_t, const size_t first_word, const size_t last_word) {
+    dynamic_bitset::word_type* const words = result.words();
+
+    quad_convexity_block block;
+    STD uint8_t          passed[quad_convexity_block::n_lanes];
+
+    for (size_t n_word = first_word; n_word < last_word; ++n_word) {
+      const size_t first   = n_word * quad_convexity_block::n_lanes;
+      const size_t n_lanes = STD min(quad_convexity_block::n_lanes, n_elements - first);
+
+      for (size_t lane = 0; lane < n_lanes; ++lane) {
+        const auto& element = mesh.elements[first + lane];
+
+        for (size_t i = 0; i < 4; ++i) {
+          const MI point3d& vertex = mesh.vertices[element[i]];
+
+          block.x[i][lane] = vertex.x();
+          block.y[i][lane] = vertex.y();
+          block.z[i][lane] = vertex.z();
+        }
+      }
+
+      internal::check_quad_convexity(block, n_lanes, reference_normal, max_warp_cos2, passed);
+
+      // Биты за концом набора остаются сброшенными: n_lanes последнего слова меньше 64.
+      dynamic_bitset::word_type word = 0;
+
+      for (size_t lane = 0; lane < n_lanes; ++lane) {
+        word |= dynamic_bitset::word_type{passed[lane]} << lane;
+      }
+
+      words[n_word] = word;
+    }
+  });
+
+  return result;
+}
+}  // namespace mi
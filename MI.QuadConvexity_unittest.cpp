@@ -0,0 +1,86 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "Mesh/MI.ElementGeometryCache.h"
+#include "Mesh/MI.FlatMesh.h"
+#include "Mesh/MI.MeshTestUtil.h"
+#include "Mesh/MI.QuadConvexity.h"
+#include "Mesh/MI.ValidityScan.h"
+
+namespace mi::test {
+namespace {
+// Та же проверка по одному элементу через нормали углов и арккосинусы.
+bool is_convex_and_flat(const MI flat_quad_mesh& mesh, const size_t n_element, const double max_warp_angle) {
+  const MI element_geometry<4> geometry = MI make_element_geometry(MI internal::gather(mesh, n_element), {0., 0., 0.});
+  const double                 length   = STD sqrt(geometry.normal.squared_euclidean_norm());
+
+  for (size_t i = 0; i < 4; ++i) {
+    const double cos = geometry.corner_normals[i].dot(geometry.normal) / (geometry.corner_areas[i] * length);
+
+    if (!(geometry.corner_areas[i] > 0.) || !(cos > 0.) || STD acos(STD min(cos, 1.)) > max_warp_angle) {
+      return false;
+    }
+  }
+
+  return true;
+}
+}  // namespace
+
+TEST(QuadConvexity, MatchesValidityScanOnPlanarMesh) {
+  grid_options options;
+  options.jitter = 0.45;
+
+  MI flat_quad_mesh mesh = make_grid(30, options);
+
+  STD swap(mesh.elements[5][1], mesh.elements[5][3]);       // Вывернут
+  mesh.elements[64][2] = mesh.elements[64][1];              // Вырожден
+  mesh.vertices[mesh.elements[899][2]] = {29.1, 29.1, 0.};  // Вогнутый
+
+  for (const size_t n_threads: {1, 3}) {
+    const MI dynamic_bitset       mask     = MI quad_convexity_mask(mesh, 0., {0., 0., 1.}, n_threads);
+    const MI validity_scan_result validity = MI scan_validity(mesh, {0., 0., 1.}, n_threads);
+
+    EXPECT_EQ(mask.size(), mesh.n_elements());
+    EXPECT_EQ(mask, validity.valid);
+    EXPECT_FALSE(mask.test(5));
+    EXPECT_FALSE(mask.test(64));
+    EXPECT_FALSE(mask.test(899));
+  }
+
+  // Без общей нормали вывернутый элемент проходит проверку: он выпуклый.
+  const MI dynamic_bitset with_normal = MI quad_convexity_mask(mesh, 0., {0., 0., 1.});
+  const MI dynamic_bitset mask        = MI quad_convexity_mask(mesh);
+
+  EXPECT_EQ(mask.count(), with_normal.count() + 1);
+  EXPECT_TRUE(mask.test(5));
+}
+
+TEST(QuadConvexity, MatchesPerElementAngleCheckOnWarpedMesh) {
+  grid_options options;
+  options.jitter = 0.3;
+  options.warp   = 0.3;
+
+  const MI flat_quad_mesh mesh = make_grid(25, options);
+
+  for (const double max_warp_angle: {0.2, 0.5, 1.}) {
+    const MI dynamic_bitset mask = MI quad_convexity_mask(mesh, STD cos(max_warp_angle));
+
+    size_t n_passed = 0;
+
+    for (size_t n_element = 0; n_element < mesh.n_elements(); ++n_element) {
+      EXPECT_EQ(mask.test(n_element), is_convex_and_flat(mesh, n_element, max_warp_angle)) << n_element;
+      n_passed += mask.test(n_element);
+    }
+
+    EXPECT_EQ(mask.count(), n_passed);
+    EXPECT_GT(n_passed, 0);
+    EXPECT_LT(n_passed, mesh.n_elements());
+  }
+}
+
+TEST(QuadConvexity, EmptyMesh) {
+  EXPECT_EQ(MI quad_convexity_mask(MI flat_quad_mesh{}).size(), 0);
+}
+}  // namespace mi::test
@@ -0,0 +1,377 @@
+﻿#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "Common/MI.Check.h"
+#include "Common/MI.ParallelFor.h"
+#include "Container/MI.Matrix.h"
+#include "Mesh/MI.FlatMesh.h"
+#include "Mesh/MI.QualityGradient.h"
+
+// Качество квадратичных элементов.
+// ================================
+//
+// Криволинейные элементы задаются узлами на ребрах (и в центре), MI quality их не поддерживает. Для них отображение
+// x(ξ, η) = Σ N[k](ξ, η) * p[k] из опорного элемента нелинейно, и его матрица Якоби J = | ∂x/∂ξ, ∂x/∂η | меняется
+// от точки к точке. В каждой точке выборки (центр, углы, середины ребер и точки Гаусса опорного элемента):
+//
+// - c = ∂x/∂ξ x ∂x/∂η, якобиан det J = c · n (n - опорная нормаль),
+// - mean ratio столбцов J по формуле симплекс-узла (MI internal::mean_ratio_weights): для треугольника столбцы J -
+//   ребра опорного угла 0, для quad - половины ребер угла, поэтому для элементов с прямыми ребрами и узлами
+//   в серединах ребер значения в углах совпадают со значениями симплекс-узлов MI mean_ratio_quality.
+//
+// Результат для элемента:
+//
+// - mean_ratio     - наименьший mean ratio по точкам выборки, 0 для недействительного элемента;
+// - jacobian_ratio - min det J / max |det J| по точкам выборки в [-1; 1], элемент действителен, если больше 0.
+//
+// Действительность проверяется по выборке: якобиан между точками не вычисляется.
+//
+// Нумерация узлов:
+//
+// - 6-узловой треугольник: углы 0, 1, 2, затем середины ребер 3 (0-1), 4 (1-2), 5 (2-0);
+// - 8-узловой quad (serendipity): углы 0-3, затем середины ребер 4 (0-1), 5 (1-2), 6 (2-3), 7 (3-0);
+// - 9-узловой quad (Лагранжа): те же 8 узлов и центр 8.
+//
+// Производные функций формы в точках выборки считаются один раз при компиляции (MI internal::shape_derivatives).
+// Элементы обрабатываются пачками по 64: узлы пачки собираются в локальные массивы по компонентам (SoA), затем для
+// каждой точки выборки один цикл без ветвлений по элементам пачки, который компилятор векторизует.
+namespace mi {
+struct quadratic_quality_columns {
+    STD vector<double> mean_ratio;
+    STD vector<double> jacobian_ratio;
+};
+
+namespace internal {
+// Координаты узлов quad в опорном элементе [-1; 1]^2.
+constexpr double quad_node_positions[9][2] = {
+  {-1., -1.},
+  {1.,  -1.},
+  {1.,  1. },
+  {-1., 1. },
+  {0.,  -1.},
+  {1.,  0. },
+  {0.,  1. },
+  {-1., 0. },
+  {0.,  0. },
+};
+
+// 1 / √3: точки квадратуры Гаусса 2 x 2.
+constexpr double gauss_point = 0.57735026918962576451;
+
+template<size_t NodesPerElement>
+struct quadratic_element;
+
+template<>
+struct quadratic_element<6> {
+    static constexpr size_t n_samples = 10;
+
+    // (ξ, η) в опорном треугольнике (0, 0), (1, 0), (0, 1): центр, углы, середины ребер, точки Гаусса.
+    static constexpr double samples[n_samples][2] = {
+      {1. / 3., 1. / 3.},
+      {0.,      0.     },
+      {1.,      0.     },
+      {0.,      1.     },
+      {0.5,     0.     },
+      {0.5,     0.5    },
+      {0.,      0.5    },
+      {1. / 6., 1. / 6.},
+      {2. / 3., 1. / 6.},
+      {1. / 6., 2. / 3.},
+    };
+
+    static constexpr const mean_ratio_weights& weights = triangle_mean_ratio_weights;
+
+    // Барицентрические L0 = 1 - ξ - η, L1 = ξ, L2 = η: N[i] = L[i] * (2 * L[i] - 1) для углов, N = 4 * L[i] * L[j]
+    // для середин ребер.
+    static constexpr void derivatives(const double xi, const double eta, double (&d_xi)[6], double (&d_eta)[6]) {
+      const double l0 = 1. - xi - eta;
+
+      d_xi[0]  = 1. - 4. * l0;
+      d_eta[0] = 1. - 4. * l0;
+      d_xi[1]  = 4. * xi - 1.;
+      d_eta[1] = 0.;
+      d_xi[2]  = 0.;
+      d_eta[2] = 4. * eta - 1.;
+      d_xi[3]  = 4. * (l0 - xi);
+      d_eta[3] = -4. * xi;
+      d_xi[4]  = 4. * eta;
+      d_eta[4] = 4. * xi;
+      d_xi[5]  = -4. * eta;
+      d_eta[5] = 4. * (l0 - eta);
+    }
+};
+
+// Точки выборки quad: центр, углы, середины ребер, точки Гаусса.
+struct quadratic_quad_samples {
+    static constexpr size_t n_samples = 13;
+
+    static constexpr double samples[n_samples][2] = {
+      {0.,           0.          },
+      {-1.,          -1.         },
+      {1.,           -1.         },
+      {1.,           1.          },
+      {-1.,          1.          },
+      {0.,           -1.         },
+      {1.,           0.          },
+      {0.,           1.          },
+      {-1.,          0.          },
+      {-gauss_point, -gauss_point},
+      {gauss_point,  -gauss_point},
+      {gauss_point,  gauss_point },
+      {-gauss_point, gauss_point },
+    };
+
+    static constexpr const mean_ratio_weights& weights = quad_mean_ratio_weights;
+};
+
+template<>
+struct quadratic_element<8> : quadratic_quad_samples {
+    // Угол (ξi, ηi): N = (1 + ξ ξi) (1 + η ηi) (ξ ξi + η ηi - 1) / 4,
+    // середина ребра ξi = 0: N = (1 - ξ^2) (1 + η ηi) / 2, середина ребра ηi = 0: N = (1 + ξ ξi) (1 - η^2) / 2.
+    static constexpr void derivatives(const double xi, const double eta, double (&d_xi)[8], double (&d_eta)[8]) {
+      for (size_t k = 0; k < 8; ++k) {
+        const double xi_k  = quad_node_positions[k][0];
+        const double eta_k = quad_node_positions[k][1];
+
+        if (k < 4) {
+          d_xi[k]  = xi_k * (1. + eta * eta_k) * (2. * xi * xi_k + eta * eta_k) / 4.;
+          d_eta[k] = eta_k * (1. + xi * xi_k) * (xi * xi_k + 2. * eta * eta_k) / 4.;
+        } else if (xi_k == 0.) {
+          d_xi[k]  = -xi * (1. + eta * eta_k);
+          d_eta[k] = eta_k * (1. - xi * xi) / 2.;
+        } else {
+          d_xi[k]  = xi_k * (1. - eta * eta) / 2.;
+          d_eta[k] = -eta * (1. + xi * xi_k);
+        }
+      }
+    }
+};
+
+template<>
+struct quadratic_element<9> : quadratic_quad_samples {
+    // N = l(ξi, ξ) * l(ηi, η), l - квадратичный полином Лагранжа по узлам -1, 0, 1.
+    static constexpr void derivatives(const double xi, const double eta, double (&d_xi)[9], double (&d_eta)[9]) {
+      for (size_t k = 0; k < 9; ++k) {
+        const double xi_k  = quad_node_positions[k][0];
+        const double eta_k = quad_node_positions[k][1];
+
+        d_xi[k]  = lagrange_derivative(xi_k, xi) * lagrange(eta_k, eta);
+        d_eta[k] = lagrange(xi_k, xi) * lagrange_derivative(eta_k, eta);
+      }
+    }
+
+  private:
+    static constexpr double lagrange(const double node, const double t) {
+      return node == 0. ? 1. - t * t : t * (t + node) / 2.;
+    }
+
+    static constexpr double lagrange_derivative(const double node, const double t) {
+      return node == 0. ? -2. * t : t + node / 2.;
+    }
+};
+
+// d_xi[s][k], d_eta[s][k] - производные функции формы узла k в точке выборки s.
+template<size_t NodesPerElement>
+struct shape_derivative_table {
+    static constexpr size_t n_samples = quadratic_element<NodesPerElement>::n_samples;
+
+    double d_xi[n_samples][NodesPerElement]  = {};
+    double d_eta[n_samples][NodesPerElement] = {};
+};
+
+template<size_t NodesPerElement>
+MI_NODISCARD constexpr shape_derivative_table<NodesPerElement> make_shape_derivative_table() {
+  using element = quadratic_element<NodesPerElement>;
+
+  shape_derivative_table<NodesPerElement> result;
+
+  for (size_t s = 0; s < element::n_samples; ++s) {
+    element::derivatives(element::samples[s][0], element::samples[s][1], result.d_xi[s], result.d_eta[s]);
+  }
+
+  return result;
+}
+
+template<size_t NodesPerElement>
+constexpr shape_derivative_table<NodesPerElement> shape_derivatives = make_shape_derivative_table<NodesPerElement>();
+
+// Узлы пачки элементов: x[k][lane] - x узла k элемента first + lane.
+template<size_t NodesPerElement>
+struct quadratic_element_block {
+    static constexpr size_t n_lanes = 64;
+
+    double x[NodesPerElement][n_lanes];
+    double y[NodesPerElement][n_lanes];
+    double z[NodesPerElement][n_lanes];
+};
+
+// ∂x/∂ξ, ∂x/∂η и c = ∂x/∂ξ x ∂x/∂η в точке выборки для всех элементов пачки.
+template<size_t NodesPerElement>
+struct sample_jacobians {
+    double e1x[quadratic_element_block<NodesPerElement>::n_lanes];
+    double e1y[quadratic_element_block<NodesPerElement>::n_lanes];
+    double e1z[quadratic_element_block<NodesPerElement>::n_lanes];
+    double e2x[quadratic_element_block<NodesPerElement>::n_lanes];
+    double e2y[quadratic_element_block<NodesPerElement>::n_lanes];
+    double e2z[quadratic_element_block<NodesPerElement>::n_lanes];
+    double cx[quadratic_element_block<NodesPerElement>::n_lanes];
+    double cy[quadratic_element_block<NodesPerElement>::n_lanes];
+    double cz[quadratic_element_block<NodesPerElement>::n_lanes];
+};
+
+template<size_t NodesPerElement>
+void evaluate_sample_jacobians(const quadratic_element_block<NodesPerElement>& block,
+                               const size_t                                   n_sample,
+                               const size_t                                   n_lanes,
+                               sample_jacobians<NodesPerElement>&             result) noexcept {
+  const auto& table = shape_derivatives<NodesPerElement>;
+
+  for (size_t lane = 0; lane < n_lanes; ++lane) {
+    double e1x = 0., e1y = 0., e1z = 0.;
+    double e2x = 0., e2y = 0., e2z = 0.;
+
+    for (size_t k = 0; k < NodesPerElement; ++k) {
+      const double d_xi  = table.d_xi[n_sample][k];
+      const double d_eta = table.d_eta[n_sample][k];
+
+      e1x += d_xi * block.x[k][lane];
+      e1y += d_xi * block.y[k][lane];
+      e1z += d_xi * block.z[k][lane];
+      e2x += d_eta * block.x[k][lane];
+      e2y += d_eta * block.y[k][lane];
+      e2z += d_eta * block.z[k][lane];
+    }
+
+    result.e1x[lane] = e1x;
+    result.e1y[lane] = e1y;
+    result.e1z[lane] = e1z;
+    result.e2x[lane] = e2x;
+    result.e2y[lane] = e2y;
+    result.e2z[lane] = e2z;
+    result.cx[lane]  = e1y * e2z - e1z * e2y;
+    result.cy[lane]  = e1z * e2x - e1x * e2z;
+    result.cz[lane]  = e1x * e2y - e1y * e2x;
+  }
+}
+
+template<size_t NodesPerElement>
+void evaluate_quadratic_block(const quadratic_element_block<NodesPerElement>& block,
+                              const size_t                                   n_lanes,
+                              const MI point3d&                              reference_normal,
+                              double* const                                  mean_ratio,
+                              double* const                                  jacobian_ratio) noexcept {
+  using element = quadratic_element<NodesPerElement>;
+
+  constexpr size_t n_block_lanes = quadratic_element_block<NodesPerElement>::n_lanes;
+
+  const mean_ratio_weights& w                 = element::weights;
+  const bool                use_common_normal = reference_normal.squared_euclidean_norm() > 0.;
+
+  sample_jacobians<NodesPerElement> jacobians;
+
+  double nx[n_block_lanes], ny[n_block_lanes], nz[n_block_lanes];
+  double min_quality[n_block_lanes], min_jacobian[n_block_lanes], max_jacobian[n_block_lanes];
+
+  // Точка выборки 0 - центр элемента: нормаль в ней служит опорной, если общая не задана.
+  evaluate_sample_jacobians(block, 0, n_lanes, jacobians);
+
+  for (size_t lane = 0; lane < n_lanes; ++lane) {
+    nx[lane] = use_common_normal ? reference_normal.x() : jacobians.cx[lane];
+    ny[lane] = use_common_normal ? reference_normal.y() : jacobians.cy[lane];
+    nz[lane] = use_common_normal ? reference_normal.z() : jacobians.cz[lane];
+
+    min_quality[lane]  = STD numeric_limits<double>::max();
+    min_jacobian[lane] = STD numeric_limits<double>::max();
+    max_jacobian[lane] = 0.;
+  }
+
+  for (size_t s = 0; s < element::n_samples; ++s) {
+    if (s > 0) {
+      evaluate_sample_jacobians(block, s, n_lanes, jacobians);
+    }
+
+    for (size_t lane = 0; lane < n_lanes; ++lane) {
+      const double e1x = jacobians.e1x[lane], e1y = jacobians.e1y[lane], e1z = jacobians.e1z[lane];
+      const double e2x = jacobians.e2x[lane], e2y = jacobians.e2y[lane], e2z = jacobians.e2z[lane];
+      const double cx = jacobians.cx[lane], cy = jacobians.cy[lane], cz = jacobians.cz[lane];
+
+      const double jacobian = cx * nx[lane] + cy * ny[lane] + cz * nz[lane];
+      const double area     = STD sqrt(cx * cx + cy * cy + cz * cz);
+
+      // |s1|^2 + |s2|^2, s1 = a * e1, s2 = b * e1 + d * e2.
+      const double s2x = w.b * e1x + w.d * e2x;
+      const double s2y = w.b * e1y + w.d * e2y;
+      const double s2z = w.b * e1z + w.d * e2z;
+      const double f   = w.a * w.a * (e1x * e1x + e1y * e1y + e1z * e1z) + s2x * s2x + s2y * s2y + s2z * s2z;
+
+      const double quality = f > 0. ? 2. * w.a * w.d * area / f : 0.;
+
+      min_quality[lane]  = STD min(min_quality[lane], quality);
+      min_jacobian[lane] = STD min(min_jacobian[lane], jacobian);
+      max_jacobian[lane] = STD max(max_jacobian[lane], STD abs(jacobian));
+    }
+  }
+
+  for (size_t lane = 0; lane < n_lanes; ++lane) {
+    const bool is_valid = min_jacobian[lane] > 0.;
+
+    mean_ratio[lane]     = is_valid ? min_quality[lane] : 0.;
+    jacobian_ratio[lane] = max_jacobian[lane] > 0. ? min_jacobian[lane] / max_jacobian[lane] : 0.;
+  }
+}
+}  // namespace internal
+
+// Качество квадратичных элементов сетки (NodesPerElement: 6, 8 или 9). reference_normal - общая опорная нормаль для
+// плоских сеток, нулевой вектор - нормаль в центре каждого элемента (вывернутые элементы при этом не обнаруживаются).
+template<size_t NodesPerElement>
+MI_NODISCARD quadratic_quality_columns evaluate_quadratic_quality(const flat_mesh<NodesPerElement>& mesh,
+                                                                  const MI point3d& reference_normal = {0., 0., 0.},
+                                                                  const size_t n_threads = MI default_thread_count()) {
+  static_assert(NodesPerElement == 6 || NodesPerElement == 8 || NodesPerElement == 9,
+                "evaluate_quadratic_quality: only quadratic triangles and quads are supported");
+
+  using block_type = internal::quadratic_element_block<NodesPerElement>;
+
+  const size_t n_elements = mesh.n_elements();
+  const size_t n_blocks   = (n_elements + block_type::n_lanes - 1) / block_type::n_lanes;
+
+  quadratic_quality_columns result;
+  result.mean_ratio.resize(n_elements);
+  result.jacobian_ratio.resize(n_elements);
+
+  const auto evaluate_blocks = [&](size_t, const size_t first_block, const size_t last_block) {
+    block_type block;
+
+    for (size_t n_block = first_block; n_block < last_block; ++n_block) {
+      const size_t first   = n_block * block_type::n_lanes;
+      const size_t n_lanes = STD min(block_type::n_lanes, n_elements - first);
+
+      for (size_t lane = 0; lane < n_lanes; ++lane) {
+        const auto& element = mesh.elements[first + lane];
+
+        for (size_t k = 0; k < NodesPerElement; ++k) {
+          const MI point3d& node = mesh.vertices[element[k]];
+
+          block.x[k][lane] = node.x();
+          block.y[k][lane] = node.y();
+          block.z[k][lane] = node.z();
+        }
+      }
+
+      internal::evaluate_quadratic_block(block,
+                                         n_lanes,
+                                         reference_normal,
+                                         result.mean_ratio.data() + first,
+                                         result.jacobian_ratio.data() + first);
+    }
+  };
+
+  parallel_chunks(n_blocks, STD min(n_threads, n_blocks), evaluate_blocks);
+
+  return result;
+}
+}  // namespace mi
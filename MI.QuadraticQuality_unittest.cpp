@@ -0,0 +1,266 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cmath>
+
+#include "Mesh/MI.FlatMesh.h"
+#include "Mesh/MI.QuadraticQuality.h"
+#include "Mesh/MI.QualityGradient.h"
+
+namespace mi::test {
+namespace {
+MI point3d middle(const MI point3d& a, const MI point3d& b) {
+  return (a + b) * 0.5;
+}
+
+// Квадратичный треугольник с прямыми ребрами и узлами в серединах ребер.
+MI flat_quadratic_triangle_mesh straight_triangle(const STD array<MI point3d, 3>& p) {
+  MI flat_quadratic_triangle_mesh mesh;
+  mesh.vertices = {p[0], p[1], p[2], middle(p[0], p[1]), middle(p[1], p[2]), middle(p[2], p[0])};
+  mesh.elements = {
+    {0, 1, 2, 3, 4, 5}
+  };
+
+  return mesh;
+}
+
+// Квадратичный quad (9 узлов) с прямыми ребрами.
+MI flat_quadratic_quad_mesh straight_quad(const STD array<MI point3d, 4>& p) {
+  MI flat_quadratic_quad_mesh mesh;
+  mesh.vertices = {p[0],
+                   p[1],
+                   p[2],
+                   p[3],
+                   middle(p[0], p[1]),
+                   middle(p[1], p[2]),
+                   middle(p[2], p[3]),
+                   middle(p[3], p[0]),
+                   (p[0] + p[1] + p[2] + p[3]) * 0.25};
+  mesh.elements = {
+    {0, 1, 2, 3, 4, 5, 6, 7, 8}
+  };
+
+  return mesh;
+}
+
+MI flat_serendipity_quad_mesh serendipity(const MI flat_quadratic_quad_mesh& mesh) {
+  MI flat_serendipity_quad_mesh result;
+  result.vertices = mesh.vertices;
+
+  for (const auto& element: mesh.elements) {
+    result.elements.push_back(
+      {element[0], element[1], element[2], element[3], element[4], element[5], element[6], element[7]});
+  }
+
+  return result;
+}
+// Решетка n x n 9-узловых quad на сетке узлов (2n + 1) x (2n + 1), узел (i, j) имеет номер j * (2n + 1) + i.
+MI flat_quadratic_quad_mesh quadratic_grid(const size_t n) {
+  const size_t side = 2 * n + 1;
+
+  MI flat_quadratic_quad_mesh mesh;
+
+  for (size_t j = 0; j < side; ++j) {
+    for (size_t i = 0; i < side; ++i) {
+      mesh.vertices.push_back({static_cast<double>(i), static_cast<double>(j), 0.});
+    }
+  }
+
+  for (size_t j = 0; j < n; ++j) {
+    for (size_t i = 0; i < n; ++i) {
+      const auto node = [&](const size_t di, const size_t dj) {
+        return (2 * j + dj) * side + 2 * i + di;
+      };
+
+      mesh.elements.push_back(
+        {node(0, 0), node(2, 0), node(2, 2), node(0, 2), node(1, 0), node(2, 1), node(1, 2), node(0, 1), node(1, 1)});
+    }
+  }
+
+  return mesh;
+}
+}  // namespace
+
+TEST(QuadraticQuality, ShapeFunctionDerivativesSumToZero) {
+  const auto check = [](const auto& table, const size_t n_samples, const size_t n_nodes) {
+    for (size_t s = 0; s < n_samples; ++s) {
+      double sum_xi  = 0.;
+      double sum_eta = 0.;
+
+      for (size_t k = 0; k < n_nodes; ++k) {
+        sum_xi += table.d_xi[s][k];
+        sum_eta += table.d_eta[s][k];
+      }
+
+      EXPECT_NEAR(sum_xi, 0., 1e-14);
+      EXPECT_NEAR(sum_eta, 0., 1e-14);
+    }
+  };
+
+  check(MI internal::shape_derivatives<6>, MI internal::quadratic_element<6>::n_samples, 6);
+  check(MI internal::shape_derivatives<8>, MI internal::quadratic_element<8>::n_samples, 8);
+  check(MI internal::shape_derivatives<9>, MI internal::quadratic_element<9>::n_samples, 9);
+}
+
+TEST(QuadraticQuality, StraightSidedTriangleMatchesLinearQuality) {
+  const STD array<MI point3d, 3> p = {
+    MI point3d{0., 0., 0.},
+    MI point3d{2., 0.3, 0.},
+    MI point3d{0.4, 1.1, 0.}
+  };
+
+  const MI quadratic_quality_columns result = MI evaluate_quadratic_quality(straight_triangle(p));
+
+  EXPECT_NEAR(result.mean_ratio[0], MI mean_ratio_quality(p, MI element_normal(p)), 1e-14);
+  EXPECT_NEAR(result.jacobian_ratio[0], 1., 1e-14);
+}
+
+TEST(QuadraticQuality, StraightSidedQuadIsIdealForSquare) {
+  const STD array<MI point3d, 4> square = {
+    MI point3d{0., 0., 0.},
+    MI point3d{1., 0., 0.},
+    MI point3d{1., 1., 0.},
+    MI point3d{0., 1., 0.}
+  };
+
+  const MI flat_quadratic_quad_mesh mesh = straight_quad(square);
+
+  for (const MI quadratic_quality_columns& result:
+       {MI evaluate_quadratic_quality(mesh), MI evaluate_quadratic_quality(serendipity(mesh))}) {
+    EXPECT_NEAR(result.mean_ratio[0], 1., 1e-14);
+    EXPECT_NEAR(result.jacobian_ratio[0], 1., 1e-14);
+  }
+
+  // Трапеция: в углах mean ratio совпадает с симплекс-узлами, результат - наименьший из них.
+  const STD array<MI point3d, 4> trapezoid = {
+    MI point3d{0., 0., 0.},
+    MI point3d{2., 0., 0.},
+    MI point3d{1.5, 1., 0.},
+    MI point3d{0.5, 1., 0.}
+  };
+
+  const MI quadratic_quality_columns result = MI evaluate_quadratic_quality(straight_quad(trapezoid));
+
+  double min_corner = 1.;
+
+  for (size_t i = 0; i < 4; ++i) {
+    const STD array<MI point3d, 3> corner = {trapezoid[i], trapezoid[(i + 1) % 4], trapezoid[(i + 3) % 4]};
+    const MI point3d               e1     = corner[1] - corner[0];
+    const MI point3d               e2     = corner[2] - corner[0];
+
+    min_corner = STD min(min_corner,
+                         2. * STD sqrt(e1.cross(e2).squared_euclidean_norm()) /
+                           (e1.squared_euclidean_norm() + e2.squared_euclidean_norm()));
+  }
+
+  EXPECT_NEAR(result.mean_ratio[0], min_corner, 1e-14);
+  EXPECT_GT(result.jacobian_ratio[0], 0.);
+  EXPECT_LT(result.jacobian_ratio[0], 1.);
+}
+
+TEST(QuadraticQuality, CurvedEdgeLowersQualityAndFoldedElementIsInvalid) {
+  const STD array<MI point3d, 3> p = {
+    MI point3d{0., 0., 0.},
+    MI point3d{1., 0., 0.},
+    MI point3d{0., 1., 0.}
+  };
+
+  MI flat_quadratic_triangle_mesh mesh = straight_triangle(p);
+
+  // Середина ребра 0-1 сдвинута внутрь элемента: ребро изогнуто, элемент действителен.
+  mesh.vertices[3] = {0.5, 0.15, 0.};
+  mesh.vertices.push_back({0.5, 0.6, 0.});
+
+  // Второй элемент с той же серединой ребра, сдвинутой за противоположный угол: элемент складывается.
+  mesh.elements.push_back({0, 1, 2, 6, 4, 5});
+
+  for (const MI point3d& normal: {MI point3d{0., 0., 0.}, MI point3d{0., 0., 1.}}) {
+    const MI quadratic_quality_columns result = MI evaluate_quadratic_quality(mesh, normal);
+
+    EXPECT_GT(result.mean_ratio[0], 0.);
+    EXPECT_LT(result.mean_ratio[0], MI mean_ratio_quality(p, MI element_normal(p)));
+    EXPECT_GT(result.jacobian_ratio[0], 0.);
+
+    EXPECT_EQ(result.mean_ratio[1], 0.);
+    EXPECT_LT(result.jacobian_ratio[1], 0.);
+  }
+}
+
+TEST(QuadraticQuality, BoundaryVertices) {
+  const size_t n    = 3;
+  const size_t side = 2 * n + 1;
+
+  const MI flat_quadratic_quad_mesh quads = quadratic_grid(n);
+
+  // Те же узлы, каждый quad разбит диагональю на два 6-узловых треугольника, центр quad - середина диагонали.
+  MI flat_quadratic_triangle_mesh triangles;
+  triangles.vertices = quads.vertices;
+
+  for (const auto& e: quads.elements) {
+    triangles.elements.push_back({e[0], e[1], e[2], e[4], e[5], e[8]});
+    triangles.elements.push_back({e[0], e[2], e[3], e[8], e[6], e[7]});
+  }
+
+  const STD vector<bool> quad_boundary        = MI boundary_vertices(quads);
+  const STD vector<bool> triangle_boundary    = MI boundary_vertices(triangles);
+  const STD vector<bool> serendipity_boundary = MI boundary_vertices(serendipity(quads));
+
+  for (size_t j = 0; j < side; ++j) {
+    for (size_t i = 0; i < side; ++i) {
+      const bool is_boundary = i == 0 || j == 0 || i == side - 1 || j == side - 1;
+
+      EXPECT_EQ(quad_boundary[j * side + i], is_boundary) << i << " " << j;
+      EXPECT_EQ(triangle_boundary[j * side + i], is_boundary) << i << " " << j;
+      EXPECT_EQ(serendipity_boundary[j * side + i], is_boundary) << i << " " << j;
+    }
+  }
+}
+
+TEST(QuadraticQuality, IndependentOfThreadCount) {
+  MI flat_quadratic_quad_mesh mesh;
+
+  const size_t n = 20;
+
+  // Решетка узлов (2n + 1) x (2n + 1) со слегка изогнутыми линиями, элементы - 9-узловые quad.
+  for (size_t j = 0; j <= 2 * n; ++j) {
+    for (size_t i = 0; i <= 2 * n; ++i) {
+      const double x = static_cast<double>(i) / 2.;
+      const double y = static_cast<double>(j) / 2.;
+
+      mesh.vertices.push_back({x + 0.05 * STD sin(y), y + 0.05 * STD sin(1.3 * x), 0.});
+    }
+  }
+
+  const auto node = [n](const size_t i, const size_t j) {
+    return j * (2 * n + 1) + i;
+  };
+
+  for (size_t j = 0; j < n; ++j) {
+    for (size_t i = 0; i < n; ++i) {
+      const size_t x = 2 * i, y = 2 * j;
+
+      mesh.elements.push_back({node(x, y),
+                               node(x + 2, y),
+                               node(x + 2, y + 2),
+                               node(x, y + 2),
+                               node(x + 1, y),
+                               node(x + 2, y + 1),
+                               node(x + 1, y + 2),
+                               node(x, y + 1),
+                               node(x + 1, y + 1)});
+    }
+  }
+
+  const MI quadratic_quality_columns single = MI evaluate_quadratic_quality(mesh, {0., 0., 1.}, 1);
+  const MI quadratic_quality_columns multi  = MI evaluate_quadratic_quality(mesh, {0., 0., 1.}, 4);
+
+  EXPECT_EQ(single.mean_ratio, multi.mean_ratio);
+  EXPECT_EQ(single.jacobian_ratio, multi.jacobian_ratio);
+
+  for (size_t n_element = 0; n_element < mesh.n_elements(); ++n_element) {
+    EXPECT_GT(single.mean_ratio[n_element], 0.9);
+    EXPECT_GT(single.jacobian_ratio[n_element], 0.);
+  }
+}
+}  // namespace mi::test
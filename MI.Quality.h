@@ -2,8 +2,10 @@
 
 #include "Base/MI.DoubleEq.h"
 #include "Common/MI.AngleBetweenNormals.h"
+#include "Common/MI.Predicates.h"
 #include "Container/MI.Matrix.h"
 #include "Mesh/MI.IsDegenerated.h"
+#include "Mesh/MI.QualityInstrumentation.h"
 #include "Mesh/MeshElement/MI.Quad.h"
 #include "Mesh/MeshElement/MI.Triangle.h"
 
@@ -303,7 +305,16 @@ MI_NODISCARD inline double quality(const MI point3d& v0, const MI point3d& v1, c
   constexpr size_t left  = 2;
   constexpr size_t right = 1;
 
-  const MI static_vector<MI point3d, 3> rotated_vertices = MI transfer_to_plane_z(v0, v1, v2);
+  // Следует из определения 2. В собственном базисе симплекс-узла det(D(Tk)) = |e1 x e2| >= 0, поэтому действительность
+  // равносильна невырожденности. Она решается точным предикатом до перехода в базис: у почти вырожденного элемента
+  // знак определителя, посчитанного после поворота, определяется ошибками округления.
+  const bool is_degenerated_simplex = MI is_collinear(v0, v1, v2);
+
+  MI_QUALITY_COUNT_IF(degenerate_simplex, is_degenerated_simplex);
+  MI_CHECK(!is_degenerated_simplex);
+
+  const MI static_vector<MI point3d, 3> rotated_vertices =
+    MI_QUALITY_TIMED(projection, MI transfer_to_plane_z(v0, v1, v2));
 
   MI point3d vec1 = rotated_vertices[right] - rotated_vertices[mid];
   MI point3d vec2 = rotated_vertices[left] - rotated_vertices[mid];
@@ -314,17 +325,20 @@ MI_NODISCARD inline double quality(const MI point3d& v0, const MI point3d& v1, c
     {vec1.y(), vec2.y()}
   };
 
-  // Следует из определения 2.
-  MI_CHECK(dtk.determinant() > 0.);
-
+  // Модуль не скрывает вывернутый узел: базис MI transfer_to_plane_z строится по вершинам самого узла (axis_z =
+  // e1 x e2), поэтому точное значение det(D(Tk)) = |e1 x e2| > 0 при любой ориентации узла, а отрицательным его может
+  // сделать только округление у почти вырожденного узла. Знак здесь ничего не говорит о вывернутости.
   constexpr size_t m               = 2;
-  const auto       sk              = dtk * w.inverse();
-  const auto       numerator       = m * STD pow(sk.determinant(), 2. / m);
-  const auto       denominator     = sk.squared_euclidean_norm();
+  const auto       sk              = dtk * MI_QUALITY_TIMED(inverse, w.inverse());
+  const auto       sk_determinant  = STD abs(MI_QUALITY_TIMED(determinant, sk.determinant()));
+  const auto       numerator       = m * MI_QUALITY_TIMED(pow, STD pow(sk_determinant, 2. / m));
+  const auto       denominator     = MI_QUALITY_TIMED(norm, sk.squared_euclidean_norm());
   const auto       current_quality = numerator / denominator;
 
   new_quality += current_quality;
 
+  MI_QUALITY_COUNT(triangles);
+  MI_QUALITY_COUNT_IF(invalid_quality, !(new_quality > 0. && new_quality <= 1.));
   MI_CHECK(new_quality > 0. && new_quality <= 1.);
 
   return new_quality;
@@ -340,13 +354,12 @@ MI_NODISCARD double quality(const MI triangle_with<Property>& triangle, const Me
 // ---------------------------------------------------------------------------------------------------------------------
 // for quad.
 
-template<class AnyProperty, class MeshType>
-MI_NODISCARD double quality(const MI quad_with<AnyProperty>& element, const MeshType& mesh) {
-  // Если элемент будет частично или полностью вырожден в прямую, то сработает MI_CHECK, который проверяет определитель
-  // матрицы.
-  // Если элемент будет вогнутым, то алгоритм отработает без ошибок, поэтому проверим это принудительно.
-  MI_CHECK(MI internal::is_curved(element, mesh));
-
+// Качество quad по координатам вершин (в порядке обхода элемента).
+// Проверка на вогнутость (MI internal::is_curved) здесь не выполняется, это делает перегрузка для quad_with.
+MI_NODISCARD inline double quality(const MI point3d& v0,
+                                   const MI point3d& v1,
+                                   const MI point3d& v2,
+                                   const MI point3d& v3) {
   double new_quality = 0.;
 
   constexpr MI matrix2d w = {
@@ -354,15 +367,21 @@ MI_NODISCARD double quality(const MI quad_with<AnyProperty>& element, const Mesh
     {0., 1.}
   };
 
+  const MI point3d* const vertices[4] = {&v0, &v1, &v2, &v3};
+
   for (size_t n_node = 0; n_node < MI quad::n_vertices(); ++n_node) {
     const size_t mid   = MI quad::simplex_node(n_node).mid();
     const size_t left  = MI quad::simplex_node(n_node).left();
     const size_t right = MI quad::simplex_node(n_node).right();
 
+    // Как и для треугольника, действительность симплекс-узла решается точным предикатом.
+    const bool is_degenerated_simplex = MI is_collinear(*vertices[left], *vertices[mid], *vertices[right]);
+
+    MI_QUALITY_COUNT_IF(degenerate_simplex, is_degenerated_simplex);
+    MI_CHECK(!is_degenerated_simplex);
+
     const MI static_vector<MI point3d, 3> rotated_vertices =
-      MI transfer_to_plane_z(mesh.get_vertex(element.global_index(left)),
-                             mesh.get_vertex(element.global_index(mid)),
-                             mesh.get_vertex(element.global_index(right)));
+      MI_QUALITY_TIMED(projection, MI transfer_to_plane_z(*vertices[left], *vertices[mid], *vertices[right]));
 
     // Вектор от центра симплекс узла до правого края
     MI point3d v1 = rotated_vertices[2] - rotated_vertices[1];
@@ -376,13 +395,13 @@ MI_NODISCARD double quality(const MI quad_with<AnyProperty>& element, const Mesh
       {v1.y(), v2.y()}
     };
 
-    // Следует из определения 2.
-    MI_CHECK(dtk.determinant() > 0.);
-
+    // Модуль, как и для треугольника: в собственном базисе узла (MI transfer_to_plane_z) точный определитель
+    // положителен, вогнутый quad отсекает MI internal::is_curved в перегрузке для quad_with.
     constexpr size_t m               = 2;
-    const auto       sk              = dtk * w.inverse();
-    const auto       numerator       = m * STD pow(sk.determinant(), 2. / m);
-    const auto       denominator     = sk.squared_euclidean_norm();
+    const auto       sk              = dtk * MI_QUALITY_TIMED(inverse, w.inverse());
+    const auto       sk_determinant  = STD abs(MI_QUALITY_TIMED(determinant, sk.determinant()));
+    const auto       numerator       = m * MI_QUALITY_TIMED(pow, STD pow(sk_determinant, 2. / m));
+    const auto       denominator     = MI_QUALITY_TIMED(norm, sk.squared_euclidean_norm());
     const auto       current_quality = numerator / denominator;
 
     new_quality += current_quality;
@@ -390,11 +409,29 @@ MI_NODISCARD double quality(const MI quad_with<AnyProperty>& element, const Mesh
 
   new_quality /= 4.;
 
+  MI_QUALITY_COUNT(quads);
+  MI_QUALITY_COUNT_IF(invalid_quality, !(new_quality > 0. && new_quality <= 1.));
   MI_CHECK(new_quality > 0. && new_quality <= 1.);
 
   return new_quality;
 }
 
+template<class AnyProperty, class MeshType>
+MI_NODISCARD double quality(const MI quad_with<AnyProperty>& element, const MeshType& mesh) {
+  // Если элемент будет частично или полностью вырожден в прямую, то сработает MI_CHECK, который проверяет
+  // коллинеарность вершин симплекс-узла (MI is_collinear).
+  // Если элемент будет вогнутым, то алгоритм отработает без ошибок, поэтому проверим это принудительно.
+  const bool is_curved = MI internal::is_curved(element, mesh);
+
+  MI_QUALITY_COUNT_IF(not_curved_quad, !is_curved);
+  MI_CHECK(is_curved);
+
+  return quality(mesh.get_vertex(element.global_index(0)),
+                 mesh.get_vertex(element.global_index(1)),
+                 mesh.get_vertex(element.global_index(2)),
+                 mesh.get_vertex(element.global_index(3)));
+}
+
 // Качество является валидным, если quality ∈ (0.0; 1.0].
 // Качество равное 0.0 означает, что элемент не прошел проверку на валидность.
 template<class Mesh, class Element>
@@ -0,0 +1,350 @@
+﻿#pragma once
+
+#include <array>
+#include <cmath>
+
+#include "Common/MI.Check.h"
+#include "Common/MI.Predicates.h"
+#include "Container/MI.Matrix.h"
+#include "Mesh/MeshElement/MI.Quad.h"
+
+// Аналитический градиент и гессиан mean ratio quality (m = 2) для треугольников и quad.
+// ===================================================================================
+//
+// Значение совпадает с MI quality, но считается без проецирования на плоскость и обращения матриц: для симплекс-узла
+// с ребрами e1 = right - mid, e2 = left - mid и W^(-1) = | a, b; 0, d |
+//
+// Sk = (s1, s2) = (a * e1, b * e1 + d * e2),  det(Sk) = a * d * |c|,  c = e1 x e2,  F = |Sk|^2,
+// q = 2 * det(Sk) / F.
+//
+// Градиент по вершине x, для которой de1/dx = α * I, de2/dx = β * I (right: α = 1, β = 0; left: α = 0, β = 1;
+// mid: α = β = -1):
+//
+// t = β * e1 - α * e2,  n = c / |c|,
+// d ln|c| / dx = (n x t) / |c|,
+// d ln F / dx  = 2 * (a * α * s1 + (b * α + d * β) * s2) / F,
+// dq / dx      = q * (d ln|c| / dx - d ln F / dx) = q * γ.
+//
+// Блок гессиана по той же вершине:
+//
+// d2 ln|c| / dx2 = (|t|^2 * I - t * t^T) / |c|^2 - 2 * (d ln|c| / dx) * (d ln|c| / dx)^T,
+// d2 ln F / dx2  = 2 * (a^2 * α^2 + (b * α + d * β)^2) * I / F - (d ln F / dx) * (d ln F / dx)^T,
+// d2q / dx2      = q * (γ * γ^T + d2 ln|c| / dx2 - d2 ln F / dx2).
+//
+// Величины e1, e2, c, |c|, Sk и F считаются один раз на симплекс-узел и используются и для значения, и для
+// производных, поэтому значение вместе с градиентом стоит немногим дороже одного значения.
+//
+// Элемент недействителен, если нормаль c хотя бы одного симплекс-узла нулевая или смотрит против опорной нормали
+// (знак c · reference_normal определяется точно, MI orient_along).
+// По умолчанию опорная нормаль - нормаль самого элемента (MI element_normal), для плоских сеток можно передать общую.
+namespace mi {
+// Симметричная матрица 3 x 3 (блок гессиана по одной вершине).
+struct symmetric_matrix3d {
+    double xx = 0.;
+    double xy = 0.;
+    double xz = 0.;
+    double yy = 0.;
+    double yz = 0.;
+    double zz = 0.;
+
+    MI_NODISCARD MI point3d operator*(const MI point3d& v) const {
+      return {xx * v.x() + xy * v.y() + xz * v.z(),  //
+              xy * v.x() + yy * v.y() + yz * v.z(),  //
+              xz * v.x() + yz * v.y() + zz * v.z()};
+    }
+
+    // Квадратичная форма v^T * H * v.
+    MI_NODISCARD double quadratic_form(const MI point3d& v) const {
+      return v.dot(*this * v);
+    }
+
+    // H += scale * v * v^T.
+    void add_outer(const MI point3d& v, const double scale) {
+      xx += scale * v.x() * v.x();
+      xy += scale * v.x() * v.y();
+      xz += scale * v.x() * v.z();
+      yy += scale * v.y() * v.y();
+      yz += scale * v.y() * v.z();
+      zz += scale * v.z() * v.z();
+    }
+
+    // H += value * I.
+    void add_diagonal(const double value) {
+      xx += value;
+      yy += value;
+      zz += value;
+    }
+};
+
+template<size_t NodesPerElement>
+struct quality_gradient_result {
+    bool                                   is_valid = false;
+    double                                 quality  = 0.;  // 0 для недействительного элемента
+    STD array<MI point3d, NodesPerElement> gradient = {};  // Градиент по каждой вершине элемента
+};
+
+struct quality_hessian_result {
+    bool                  is_valid = false;
+    double                quality  = 0.;
+    MI point3d            gradient = {0., 0., 0.};  // Градиент по выбранной вершине
+    MI symmetric_matrix3d hessian;                  // Блок гессиана по выбранной вершине
+};
+
+// Нормаль элемента: для треугольника - нормаль его плоскости, для quad - векторное произведение диагоналей.
+template<size_t NodesPerElement>
+MI_NODISCARD MI point3d element_normal(const STD array<MI point3d, NodesPerElement>& p) {
+  static_assert(NodesPerElement == 3 || NodesPerElement == 4, "element_normal: only triangles and quads are supported");
+
+  if constexpr (NodesPerElement == 3) {
+    return (p[1] - p[0]).cross(p[2] - p[0]);
+  } else {
+    return (p[2] - p[0]).cross(p[3] - p[1]);
+  }
+}
+
+namespace internal {
+// W^(-1) весовой матрицы симплекс-узла в виде | a, b; 0, d |.
+struct mean_ratio_weights {
+    double a;
+    double b;
+    double d;
+};
+
+// (a) Triangle: w = | 1., 1. / 2.; 0., √3. / 2. |.
+constexpr mean_ratio_weights triangle_mean_ratio_weights = {1., -0.57735026918962576451, 1.15470053837925152902};
+
+// (b) Quad: w = | 1., 0.; 0., 1. |.
+constexpr mean_ratio_weights quad_mean_ratio_weights = {1., 0., 1.};
+
+// Общие для значения и производных величины симплекс-узла.
+struct simplex_terms {
+    MI point3d e1;
+    MI point3d e2;
+    MI point3d n;      // Единичная нормаль e1 x e2
+    double     area2;  // |e1 x e2|
+    MI point3d s1;
+    MI point3d s2;
+    double     f;  // |Sk|^2
+    double     quality;
+};
+
+// Возвращает false, если симплекс-узел вырожден или вывернут относительно reference_normal.
+MI_NODISCARD inline bool make_simplex_terms(const MI point3d&         left,
+                                            const MI point3d&         mid,
+                                            const MI point3d&         right,
+                                            const mean_ratio_weights& w,
+                                            const MI point3d&         reference_normal,
+                                            simplex_terms&            terms) {
+  terms.e1 = right - mid;
+  terms.e2 = left - mid;
+
+  const MI point3d c = terms.e1.cross(terms.e2);
+  terms.area2        = STD sqrt(c.squared_euclidean_norm());
+
+  // Ориентация решается точным предикатом: у почти вырожденного узла знак c · reference_normal в double может
+  // быть неверным.
+  if (!(terms.area2 > 0.) || !(MI orient_along(mid, right, left, reference_normal) > 0.)) {
+    return false;
+  }
+
+  terms.n       = c / terms.area2;
+  terms.s1      = terms.e1 * w.a;
+  terms.s2      = terms.e1 * w.b + terms.e2 * w.d;
+  terms.f       = terms.s1.squared_euclidean_norm() + terms.s2.squared_euclidean_norm();
+  terms.quality = 2. * w.a * w.d * terms.area2 / terms.f;
+
+  return true;
+}
+
+// d ln q / dx для вершины с de1/dx = alpha * I, de2/dx = beta * I.
+MI_NODISCARD inline MI point3d log_quality_gradient(const simplex_terms&      terms,
+                                                    const mean_ratio_weights& w,
+                                                    const double              alpha,
+                                                    const double              beta) {
+  const MI point3d t = terms.e1 * beta - terms.e2 * alpha;
+
+  return terms.n.cross(t) / terms.area2 - (terms.s1 * (w.a * alpha) + terms.s2 * (w.b * alpha + w.d * beta)) *
+                                            (2. / terms.f);
+}
+
+// Градиент и блок гессиана q по вершине с de1/dx = alpha * I, de2/dx = beta * I, умноженные на scale.
+inline void add_simplex_hessian(const simplex_terms&      terms,
+                                const mean_ratio_weights& w,
+                                const double              alpha,
+                                const double              beta,
+                                const double              scale,
+                                MI point3d&               gradient,
+                                MI symmetric_matrix3d&    hessian) {
+  const MI point3d t       = terms.e1 * beta - terms.e2 * alpha;
+  const MI point3d d_log_c = terms.n.cross(t) / terms.area2;
+  const double     k       = w.b * alpha + w.d * beta;
+  const MI point3d d_log_f = (terms.s1 * (w.a * alpha) + terms.s2 * k) * (2. / terms.f);
+  const MI point3d gamma   = d_log_c - d_log_f;
+
+  const double area2_sq = terms.area2 * terms.area2;
+  const double diagonal = t.squared_euclidean_norm() / area2_sq - 2. * (w.a * w.a * alpha * alpha + k * k) / terms.f;
+
+  const double s = scale * terms.quality;
+
+  hessian.add_outer(gamma, s);
+  hessian.add_outer(t, -s / area2_sq);
+  hessian.add_outer(d_log_c, -2. * s);
+  hessian.add_outer(d_log_f, s);
+  hessian.add_diagonal(s * diagonal);
+
+  gradient = gradient + gamma * s;
+}
+
+// Коэффициенты alpha, beta вершины с локальным номером n_local в симплекс-узле (left, mid, right).
+// Возвращает false, если вершина не входит в симплекс-узел.
+MI_NODISCARD inline bool simplex_role(const size_t n_local,
+                                      const size_t left,
+                                      const size_t mid,
+                                      const size_t right,
+                                      double&      alpha,
+                                      double&      beta) {
+  alpha = n_local == right ? 1. : (n_local == mid ? -1. : 0.);
+  beta  = n_local == left ? 1. : (n_local == mid ? -1. : 0.);
+
+  return n_local == left || n_local == mid || n_local == right;
+}
+
+// Обходит симплекс-узлы элемента: fn(left, mid, right, weights, scale), где scale - вес узла в качестве элемента.
+template<size_t NodesPerElement, class Fn>
+void for_each_simplex_node(Fn&& fn) {
+  static_assert(NodesPerElement == 3 || NodesPerElement == 4, "mean ratio: only triangles and quads are supported");
+
+  if constexpr (NodesPerElement == 3) {
+    fn(size_t{2}, size_t{0}, size_t{1}, triangle_mean_ratio_weights, 1.);
+  } else {
+    for (size_t n_node = 0; n_node < MI quad::n_vertices(); ++n_node) {
+      fn(MI quad::simplex_node(n_node).left(),
+         MI quad::simplex_node(n_node).mid(),
+         MI quad::simplex_node(n_node).right(),
+         quad_mean_ratio_weights,
+         1. / static_cast<double>(MI quad::n_vertices()));
+    }
+  }
+}
+}  // namespace internal
+
+// Только качество, без производных и без MI_CHECK: 0 для недействительного элемента.
+template<size_t NodesPerElement>
+MI_NODISCARD double mean_ratio_quality(const STD array<MI point3d, NodesPerElement>& p,
+                                       const MI point3d&                             reference_normal) {
+  double result   = 0.;
+  bool   is_valid = true;
+
+  internal::for_each_simplex_node<NodesPerElement>([&](const size_t                        left,
+                                                       const size_t                        mid,
+                                                       const size_t                        right,
+                                                       const internal::mean_ratio_weights& w,
+                                                       const double                        scale) {
+    internal::simplex_terms terms;
+
+    if (!is_valid || !internal::make_simplex_terms(p[left], p[mid], p[right], w, reference_normal, terms)) {
+      is_valid = false;
+
+      return;
+    }
+
+    result += scale * terms.quality;
+  });
+
+  return is_valid ? result : 0.;
+}
+
+template<size_t NodesPerElement>
+MI_NODISCARD double mean_ratio_quality(const STD array<MI point3d, NodesPerElement>& p) {
+  return mean_ratio_quality(p, element_normal(p));
+}
+
+// Качество элемента и его градиент по всем вершинам.
+template<size_t NodesPerElement>
+MI_NODISCARD quality_gradient_result<NodesPerElement> quality_gradient(const STD array<MI point3d, NodesPerElement>& p,
+                                                                       const MI point3d& reference_normal) {
+  quality_gradient_result<NodesPerElement> result;
+  result.is_valid = true;
+
+  internal::for_each_simplex_node<NodesPerElement>([&](const size_t                        left,
+                                                       const size_t                        mid,
+                                                       const size_t                        right,
+                                                       const internal::mean_ratio_weights& w,
+                                                       const double                        scale) {
+    internal::simplex_terms terms;
+
+    if (!result.is_valid || !internal::make_simplex_terms(p[left], p[mid], p[right], w, reference_normal, terms)) {
+      result.is_valid = false;
+
+      return;
+    }
+
+    const double     q       = scale * terms.quality;
+    const MI point3d d_right = internal::log_quality_gradient(terms, w, 1., 0.) * q;
+    const MI point3d d_left  = internal::log_quality_gradient(terms, w, 0., 1.) * q;
+
+    result.quality += q;
+    result.gradient[right] = result.gradient[right] + d_right;
+    result.gradient[left]  = result.gradient[left] + d_left;
+    result.gradient[mid]   = result.gradient[mid] - d_right - d_left;
+  });
+
+  if (!result.is_valid) {
+    return {};
+  }
+
+  return result;
+}
+
+template<size_t NodesPerElement>
+MI_NODISCARD quality_gradient_result<NodesPerElement> quality_gradient(
+  const STD array<MI point3d, NodesPerElement>& p) {
+  return quality_gradient(p, element_normal(p));
+}
+
+// Качество элемента, градиент и блок гессиана по вершине с локальным номером n_local.
+template<size_t NodesPerElement>
+MI_NODISCARD quality_hessian_result quality_hessian(const STD array<MI point3d, NodesPerElement>& p,
+                                                    const size_t                                  n_local,
+                                                    const MI point3d&                             reference_normal) {
+  MI_CHECK(n_local < NodesPerElement);
+
+  quality_hessian_result result;
+  result.is_valid = true;
+
+  internal::for_each_simplex_node<NodesPerElement>([&](const size_t                        left,
+                                                       const size_t                        mid,
+                                                       const size_t                        right,
+                                                       const internal::mean_ratio_weights& w,
+                                                       const double                        scale) {
+    internal::simplex_terms terms;
+
+    if (!result.is_valid || !internal::make_simplex_terms(p[left], p[mid], p[right], w, reference_normal, terms)) {
+      result.is_valid = false;
+
+      return;
+    }
+
+    result.quality += scale * terms.quality;
+
+    double alpha = 0.;
+    double beta  = 0.;
+
+    if (internal::simplex_role(n_local, left, mid, right, alpha, beta)) {
+      internal::add_simplex_hessian(terms, w, alpha, beta, scale, result.gradient, result.hessian);
+    }
+  });
+
+  if (!result.is_valid) {
+    return {};
+  }
+
+  return result;
+}
+
+template<size_t NodesPerElement>
+MI_NODISCARD quality_hessian_result quality_hessian(const STD array<MI point3d, NodesPerElement>& p,
+                                                    const size_t                                  n_local) {
+  return quality_hessian(p, n_local, element_normal(p));
+}
+}  // namespace mi
@@ -0,0 +1,143 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <array>
+
+#include "Mesh/MI.Quality.h"
+#include "Mesh/MI.QualityGradient.h"
+
+namespace mi::test {
+namespace {
+constexpr double h = 1e-5;
+
+const STD array<MI point3d, 3> triangle = {
+  {{0.1, -0.2, 0.3}, {1.3, 0.1, 0.5}, {0.4, 0.9, -0.2}}
+};
+
+const STD array<MI point3d, 4> quad = {
+  {{0., 0., 0.}, {1.2, 0.1, 0.}, {1.1, 0.9, 0.2}, {-0.1, 1.3, 0.1}}
+};
+
+template<size_t N>
+STD array<MI point3d, N> shifted(STD array<MI point3d, N> p, const size_t n_local, const MI point3d& shift) {
+  p[n_local] = p[n_local] + shift;
+
+  return p;
+}
+
+const MI point3d axes[3] = {{1., 0., 0.}, {0., 1., 0.}, {0., 0., 1.}};
+
+double component(const MI point3d& v, const size_t axis) {
+  return axis == 0 ? v.x() : (axis == 1 ? v.y() : v.z());
+}
+
+// Центральные разности градиента по значению качества.
+template<size_t N>
+void expect_gradient_matches(const STD array<MI point3d, N>& p) {
+  const MI point3d                    normal = MI element_normal(p);
+  const MI quality_gradient_result<N> result = MI quality_gradient(p, normal);
+
+  ASSERT_TRUE(result.is_valid);
+
+  for (size_t n_local = 0; n_local < N; ++n_local) {
+    for (size_t axis = 0; axis < 3; ++axis) {
+      const double plus  = MI quality_gradient(shifted(p, n_local, axes[axis] * h), normal).quality;
+      const double minus = MI quality_gradient(shifted(p, n_local, axes[axis] * -h), normal).quality;
+
+      EXPECT_NEAR(component(result.gradient[n_local], axis), (plus - minus) / (2. * h), 1e-7);
+    }
+  }
+}
+
+// Центральные разности гессиана по аналитическому градиенту.
+template<size_t N>
+void expect_hessian_matches(const STD array<MI point3d, N>& p) {
+  const MI point3d normal = MI element_normal(p);
+
+  for (size_t n_local = 0; n_local < N; ++n_local) {
+    const MI quality_hessian_result result = MI quality_hessian(p, n_local, normal);
+
+    ASSERT_TRUE(result.is_valid);
+    EXPECT_NEAR(result.quality, MI quality_gradient(p, normal).quality, 1e-14);
+
+    for (size_t axis = 0; axis < 3; ++axis) {
+      const MI point3d plus   = MI quality_hessian(shifted(p, n_local, axes[axis] * h), n_local, normal).gradient;
+      const MI point3d minus  = MI quality_hessian(shifted(p, n_local, axes[axis] * -h), n_local, normal).gradient;
+      const MI point3d column = result.hessian * axes[axis];
+
+      EXPECT_NEAR(component(result.gradient, axis),
+                  component(MI quality_gradient(p, normal).gradient[n_local], axis),
+                  1e-14);
+
+      for (size_t row = 0; row < 3; ++row) {
+        EXPECT_NEAR(component(column, row), (component(plus, row) - component(minus, row)) / (2. * h), 1e-6);
+      }
+    }
+  }
+}
+}  // namespace
+
+TEST(QualityGradient, MatchesQuality) {
+  EXPECT_NEAR(MI quality_gradient(triangle).quality, MI quality(triangle[0], triangle[1], triangle[2]), 1e-14);
+  EXPECT_NEAR(MI quality_gradient(quad).quality, MI quality(quad[0], quad[1], quad[2], quad[3]), 1e-14);
+
+  EXPECT_EQ(MI mean_ratio_quality(triangle), MI quality_gradient(triangle).quality);
+  EXPECT_EQ(MI mean_ratio_quality(quad), MI quality_gradient(quad).quality);
+}
+
+TEST(QualityGradient, IdealElementsAreStationary) {
+  const STD array<MI point3d, 3> ideal_triangle = {
+    {{0., 0., 0.}, {1., 0., 0.}, {0.5, 0.86602540378443864676, 0.}}
+  };
+  const STD array<MI point3d, 4> ideal_quad = {
+    {{0., 0., 0.}, {1., 0., 0.}, {1., 1., 0.}, {0., 1., 0.}}
+  };
+
+  const auto triangle_result = MI quality_gradient(ideal_triangle);
+  const auto quad_result     = MI quality_gradient(ideal_quad);
+
+  EXPECT_NEAR(triangle_result.quality, 1., 1e-14);
+  EXPECT_NEAR(quad_result.quality, 1., 1e-14);
+
+  for (const MI point3d& g: triangle_result.gradient) {
+    EXPECT_NEAR(g.squared_euclidean_norm(), 0., 1e-28);
+  }
+
+  for (const MI point3d& g: quad_result.gradient) {
+    EXPECT_NEAR(g.squared_euclidean_norm(), 0., 1e-28);
+  }
+}
+
+TEST(QualityGradient, TriangleGradient) {
+  expect_gradient_matches(triangle);
+}
+
+TEST(QualityGradient, QuadGradient) {
+  expect_gradient_matches(quad);
+}
+
+TEST(QualityGradient, TriangleHessian) {
+  expect_hessian_matches(triangle);
+}
+
+TEST(QualityGradient, QuadHessian) {
+  expect_hessian_matches(quad);
+}
+
+TEST(QualityGradient, InvertedElementIsInvalid) {
+  const STD array<MI point3d, 4> concave = {
+    {{0., 0., 0.}, {1., 0., 0.}, {0.2, 0.2, 0.}, {0., 1., 0.}}
+  };
+
+  const auto gradient = MI quality_gradient(concave, {0., 0., 1.});
+  const auto hessian  = MI quality_hessian(concave, 2, {0., 0., 1.});
+
+  EXPECT_FALSE(gradient.is_valid);
+  EXPECT_EQ(gradient.quality, 0.);
+  EXPECT_FALSE(hessian.is_valid);
+  EXPECT_EQ(hessian.quality, 0.);
+
+  EXPECT_FALSE(MI quality_gradient(triangle, MI element_normal(triangle) * -1.).is_valid);
+  EXPECT_EQ(MI mean_ratio_quality(concave, {0., 0., 1.}), 0.);
+}
+}  // namespace mi::test
@@ -0,0 +1,273 @@
+﻿#pragma once
+
+#include <array>
+#include <cstdint>
+#include <ostream>
+
+#include "Common/MI.Check.h"
+
+#ifndef MI_QUALITY_INSTRUMENTATION
+  #define MI_QUALITY_INSTRUMENTATION 0
+#endif
+
+#if MI_QUALITY_INSTRUMENTATION
+  #include <algorithm>
+  #include <atomic>
+  #include <chrono>
+  #include <mutex>
+  #include <vector>
+
+  #if defined(_MSC_VER)
+    #include <intrin.h>
+  #elif defined(__x86_64__) || defined(__i386__)
+    #include <x86intrin.h>
+  #endif
+#endif
+
+// Счетчики и таймеры для MI quality.
+// ==================================
+//
+// Включаются при сборке с MI_QUALITY_INSTRUMENTATION=1. Без этого макросы MI_QUALITY_COUNT, MI_QUALITY_COUNT_IF и
+// MI_QUALITY_TIMED раскрываются в пустые операторы или в само выражение и ничего не стоят.
+//
+// Каждый поток пишет только в свои счетчики (relaxed load + store, без атомарных RMW и блокировок). Набор счетчиков
+// потока регистрируется при первом обращении, а при завершении потока его значения прибавляются к общим итогам
+// завершившихся потоков и регистрация снимается. Поэтому MI quality_instrumentation::take_snapshot() учитывает
+// и завершившиеся потоки, а реестр не растет, сколько бы потоков ни создавали параллельные проходы.
+//
+// Таймеры считают такты процессора (rdtsc) на x86 и наносекунды steady_clock на остальных платформах.
+//
+// MI_QUALITY_INSTRUMENTATION задается для всей программы одинаково (определением компилятора, а не #define перед
+// включением): макросы раскрываются внутри inline-перегрузок MI quality, и при разных значениях в разных единицах
+// трансляции у них два определения, из которых компоновщик оставит любое. Разные inline namespace (enabled / disabled)
+// разделяют только take_snapshot() и reset(), от нарушения ODR в MI quality они не защищают.
+//
+// auto snapshot = MI quality_instrumentation::take_snapshot();
+// snapshot.dump(STD cout);
+namespace mi::quality_instrumentation {
+enum class counter : size_t {
+  triangles,           // Посчитано качество треугольников
+  quads,               // Посчитано качество quad
+  degenerate_simplex,  // Симплекс-узел с точно коллинеарными вершинами (MI is_collinear)
+  not_curved_quad,     // quad не прошел MI internal::is_curved
+  invalid_quality,     // Итоговое качество вне (0; 1]
+  count
+};
+
+enum class stage : size_t {
+  projection,   // MI transfer_to_plane_z
+  inverse,      // Обращение весовой матрицы
+  determinant,  // Определители D(Tk) и Sk
+  pow,          // det(Sk) ^ (2 / m)
+  norm,         // Норма Фробениуса Sk
+  count
+};
+
+constexpr size_t n_counters = static_cast<size_t>(counter::count);
+constexpr size_t n_stages   = static_cast<size_t>(stage::count);
+
+MI_NODISCARD constexpr const char* name(const counter value) {
+  constexpr const char* names[n_counters] = {"triangles", "quads", "degenerate_simplex", "not_curved_quad",
+                                             "invalid_quality"};
+
+  return names[static_cast<size_t>(value)];
+}
+
+MI_NODISCARD constexpr const char* name(const stage value) {
+  constexpr const char* names[n_stages] = {"projection", "inverse", "determinant", "pow", "norm"};
+
+  return names[static_cast<size_t>(value)];
+}
+
+// Сумма счетчиков всех потоков на момент вызова MI quality_instrumentation::take_snapshot().
+struct snapshot {
+    STD array<STD uint64_t, n_counters> counters{};
+    STD array<STD uint64_t, n_stages>   ticks{};  // Такты (или нс) по этапам
+    STD array<STD uint64_t, n_stages>   calls{};  // Количество замеров по этапам
+
+    MI_NODISCARD STD uint64_t operator[](const counter value) const {
+      return counters[static_cast<size_t>(value)];
+    }
+
+    MI_NODISCARD STD uint64_t operator[](const stage value) const {
+      return ticks[static_cast<size_t>(value)];
+    }
+
+    void dump(STD ostream& stream) const {
+      for (size_t i = 0; i < n_counters; ++i) {
+        stream << name(static_cast<counter>(i)) << ' ' << counters[i] << '\n';
+      }
+
+      for (size_t i = 0; i < n_stages; ++i) {
+        stream << name(static_cast<stage>(i)) << ".ticks " << ticks[i] << '\n';
+        stream << name(static_cast<stage>(i)) << ".calls " << calls[i] << '\n';
+      }
+    }
+};
+
+#if MI_QUALITY_INSTRUMENTATION
+
+inline namespace enabled {
+namespace internal {
+struct thread_counters {
+    STD array<STD atomic<STD uint64_t>, n_counters> counters{};
+    STD array<STD atomic<STD uint64_t>, n_stages>   ticks{};
+    STD array<STD atomic<STD uint64_t>, n_stages>   calls{};
+};
+
+// Пишет только поток-владелец, поэтому атомарный инкремент не нужен.
+inline void add(STD atomic<STD uint64_t>& value, const STD uint64_t delta) noexcept {
+  value.store(value.load(STD memory_order_relaxed) + delta, STD memory_order_relaxed);
+}
+
+struct registry {
+    STD mutex                    mutex;
+    STD vector<thread_counters*> threads;  // Счетчики работающих потоков
+    snapshot                     retired;  // Сумма счетчиков завершившихся потоков
+};
+
+MI_NODISCARD inline registry& global_registry() {
+  static registry instance;
+
+  return instance;
+}
+
+// Прибавляет значения счетчиков потока к result.
+inline void accumulate(const thread_counters& counters, snapshot& result) noexcept {
+  for (size_t i = 0; i < n_counters; ++i) {
+    result.counters[i] += counters.counters[i].load(STD memory_order_relaxed);
+  }
+
+  for (size_t i = 0; i < n_stages; ++i) {
+    result.ticks[i] += counters.ticks[i].load(STD memory_order_relaxed);
+    result.calls[i] += counters.calls[i].load(STD memory_order_relaxed);
+  }
+}
+
+// Регистрация счетчиков потока на время его жизни.
+class thread_registration {
+  public:
+    thread_registration() {
+      // Реестр создается раньше регистрации, поэтому разрушается позже нее и в главном потоке.
+      registry&                       reg = global_registry();
+      const STD lock_guard<STD mutex> lock(reg.mutex);
+      reg.threads.push_back(&_counters);
+    }
+
+    thread_registration(const thread_registration&)            = delete;
+    thread_registration& operator=(const thread_registration&) = delete;
+
+    ~thread_registration() {
+      registry&                       reg = global_registry();
+      const STD lock_guard<STD mutex> lock(reg.mutex);
+
+      accumulate(_counters, reg.retired);
+      reg.threads.erase(STD find(reg.threads.begin(), reg.threads.end(), &_counters));
+    }
+
+    MI_NODISCARD thread_counters& counters() noexcept {
+      return _counters;
+    }
+
+  private:
+    thread_counters _counters;
+};
+
+MI_NODISCARD inline thread_counters& local() {
+  thread_local thread_registration registration;
+
+  return registration.counters();
+}
+
+MI_NODISCARD inline STD uint64_t read_ticks() noexcept {
+  #if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+  return static_cast<STD uint64_t>(__rdtsc());
+  #else
+  return static_cast<STD uint64_t>(
+    STD chrono::duration_cast<STD chrono::nanoseconds>(STD chrono::steady_clock::now().time_since_epoch()).count());
+  #endif
+}
+
+inline void count(const counter value) noexcept {
+  add(local().counters[static_cast<size_t>(value)], 1);
+}
+
+template<class Fn>
+MI_NODISCARD decltype(auto) timed(const stage value, Fn&& fn) {
+  const STD uint64_t start  = read_ticks();
+  decltype(auto)     result = fn();
+  const STD uint64_t finish = read_ticks();
+
+  thread_counters& counters = local();
+  add(counters.ticks[static_cast<size_t>(value)], finish - start);
+  add(counters.calls[static_cast<size_t>(value)], 1);
+
+  return result;
+}
+}  // namespace internal
+
+MI_NODISCARD inline snapshot take_snapshot() {
+  internal::registry&             reg = internal::global_registry();
+  const STD lock_guard<STD mutex> lock(reg.mutex);
+
+  snapshot result = reg.retired;
+
+  for (const internal::thread_counters* const thread: reg.threads) {
+    internal::accumulate(*thread, result);
+  }
+
+  return result;
+}
+
+// Обнуляет счетчики. Вызывать, когда потоки не считают качество, иначе часть приращений может потеряться.
+inline void reset() {
+  internal::registry&             reg = internal::global_registry();
+  const STD lock_guard<STD mutex> lock(reg.mutex);
+
+  reg.retired = {};
+
+  for (internal::thread_counters* const thread: reg.threads) {
+    for (auto& value: thread->counters) {
+      value.store(0, STD memory_order_relaxed);
+    }
+
+    for (size_t i = 0; i < n_stages; ++i) {
+      thread->ticks[i].store(0, STD memory_order_relaxed);
+      thread->calls[i].store(0, STD memory_order_relaxed);
+    }
+  }
+}
+
+  #define MI_QUALITY_COUNT(name)                                                                                       \
+    ::mi::quality_instrumentation::internal::count(::mi::quality_instrumentation::counter::name)
+
+  #define MI_QUALITY_COUNT_IF(name, condition)                                                                         \
+    do {                                                                                                               \
+      if (condition) {                                                                                                 \
+        MI_QUALITY_COUNT(name);                                                                                        \
+      }                                                                                                                \
+    } while (false)
+
+  #define MI_QUALITY_TIMED(name, ...)                                                                                  \
+    ::mi::quality_instrumentation::internal::timed(::mi::quality_instrumentation::stage::name,                         \
+                                                   [&]() { return (__VA_ARGS__); })
+
+}  // namespace enabled
+
+#else
+
+inline namespace disabled {
+MI_NODISCARD inline snapshot take_snapshot() {
+  return {};
+}
+
+inline void reset() {
+}
+}  // namespace disabled
+
+  #define MI_QUALITY_COUNT(name)               static_cast<void>(0)
+  #define MI_QUALITY_COUNT_IF(name, condition) static_cast<void>(0)
+  #define MI_QUALITY_TIMED(name, ...)          (__VA_ARGS__)
+
+#endif
+}  // namespace mi::quality_instrumentation
@@ -0,0 +1,114 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "Mesh/MI.QualityInstrumentation.h"
+
+namespace mi::test {
+namespace {
+namespace instrumentation = MI quality_instrumentation;
+}  // namespace
+
+// Тест собирается вместе с остальной программой: со счетчиками, если она собрана с MI_QUALITY_INSTRUMENTATION=1,
+// иначе проверяется только то, что выключенные счетчики ничего не считают.
+#if MI_QUALITY_INSTRUMENTATION
+
+namespace {
+size_t n_registered_threads() {
+  instrumentation::internal::registry& reg = instrumentation::internal::global_registry();
+  const STD lock_guard<STD mutex>      lock(reg.mutex);
+
+  return reg.threads.size();
+}
+
+// Каждый из n_threads потоков считает n_counts треугольников и один замер этапа norm.
+void count_in_threads(const size_t n_threads, const size_t n_counts) {
+  STD vector<STD thread> threads;
+
+  for (size_t n_thread = 0; n_thread < n_threads; ++n_thread) {
+    threads.emplace_back([n_counts] {
+      for (size_t i = 0; i < n_counts; ++i) {
+        MI_QUALITY_COUNT(triangles);
+      }
+
+      MI_QUALITY_COUNT_IF(quads, n_counts > 0);
+      static_cast<void>(MI_QUALITY_TIMED(norm, 1.));
+    });
+  }
+
+  for (STD thread& thread: threads) {
+    thread.join();
+  }
+}
+}  // namespace
+
+TEST(QualityInstrumentation, CountsFromSeveralThreads) {
+  instrumentation::reset();
+
+  count_in_threads(8, 1000);
+
+  const instrumentation::snapshot snapshot = instrumentation::take_snapshot();
+
+  EXPECT_EQ(snapshot[instrumentation::counter::triangles], 8'000);
+  EXPECT_EQ(snapshot[instrumentation::counter::quads], 8);
+  EXPECT_EQ(snapshot[instrumentation::counter::degenerate_simplex], 0);
+  EXPECT_EQ(snapshot.calls[static_cast<size_t>(instrumentation::stage::norm)], 8);
+
+  STD ostringstream stream;
+  snapshot.dump(stream);
+
+  EXPECT_THAT(stream.str(), testing::HasSubstr("triangles 8000\n"));
+}
+
+TEST(QualityInstrumentation, ExitedThreadsAreUnregistered) {
+  const size_t n_registered = n_registered_threads();
+
+  instrumentation::reset();
+
+  for (size_t n_pass = 0; n_pass < 20; ++n_pass) {
+    count_in_threads(4, 10);
+  }
+
+  EXPECT_EQ(n_registered_threads(), n_registered);
+  EXPECT_EQ(instrumentation::take_snapshot()[instrumentation::counter::triangles], 800);
+}
+
+TEST(QualityInstrumentation, ResetClearsLiveAndExitedThreads) {
+  count_in_threads(3, 5);
+  MI_QUALITY_COUNT(triangles);
+
+  EXPECT_GT(instrumentation::take_snapshot()[instrumentation::counter::triangles], 0);
+
+  instrumentation::reset();
+
+  const instrumentation::snapshot snapshot = instrumentation::take_snapshot();
+
+  EXPECT_EQ(snapshot[instrumentation::counter::triangles], 0);
+  EXPECT_EQ(snapshot[instrumentation::counter::quads], 0);
+  EXPECT_EQ(snapshot.calls[static_cast<size_t>(instrumentation::stage::norm)], 0);
+
+  MI_QUALITY_COUNT(triangles);
+
+  EXPECT_EQ(instrumentation::take_snapshot()[instrumentation::counter::triangles], 1);
+}
+
+#else
+
+TEST(QualityInstrumentation, DisabledCountersStayZero) {
+  MI_QUALITY_COUNT(triangles);
+  MI_QUALITY_COUNT_IF(quads, true);
+
+  EXPECT_EQ(MI_QUALITY_TIMED(norm, 2.), 2.);
+
+  const instrumentation::snapshot snapshot = instrumentation::take_snapshot();
+
+  EXPECT_EQ(snapshot[instrumentation::counter::triangles], 0);
+  EXPECT_EQ(snapshot[instrumentation::counter::quads], 0);
+  EXPECT_EQ(snapshot.calls[static_cast<size_t>(instrumentation::stage::norm)], 0);
+}
+
+#endif
+}  // namespace mi::test
@@ -0,0 +1,253 @@
+﻿#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "Common/MI.Check.h"
+#include "Common/MI.ParallelFor.h"
+#include "Common/MI.Predicates.h"
+#include "Container/MI.Matrix.h"
+#include "Mesh/MI.FlatMesh.h"
+#include "Mesh/MI.QualityGradient.h"
+
+// Несколько метрик качества элементов за один проход.
+// ===================================================
+//
+// Отчеты о сетке требуют, кроме mean ratio, scaled Jacobian, минимальный и максимальный угол и отношение длин ребер.
+// Отдельный проход на каждую метрику заново читает вершины и считает ребра. evaluate_quality_metrics читает вершины
+// элемента один раз и для каждого угла i (симплекс-узел с центром в вершине i, как в MI quality) считает:
+//
+// e1 = p[i + 1] - p[i],  e2 = p[i - 1] - p[i],  c = e1 x e2,  J = c · n (n - единичная опорная нормаль),
+// |e1|^2, |e2|^2, e1 · e2.
+//
+// Из этих величин получаются все метрики:
+//
+// - mean ratio      - 2 * a * d * |c| / (a^2 * |e1|^2 + (b * e1 + d * e2)^2) с весами MI internal::mean_ratio_weights
+//                     (для треугольника - один симплекс-узел, для quad - среднее по 4), совпадает с
+//                     MI mean_ratio_quality, 0 для недействительного элемента;
+// - scaled Jacobian - min J / (|e1| * |e2|) по углам, для треугольника умножается на 2 / √3 (правильный элемент - 1),
+//                     отрицателен для вывернутого угла;
+// - min/max angle   - внутренние углы в радианах, atan2(±|c|, e1 · e2) в [0; 2π) со знаком J: у вогнутого угла quad
+//                     больше π. Модуль берется у самого угла, а не у J, иначе угол, не лежащий в плоскости n
+//                     (неплоский quad, общая нормаль на искривленной поверхности), получается меньше истинного;
+// - aspect ratio    - отношение длины наибольшего ребра к длине наименьшего.
+//
+// Выбранные метрики (quality_metric, можно объединять через |) записываются в отдельные столбцы (SoA), столбцы
+// невыбранных метрик остаются пустыми.
+//
+// Перегрузка с quality_metric_outputs пишет в столбцы вызывающего. Элемент i записывает поток куска
+// MI chunk_bounds(n_elements, n_threads), которому он принадлежит, поэтому столбцы, выделенные без обращения
+// к памяти (MI numa_vector после resize), при первой записи попадают на узел NUMA потока куска, а не загрузчика:
+//
+// MI numa_vector<double> mean_ratio;
+// mean_ratio.resize(mesh.n_elements());
+// MI evaluate_quality_metrics(mesh, {mean_ratio.data()}, normal, n_threads);
+namespace mi {
+enum class quality_metric : STD uint32_t {
+  none            = 0,
+  mean_ratio      = 1u << 0,
+  scaled_jacobian = 1u << 1,
+  min_angle       = 1u << 2,
+  max_angle       = 1u << 3,
+  aspect_ratio    = 1u << 4,
+  all             = (1u << 5) - 1,
+};
+
+MI_NODISCARD constexpr quality_metric operator|(const quality_metric left, const quality_metric right) noexcept {
+  return static_cast<quality_metric>(static_cast<STD uint32_t>(left) | static_cast<STD uint32_t>(right));
+}
+
+MI_NODISCARD constexpr bool has_metric(const quality_metric metrics, const quality_metric metric) noexcept {
+  return (static_cast<STD uint32_t>(metrics) & static_cast<STD uint32_t>(metric)) != 0;
+}
+
+// Столбцы метрик, i-е значение каждого столбца относится к элементу i.
+struct quality_metric_columns {
+    STD vector<double> mean_ratio;
+    STD vector<double> scaled_jacobian;
+    STD vector<double> min_angle;
+    STD vector<double> max_angle;
+    STD vector<double> aspect_ratio;
+};
+
+// Столбцы метрик в памяти вызывающего, каждый на n_elements значений. nullptr - метрика не нужна.
+struct quality_metric_outputs {
+    double* mean_ratio      = nullptr;
+    double* scaled_jacobian = nullptr;
+    double* min_angle       = nullptr;
+    double* max_angle       = nullptr;
+    double* aspect_ratio    = nullptr;
+
+    MI_NODISCARD quality_metric metrics() const noexcept {
+      const auto select = [](const double* const column, const quality_metric metric) {
+        return column != nullptr ? metric : quality_metric::none;
+      };
+
+      return select(mean_ratio, quality_metric::mean_ratio) |
+             select(scaled_jacobian, quality_metric::scaled_jacobian) | select(min_angle, quality_metric::min_angle) |
+             select(max_angle, quality_metric::max_angle) | select(aspect_ratio, quality_metric::aspect_ratio);
+    }
+};
+
+namespace internal {
+constexpr double pi = 3.14159265358979323846;
+
+struct element_metrics {
+    double mean_ratio      = 0.;
+    double scaled_jacobian = 0.;
+    double min_angle       = 0.;
+    double max_angle       = 0.;
+    double aspect_ratio    = 0.;
+};
+
+template<size_t NodesPerElement>
+MI_NODISCARD element_metrics fused_element_metrics(const STD array<MI point3d, NodesPerElement>& p,
+                                                   const MI point3d& reference_normal,
+                                                   const quality_metric metrics) {
+  const mean_ratio_weights& w = NodesPerElement == 3 ? triangle_mean_ratio_weights : quad_mean_ratio_weights;
+
+  // Для треугольника в mean ratio участвует только симплекс-узел вершины 0.
+  constexpr size_t n_mean_ratio_nodes = NodesPerElement == 3 ? 1 : NodesPerElement;
+
+  const bool need_mean_ratio = has_metric(metrics, quality_metric::mean_ratio);
+  const bool need_angles =
+    has_metric(metrics, quality_metric::min_angle) || has_metric(metrics, quality_metric::max_angle);
+
+  STD array<MI point3d, NodesPerElement> edges;
+  STD array<double, NodesPerElement>     lengths2;
+
+  for (size_t i = 0; i < NodesPerElement; ++i) {
+    edges[i]    = p[(i + 1) % NodesPerElement] - p[i];
+    lengths2[i] = edges[i].squared_euclidean_norm();
+  }
+
+  const double     normal_length = STD sqrt(reference_normal.squared_euclidean_norm());
+  const MI point3d n             = normal_length > 0. ? reference_normal / normal_length : reference_normal;
+
+  element_metrics result;
+  result.min_angle = 2. * pi;
+
+  double min_jacobian = STD numeric_limits<double>::max();
+  double mean_ratio   = 0.;
+  bool   is_valid     = normal_length > 0.;
+
+  for (size_t i = 0; i < NodesPerElement; ++i) {
+    const size_t     next     = (i + 1) % NodesPerElement;
+    const size_t     previous = (i + NodesPerElement - 1) % NodesPerElement;
+    const MI point3d e2       = edges[previous] * -1.;
+    const MI point3d c        = edges[i].cross(e2);
+    const double     jacobian = c.dot(n);
+    const double     e1_e2    = edges[i].dot(e2);
+
+    if (need_mean_ratio && i < n_mean_ratio_nodes && is_valid) {
+      const double area = STD sqrt(c.squared_euclidean_norm());
+      const double f    = (w.a * w.a + w.b * w.b) * lengths2[i] + 2. * w.b * w.d * e1_e2 +
+                          w.d * w.d * lengths2[previous];
+
+      is_valid = area > 0. && MI orient_along(p[i], p[next], p[previous], reference_normal) > 0.;
+      mean_ratio += 2. * w.a * w.d * area / f;
+    }
+
+    if (has_metric(metrics, quality_metric::scaled_jacobian)) {
+      const double lengths = STD sqrt(lengths2[i] * lengths2[previous]);
+
+      min_jacobian = STD min(min_jacobian, lengths > 0. ? jacobian / lengths : 0.);
+    }
+
+    if (need_angles) {
+      double angle = STD atan2(STD copysign(STD sqrt(c.squared_euclidean_norm()), jacobian), e1_e2);
+      angle        = angle < 0. ? angle + 2. * pi : angle;
+
+      result.min_angle = STD min(result.min_angle, angle);
+      result.max_angle = STD max(result.max_angle, angle);
+    }
+  }
+
+  result.mean_ratio = is_valid ? mean_ratio / static_cast<double>(n_mean_ratio_nodes) : 0.;
+
+  // 2 / √3: синус угла правильного треугольника.
+  result.scaled_jacobian = NodesPerElement == 3 ? min_jacobian * 1.15470053837925152902 : min_jacobian;
+
+  if (has_metric(metrics, quality_metric::aspect_ratio)) {
+    const auto [min_length2, max_length2] = STD minmax_element(lengths2.begin(), lengths2.end());
+
+    result.aspect_ratio =
+      *min_length2 > 0. ? STD sqrt(*max_length2 / *min_length2) : STD numeric_limits<double>::infinity();
+  }
+
+  return result;
+}
+}  // namespace internal
+
+// Метрики всех элементов сетки в столбцы output. reference_normal - общая опорная нормаль для плоских сеток,
+// нулевой вектор - нормаль каждого элемента (MI element_normal).
+template<size_t NodesPerElement>
+void evaluate_quality_metrics(const flat_mesh<NodesPerElement>& mesh,
+                              const quality_metric_outputs&     output,
+                              const MI point3d&                 reference_normal = {0., 0., 0.},
+                              const size_t                      n_threads        = MI default_thread_count()) {
+  const quality_metric metrics = output.metrics();
+
+  parallel_chunks(mesh.n_elements(), n_threads, [&](size_t, const size_t first, const size_t last) {
+    for (size_t n_element = first; n_element < last; ++n_element) {
+      const STD array<MI point3d, NodesPerElement> p = internal::gather(mesh, n_element);
+
+      const internal::element_metrics element =
+        internal::fused_element_metrics(p, internal::select_normal(p, reference_normal), metrics);
+
+      if (output.mean_ratio != nullptr) {
+        output.mean_ratio[n_element] = element.mean_ratio;
+      }
+
+      if (output.scaled_jacobian != nullptr) {
+        output.scaled_jacobian[n_element] = element.scaled_jacobian;
+      }
+
+      if (output.min_angle != nullptr) {
+        output.min_angle[n_element] = element.min_angle;
+      }
+
+      if (output.max_angle != nullptr) {
+        output.max_angle[n_element] = element.max_angle;
+      }
+
+      if (output.aspect_ratio != nullptr) {
+        output.aspect_ratio[n_element] = element.aspect_ratio;
+      }
+    }
+  });
+}
+
+// Метрики всех элементов сетки в новые столбцы. STD vector::resize заполняет их нулями в вызывающем потоке, для
+// размещения по узлам NUMA - перегрузка с quality_metric_outputs.
+template<size_t NodesPerElement>
+MI_NODISCARD quality_metric_columns evaluate_quality_metrics(const flat_mesh<NodesPerElement>& mesh,
+                                                             const quality_metric metrics = quality_metric::all,
+                                                             const MI point3d&    reference_normal = {0., 0., 0.},
+                                                             const size_t n_threads = MI default_thread_count()) {
+  quality_metric_columns result;
+  quality_metric_outputs output;
+
+  const auto allocate = [n_elements = mesh.n_elements(), metrics](
+                          STD vector<double>& column, double*& data, const quality_metric metric) {
+    if (has_metric(metrics, metric)) {
+      column.resize(n_elements);
+      data = column.data();
+    }
+  };
+
+  allocate(result.mean_ratio, output.mean_ratio, quality_metric::mean_ratio);
+  allocate(result.scaled_jacobian, output.scaled_jacobian, quality_metric::scaled_jacobian);
+  allocate(result.min_angle, output.min_angle, quality_metric::min_angle);
+  allocate(result.max_angle, output.max_angle, quality_metric::max_angle);
+  allocate(result.aspect_ratio, output.aspect_ratio, quality_metric::aspect_ratio);
+
+  evaluate_quality_metrics(mesh, output, reference_normal, n_threads);
+
+  return result;
+}
+}  // namespace mi
@@ -0,0 +1,170 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+#include "Mesh/MI.FlatMesh.h"
+#include "Mesh/MI.QualityGradient.h"
+#include "Mesh/MI.QualityMetrics.h"
+
+namespace mi::test {
+namespace {
+constexpr double pi = 3.14159265358979323846;
+
+template<size_t N>
+MI flat_mesh<N> single_element(const STD array<MI point3d, N>& p) {
+  MI flat_mesh<N> mesh;
+  mesh.vertices.assign(p.begin(), p.end());
+  mesh.elements.push_back({});
+
+  for (size_t i = 0; i < N; ++i) {
+    mesh.elements[0][i] = i;
+  }
+
+  return mesh;
+}
+}  // namespace
+
+TEST(QualityMetrics, IdealElements) {
+  const auto triangle = MI evaluate_quality_metrics(
+    single_element<3>({MI point3d{0., 0., 0.}, MI point3d{1., 0., 0.}, MI point3d{0.5, STD sqrt(3.) / 2., 0.}}));
+
+  EXPECT_NEAR(triangle.mean_ratio[0], 1., 1e-12);
+  EXPECT_NEAR(triangle.scaled_jacobian[0], 1., 1e-12);
+  EXPECT_NEAR(triangle.min_angle[0], pi / 3., 1e-12);
+  EXPECT_NEAR(triangle.max_angle[0], pi / 3., 1e-12);
+  EXPECT_NEAR(triangle.aspect_ratio[0], 1., 1e-12);
+
+  const auto quad = MI evaluate_quality_metrics(single_element<4>(
+    {MI point3d{0., 0., 0.}, MI point3d{1., 0., 0.}, MI point3d{1., 1., 0.}, MI point3d{0., 1., 0.}}));
+
+  EXPECT_DOUBLE_EQ(quad.mean_ratio[0], 1.);
+  EXPECT_DOUBLE_EQ(quad.scaled_jacobian[0], 1.);
+  EXPECT_DOUBLE_EQ(quad.min_angle[0], pi / 2.);
+  EXPECT_DOUBLE_EQ(quad.max_angle[0], pi / 2.);
+  EXPECT_DOUBLE_EQ(quad.aspect_ratio[0], 1.);
+}
+
+TEST(QualityMetrics, DistortedElements) {
+  // Прямоугольник 2 x 1 и прямоугольный треугольник.
+  const auto rectangle = MI evaluate_quality_metrics(single_element<4>(
+    {MI point3d{0., 0., 0.}, MI point3d{2., 0., 0.}, MI point3d{2., 1., 0.}, MI point3d{0., 1., 0.}}));
+
+  EXPECT_DOUBLE_EQ(rectangle.mean_ratio[0], 0.8);
+  EXPECT_DOUBLE_EQ(rectangle.scaled_jacobian[0], 1.);
+  EXPECT_DOUBLE_EQ(rectangle.aspect_ratio[0], 2.);
+
+  const auto right = MI evaluate_quality_metrics(
+    single_element<3>({MI point3d{0., 0., 0.}, MI point3d{1., 0., 0.}, MI point3d{0., 1., 0.}}));
+
+  EXPECT_NEAR(right.min_angle[0], pi / 4., 1e-12);
+  EXPECT_NEAR(right.max_angle[0], pi / 2., 1e-12);
+  EXPECT_NEAR(right.scaled_jacobian[0], STD sqrt(2.) / 2. * 2. / STD sqrt(3.), 1e-12);
+  EXPECT_NEAR(right.aspect_ratio[0], STD sqrt(2.), 1e-12);
+
+  // Вогнутый quad: один угол больше π, отрицательный scaled Jacobian, mean ratio 0.
+  const auto concave = MI evaluate_quality_metrics(
+    single_element<4>(
+      {MI point3d{0., 0., 0.}, MI point3d{2., 0., 0.}, MI point3d{0.5, 0.5, 0.}, MI point3d{0., 2., 0.}}),
+    MI quality_metric::all,
+    {0., 0., 1.});
+
+  EXPECT_EQ(concave.mean_ratio[0], 0.);
+  EXPECT_LT(concave.scaled_jacobian[0], 0.);
+  EXPECT_GT(concave.max_angle[0], pi);
+}
+
+TEST(QualityMetrics, AnglesOfNonPlanarQuad) {
+  // Вершина 2 поднята над плоскостью остальных: углы при вершинах 1, 2 и 3 не лежат в плоскости опорной нормали.
+  const STD array<MI point3d, 4> p = {
+    MI point3d{0., 0., 0.}, MI point3d{1., 0., 0.}, MI point3d{1., 1., 0.5}, MI point3d{0., 1., 0.}};
+
+  double min_angle = 2. * pi;
+  double max_angle = 0.;
+
+  for (size_t i = 0; i < 4; ++i) {
+    const MI point3d e1 = p[(i + 1) % 4] - p[i];
+    const MI point3d e2 = p[(i + 3) % 4] - p[i];
+    const double     angle = STD acos(e1.dot(e2) / STD sqrt(e1.squared_euclidean_norm() * e2.squared_euclidean_norm()));
+
+    min_angle = STD min(min_angle, angle);
+    max_angle = STD max(max_angle, angle);
+  }
+
+  for (const MI point3d& normal: {MI point3d{0., 0., 0.}, MI point3d{0., 0., 1.}}) {
+    const auto quad = MI evaluate_quality_metrics(single_element<4>(p), MI quality_metric::all, normal);
+
+    EXPECT_NEAR(quad.min_angle[0], min_angle, 1e-12);
+    EXPECT_NEAR(quad.max_angle[0], max_angle, 1e-12);
+  }
+}
+
+TEST(QualityMetrics, MatchesMeanRatioQuality) {
+  MI flat_quad_mesh mesh;
+
+  for (size_t j = 0; j <= 8; ++j) {
+    for (size_t i = 0; i <= 8; ++i) {
+      mesh.vertices.push_back({static_cast<double>(i) + 0.2 * STD sin(static_cast<double>(i * 7 + j * 3)),
+                               static_cast<double>(j) + 0.2 * STD cos(static_cast<double>(i * 5 + j)),
+                               0.1 * static_cast<double>((i + j) % 3)});
+    }
+  }
+
+  for (size_t j = 0; j < 8; ++j) {
+    for (size_t i = 0; i < 8; ++i) {
+      const size_t v00 = j * 9 + i;
+
+      mesh.elements.push_back({v00, v00 + 1, v00 + 10, v00 + 9});
+    }
+  }
+
+  const auto columns = MI evaluate_quality_metrics(mesh, MI quality_metric::mean_ratio, {0., 0., 0.}, 3);
+
+  EXPECT_TRUE(columns.scaled_jacobian.empty());
+  EXPECT_TRUE(columns.aspect_ratio.empty());
+  ASSERT_EQ(columns.mean_ratio.size(), mesh.n_elements());
+
+  for (size_t n_element = 0; n_element < mesh.n_elements(); ++n_element) {
+    EXPECT_NEAR(columns.mean_ratio[n_element], MI mean_ratio_quality(MI internal::gather(mesh, n_element)), 1e-12);
+  }
+}
+
+TEST(QualityMetrics, CallerOutputsMatchColumns) {
+  MI flat_quad_mesh mesh;
+
+  for (size_t j = 0; j <= 8; ++j) {
+    for (size_t i = 0; i <= 8; ++i) {
+      mesh.vertices.push_back({static_cast<double>(i) + 0.3 * STD sin(static_cast<double>(i * 3 + j * 7)),
+                               static_cast<double>(j) + 0.3 * STD cos(static_cast<double>(i + j * 5)),
+                               0.});
+    }
+  }
+
+  for (size_t j = 0; j < 8; ++j) {
+    for (size_t i = 0; i < 8; ++i) {
+      const size_t v00 = j * 9 + i;
+
+      mesh.elements.push_back({v00, v00 + 1, v00 + 10, v00 + 9});
+    }
+  }
+
+  const auto columns = MI evaluate_quality_metrics(mesh, MI quality_metric::all, {0., 0., 1.}, 3);
+
+  STD vector<double> mean_ratio(mesh.n_elements(), -1.);
+  STD vector<double> aspect_ratio(mesh.n_elements(), -1.);
+
+  MI quality_metric_outputs output;
+  output.mean_ratio   = mean_ratio.data();
+  output.aspect_ratio = aspect_ratio.data();
+
+  EXPECT_EQ(output.metrics(), MI quality_metric::mean_ratio | MI quality_metric::aspect_ratio);
+
+  MI evaluate_quality_metrics(mesh, output, {0., 0., 1.}, 5);
+
+  EXPECT_EQ(mean_ratio, columns.mean_ratio);
+  EXPECT_EQ(aspect_ratio, columns.aspect_ratio);
+}
+}  // namespace mi::test
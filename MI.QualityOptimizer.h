@@ -0,0 +1,399 @@
+﻿#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <vector>
+
+#include "Common/MI.Check.h"
+#include "Common/MI.ParallelFor.h"
+#include "Container/MI.Matrix.h"
+#include "Mesh/MI.FlatMesh.h"
+#include "Mesh/MI.QualityGradient.h"
+
+// Улучшение качества сетки: сначала худшие элементы.
+// ===============================================
+//
+// 1. Считается качество всех элементов, элементы кладутся в очередь с приоритетом (сверху - худший).
+// 2. Из очереди берется пачка худших элементов с качеством ниже options.target_quality.
+// 3. Пачка раскрашивается жадно: "патч" элемента - все элементы, инцидентные его свободным вершинам. Элементы с
+//    пересекающимися патчами получают разные цвета. Патчи одного цвета обрабатываются параллельно без блокировок:
+//    каждый поток читает и пишет только элементы и вершины своего патча.
+// 4. Каждая свободная вершина элемента сдвигается вдоль градиента mean ratio худшего инцидентного элемента
+//    (MI quality_hessian). Начальный шаг - максимум квадратичной модели вдоль градиента, дальше шаг делится пополам.
+//    Сдвиг принимается, только если растет минимальное качество инцидентных элементов и ни один из них не
+//    выворачивается.
+// 5. Пересчитывается качество только элементов патча, измененные патчи возвращаются в очередь. Работа заканчивается,
+//    когда в очереди не остается элементов хуже target_quality, которые еще можно улучшить.
+//
+// Элемент считается вывернутым, если нормаль хотя бы одного его симплекс-узла смотрит против опорной нормали элемента
+// (исходной нормали или options.reference_normal).
+//
+// Для криволинейных поверхностей вершина сдвигается в плоскостях инцидентных элементов, проецировать ее обратно
+// на поверхность должен вызывающий код.
+namespace mi {
+struct quality_optimizer_options {
+    double target_quality    = 0.9;   // Элементы с качеством не ниже target_quality не обрабатываются
+    size_t max_rounds        = 1000;  // Максимальное количество пачек
+    size_t batch_size        = 1024;  // Размер пачки худших элементов
+    size_t line_search_steps = 8;     // Максимальное количество делений шага пополам
+    size_t n_threads         = MI default_thread_count();
+
+    // Общая опорная нормаль для плоских сеток. Нулевой вектор - для каждого элемента используется его исходная нормаль.
+    MI point3d reference_normal = {0., 0., 0.};
+};
+
+struct quality_optimizer_result {
+    double initial_min_quality = 0.;
+    double final_min_quality   = 0.;
+    size_t n_rounds            = 0;
+    size_t n_moves             = 0;  // Количество принятых сдвигов вершин
+};
+
+namespace internal {
+template<size_t NodesPerElement>
+MI_NODISCARD size_t local_index(const flat_mesh<NodesPerElement>& mesh,
+                                const size_t                      n_element,
+                                const size_t                      n_vertex) {
+  for (size_t i = 0; i < NodesPerElement; ++i) {
+    if (mesh.elements[n_element][i] == n_vertex) {
+      return i;
+    }
+  }
+
+  MI_CHECK(false);
+
+  return NodesPerElement;
+}
+
+// Качество элемента без MI_CHECK: 0 для вырожденных и вывернутых элементов.
+template<size_t NodesPerElement>
+MI_NODISCARD double checked_quality(const flat_mesh<NodesPerElement>& mesh,
+                                    const size_t                      n_element,
+                                    const MI point3d&                 reference_normal) {
+  return MI mean_ratio_quality(gather(mesh, n_element), reference_normal);
+}
+
+struct optimizer_queue_entry {
+    double       quality;
+    size_t       n_element;
+    STD uint32_t version;
+
+    MI_NODISCARD bool operator>(const optimizer_queue_entry& other) const {
+      return quality > other.quality || (quality == other.quality && n_element > other.n_element);
+    }
+};
+
+// Состояние одного прохода оптимизатора, общее для всех потоков.
+template<size_t NodesPerElement>
+class quality_optimizer {
+  public:
+    quality_optimizer(flat_mesh<NodesPerElement>&      mesh,
+                      const STD vector<bool>&          is_free,
+                      const quality_optimizer_options& options)
+        : _mesh(mesh),
+          _is_free(is_free),
+          _options(options),
+          _vertex_elements(MI vertex_elements(mesh)),
+          _normals(mesh.n_elements()),
+          _scores(mesh.n_elements()),
+          _versions(mesh.n_elements(), 0),
+          _color_masks(mesh.n_elements(), 0) {
+      MI_CHECK(is_free.size() == mesh.n_vertices());
+
+      parallel_chunks(mesh.n_elements(),
+                      options.n_threads,
+                      [&](size_t, const size_t first, const size_t last) {
+                        for (size_t n_element = first; n_element < last; ++n_element) {
+                          _normals[n_element] = select_normal(gather(_mesh, n_element), options.reference_normal);
+                          _scores[n_element]  = checked_quality(_mesh, n_element, _normals[n_element]);
+                        }
+                      });
+    }
+
+  public:
+    MI_NODISCARD quality_optimizer_result run() {
+      quality_optimizer_result result;
+      result.initial_min_quality = min_score();
+
+      for (size_t n_element = 0; n_element < _mesh.n_elements(); ++n_element) {
+        _queue.push({_scores[n_element], n_element, 0});
+      }
+
+      STD vector<size_t>             candidates;
+      STD vector<STD vector<size_t>> patches;
+      STD vector<STD vector<size_t>> colors;
+      STD vector<size_t>             n_moves;
+
+      for (; result.n_rounds < _options.max_rounds; ++result.n_rounds) {
+        pop_candidates(candidates);
+
+        if (candidates.empty()) {
+          break;
+        }
+
+        color_candidates(candidates, patches, colors);
+
+        n_moves.assign(candidates.size(), 0);
+
+        for (const auto& color: colors) {
+          parallel_chunks(color.size(),
+                          STD min(_options.n_threads, color.size()),
+                          [&](size_t, const size_t first, const size_t last) {
+                            for (size_t i = first; i < last; ++i) {
+                              const size_t n_candidate = color[i];
+
+                              n_moves[n_candidate] = optimize_element(candidates[n_candidate]);
+
+                              for (const size_t n_element: patches[n_candidate]) {
+                                _scores[n_element] = checked_quality(_mesh, n_element, _normals[n_element]);
+                              }
+                            }
+                          });
+        }
+
+        for (size_t n_candidate = 0; n_candidate < candidates.size(); ++n_candidate) {
+          result.n_moves += n_moves[n_candidate];
+
+          for (const size_t n_element: patches[n_candidate]) {
+            _color_masks[n_element] = 0;
+
+            // Патч без сдвигов не изменился: его элементы не возвращаются в очередь, пока их не затронет сосед.
+            if (n_moves[n_candidate] != 0) {
+              _queue.push({_scores[n_element], n_element, ++_versions[n_element]});
+            }
+          }
+        }
+      }
+
+      result.final_min_quality = min_score();
+
+      return result;
+    }
+
+  private:
+    MI_NODISCARD double min_score() const {
+      double result = 1.;
+
+      for (const double score: _scores) {
+        result = STD min(result, score);
+      }
+
+      return result;
+    }
+
+    // Худшие актуальные элементы с качеством ниже целевого.
+    void pop_candidates(STD vector<size_t>& candidates) {
+      candidates.clear();
+
+      while (!_queue.empty() && candidates.size() < _options.batch_size) {
+        const optimizer_queue_entry top = _queue.top();
+
+        if (top.version != _versions[top.n_element]) {
+          _queue.pop();
+
+          continue;
+        }
+
+        if (top.quality >= _options.target_quality) {
+          break;
+        }
+
+        _queue.pop();
+
+        if (has_free_vertices(top.n_element)) {
+          candidates.push_back(top.n_element);
+        }
+      }
+    }
+
+    MI_NODISCARD bool has_free_vertices(const size_t n_element) const {
+      for (const size_t n_vertex: _mesh.elements[n_element]) {
+        if (_is_free[n_vertex]) {
+          return true;
+        }
+      }
+
+      return false;
+    }
+
+    // Жадная раскраска: кандидат получает младший цвет, не занятый ни одним элементом его патча.
+    // Кандидаты, которым не хватило 64 цветов, возвращаются в очередь до следующей пачки.
+    void color_candidates(STD vector<size_t>&              candidates,
+                          STD vector<STD vector<size_t>>&  patches,
+                          STD vector<STD vector<size_t>>&  colors) {
+      patches.assign(candidates.size(), {});
+      colors.clear();
+
+      size_t n_accepted = 0;
+
+      for (size_t n_candidate = 0; n_candidate < candidates.size(); ++n_candidate) {
+        STD vector<size_t> patch;
+
+        for (const size_t n_vertex: _mesh.elements[candidates[n_candidate]]) {
+          if (_is_free[n_vertex]) {
+            for (const size_t n_element: _vertex_elements[n_vertex]) {
+              patch.push_back(n_element);
+            }
+          }
+        }
+
+        STD sort(patch.begin(), patch.end());
+        patch.erase(STD unique(patch.begin(), patch.end()), patch.end());
+
+        STD uint64_t used = 0;
+
+        for (const size_t n_element: patch) {
+          used |= _color_masks[n_element];
+        }
+
+        if (used == ~STD uint64_t{0}) {
+          _queue.push({_scores[candidates[n_candidate]], candidates[n_candidate], _versions[candidates[n_candidate]]});
+
+          continue;
+        }
+
+        size_t color = 0;
+
+        while ((used >> color) & 1) {
+          ++color;
+        }
+
+        for (const size_t n_element: patch) {
+          _color_masks[n_element] |= STD uint64_t{1} << color;
+        }
+
+        if (colors.size() <= color) {
+          colors.resize(color + 1);
+        }
+
+        colors[color].push_back(n_accepted);
+        candidates[n_accepted] = candidates[n_candidate];
+        patches[n_accepted]    = STD move(patch);
+        ++n_accepted;
+      }
+
+      candidates.resize(n_accepted);
+      patches.resize(n_accepted);
+    }
+
+    // Минимальное качество инцидентных вершине элементов.
+    MI_NODISCARD double vertex_min_quality(const size_t n_vertex) const {
+      double min_quality = 1.;
+
+      for (const size_t n_element: _vertex_elements[n_vertex]) {
+        min_quality = STD min(min_quality, checked_quality(_mesh, n_element, _normals[n_element]));
+      }
+
+      return min_quality;
+    }
+
+    // Качество, градиент и блок гессиана худшего инцидентного вершине элемента по этой вершине.
+    MI_NODISCARD quality_hessian_result worst_element_hessian(const size_t n_vertex) const {
+      quality_hessian_result worst;
+      worst.quality = 2.;
+
+      for (const size_t n_element: _vertex_elements[n_vertex]) {
+        const quality_hessian_result element = MI quality_hessian(gather(_mesh, n_element),
+                                                                  local_index(_mesh, n_element, n_vertex),
+                                                                  _normals[n_element]);
+
+        if (element.quality < worst.quality) {
+          worst = element;
+        }
+      }
+
+      return worst;
+    }
+
+    // Характерный размер окрестности вершины: средняя длина инцидентных ребер.
+    MI_NODISCARD double vertex_scale(const size_t n_vertex) const {
+      double sum     = 0.;
+      size_t n_edges = 0;
+
+      for (const size_t n_element: _vertex_elements[n_vertex]) {
+        for (const size_t n_other: _mesh.elements[n_element]) {
+          if (n_other != n_vertex) {
+            sum += STD sqrt((_mesh.vertices[n_other] - _mesh.vertices[n_vertex]).squared_euclidean_norm());
+            ++n_edges;
+          }
+        }
+      }
+
+      return n_edges == 0 ? 0. : sum / static_cast<double>(n_edges);
+    }
+
+    // Сдвигает свободные вершины элемента, возвращает количество принятых сдвигов.
+    MI_NODISCARD size_t optimize_element(const size_t n_element) {
+      size_t n_moves = 0;
+
+      for (const size_t n_vertex: _mesh.elements[n_element]) {
+        if (!_is_free[n_vertex]) {
+          continue;
+        }
+
+        const quality_hessian_result worst = worst_element_hessian(n_vertex);
+        const double                 norm  = STD sqrt(worst.gradient.squared_euclidean_norm());
+
+        if (!worst.is_valid || !(norm > 0.)) {
+          continue;
+        }
+
+        const MI point3d origin    = _mesh.vertices[n_vertex];
+        const MI point3d direction = worst.gradient / norm;
+
+        // Начальный шаг - максимум квадратичной модели качества вдоль градиента, но не больше половины
+        // характерного размера окрестности.
+        const double curvature = worst.hessian.quadratic_form(direction);
+        const double max_step  = 0.5 * vertex_scale(n_vertex);
+
+        double step  = curvature < 0. ? STD min(norm / -curvature, max_step) : max_step;
+        bool   moved = false;
+
+        for (size_t n_step = 0; n_step < _options.line_search_steps && !moved; ++n_step, step *= 0.5) {
+          _mesh.vertices[n_vertex] = origin + direction * step;
+
+          moved = vertex_min_quality(n_vertex) > worst.quality;
+        }
+
+        if (moved) {
+          ++n_moves;
+        } else {
+          _mesh.vertices[n_vertex] = origin;
+        }
+      }
+
+      return n_moves;
+    }
+
+  private:
+    flat_mesh<NodesPerElement>&      _mesh;
+    const STD vector<bool>&          _is_free;
+    const quality_optimizer_options& _options;
+
+    const MI ragged_array<size_t> _vertex_elements;  // Элементы, инцидентные вершине
+
+    STD vector<MI point3d>     _normals;      // Опорные нормали элементов
+    STD vector<double>         _scores;       // Текущее качество элементов
+    STD vector<STD uint32_t>   _versions;     // Версии для ленивого удаления устаревших записей очереди
+    STD vector<STD uint64_t>   _color_masks;  // Цвета патчей текущей пачки, в которые входит элемент
+
+    STD priority_queue<optimizer_queue_entry, STD vector<optimizer_queue_entry>, STD greater<optimizer_queue_entry>>
+      _queue;
+};
+}  // namespace internal
+
+// Улучшает качество элементов сетки, сдвигая вершины, для которых is_free[n_vertex] == true.
+// Связность сетки не меняется. Для фиксации границы можно передать инверсию MI boundary_vertices(mesh).
+template<size_t NodesPerElement>
+quality_optimizer_result optimize_quality(flat_mesh<NodesPerElement>&      mesh,
+                                          const STD vector<bool>&          is_free,
+                                          const quality_optimizer_options& options = {}) {
+  internal::quality_optimizer<NodesPerElement> optimizer(mesh, is_free, options);
+
+  return optimizer.run();
+}
+}  // namespace mi
@@ -0,0 +1,82 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "Mesh/MI.FlatMesh.h"
+#include "Mesh/MI.MeshTestUtil.h"
+#include "Mesh/MI.QualityOptimizer.h"
+
+namespace mi::test {
+namespace {
+// Решетка n x n ячеек в плоскости z = 0 со сдвинутыми внутренними вершинами.
+template<size_t NodesPerElement>
+MI flat_mesh<NodesPerElement> jittered_grid(const size_t n, const double jitter) {
+  grid_options options;
+  options.jitter = jitter;
+  options.seed   = 42;
+
+  return make_grid<NodesPerElement>(n, options);
+}
+
+template<size_t NodesPerElement>
+double min_quality(const MI flat_mesh<NodesPerElement>& mesh) {
+  double result = 1.;
+
+  for (size_t n_element = 0; n_element < mesh.n_elements(); ++n_element) {
+    result = STD min(result, MI element_quality(mesh, n_element));
+  }
+
+  return result;
+}
+
+template<size_t NodesPerElement>
+STD vector<bool> inner_vertices(const MI flat_mesh<NodesPerElement>& mesh) {
+  STD vector<bool> is_free = MI boundary_vertices(mesh);
+  is_free.flip();
+
+  return is_free;
+}
+
+template<size_t NodesPerElement>
+void expect_improved(MI flat_mesh<NodesPerElement> mesh) {
+  const MI flat_mesh<NodesPerElement> original = mesh;
+  const STD vector<bool>               is_free  = inner_vertices(mesh);
+
+  MI quality_optimizer_options options;
+  options.n_threads = 4;
+
+  const MI quality_optimizer_result result = MI optimize_quality(mesh, is_free, options);
+
+  EXPECT_NEAR(result.initial_min_quality, min_quality(original), 1e-12);
+  EXPECT_NEAR(result.final_min_quality, min_quality(mesh), 1e-12);
+  EXPECT_GT(result.final_min_quality, result.initial_min_quality);
+  EXPECT_GT(result.n_moves, 0);
+
+  for (size_t n_vertex = 0; n_vertex < mesh.n_vertices(); ++n_vertex) {
+    if (!is_free[n_vertex]) {
+      EXPECT_EQ(mesh.vertices[n_vertex], original.vertices[n_vertex]);
+    }
+  }
+}
+}  // namespace
+
+TEST(QualityOptimizer, ImprovesTriangleGrid) {
+  expect_improved(jittered_grid<3>(16, 0.35));
+}
+
+TEST(QualityOptimizer, ImprovesQuadGrid) {
+  expect_improved(jittered_grid<4>(16, 0.25));
+}
+
+TEST(QualityOptimizer, FixedVerticesAreNotMoved) {
+  MI flat_quad_mesh mesh    = jittered_grid<4>(4, 0.3);
+  const auto        initial = mesh;
+
+  const MI quality_optimizer_result result = MI optimize_quality(mesh, STD vector<bool>(mesh.n_vertices(), false));
+
+  EXPECT_EQ(result.n_moves, 0);
+  EXPECT_EQ(result.initial_min_quality, result.final_min_quality);
+  EXPECT_EQ(mesh.vertices, initial.vertices);
+}
+}  // namespace mi::test
@@ -0,0 +1,147 @@
+﻿#pragma once
+
+#include "Common/MI.Check.h"
+
+#if MI_CPP_VERSION == 20
+  #include <algorithm>
+  #include <cstdint>
+  #include <latch>
+  #include <optional>
+  #include <vector>
+
+  #include "Common/MI.Coroutine.h"
+  #include "Mesh/MI.FlatMeshFile.h"
+  #include "Mesh/MI.QualityStream.h"
+
+// Асинхронная проверка качества сетки из файла: загрузка блоков идет одновременно с вычислением.
+// ============================================================================================
+//
+// MI stream_quality читает элементы в тех же потоках, что считают качество: пока страница блока читается с диска,
+// поток простаивает. Здесь чтение и вычисление разделены:
+//
+// - сопрограмма-загрузчик в отдельном потоке подгружает блок элементов (MI mapped_file::load) и кладет его номер
+//   в очередь,
+// - options.n_threads сопрограмм-вычислителей забирают блоки из очереди и считают их качество
+//   (MI internal::stream_quality_block).
+//
+// Очередь ограничена options.queue_capacity блоками: загрузчик опережает вычислители не больше чем на столько блоков
+// и приостанавливается, когда очередь заполнена, поэтому в памяти не накапливаются прочитанные, но не
+// обработанные блоки. Пока вычислители заняты, следующий блок уже читается, и при достаточной емкости очереди
+// ожидание диска полностью скрыто за вычислением.
+//
+// Результат совпадает с MI stream_quality при тех же параметрах и не зависит от количества потоков.
+namespace mi {
+struct quality_pipeline_options : quality_stream_options {
+    size_t queue_capacity = 4;  // Сколько загруженных блоков может ждать обработки
+};
+
+namespace internal {
+struct quality_pipeline_block {
+    size_t n_block = 0;
+    size_t first   = 0;
+    size_t last    = 0;
+};
+
+template<size_t NodesPerElement>
+struct quality_pipeline_state {
+    const mapped_flat_mesh<NodesPerElement>&        mesh;
+    const quality_pipeline_options&                 options;
+    MI coroutine_pool&                              io_pool;
+    MI coroutine_pool&                              compute_pool;
+    MI async_bounded_queue<quality_pipeline_block>& queue;
+    STD latch&                                      done;
+
+    STD vector<quality_block_stats>&      blocks;
+    STD vector<STD vector<STD uint64_t>>& failed;  // По блокам
+};
+
+template<size_t NodesPerElement>
+MI detached_task load_quality_blocks(quality_pipeline_state<NodesPerElement>& state) {
+  co_await state.io_pool.schedule();
+
+  const size_t n_elements = state.mesh.n_elements();
+
+  for (size_t n_block = 0; n_block < state.blocks.size(); ++n_block) {
+    const size_t first = n_block * state.options.block_size;
+    const size_t last  = STD min(first + state.options.block_size, n_elements);
+
+    const size_t offset = state.mesh.element_offset(first);
+    state.mesh.file().load(offset, state.mesh.element_offset(last) - offset);
+
+    co_await state.queue.push({n_block, first, last}, state.io_pool);
+  }
+
+  state.queue.close();
+  state.done.count_down();
+}
+
+template<size_t NodesPerElement>
+MI detached_task compute_quality_blocks(quality_pipeline_state<NodesPerElement>& state) {
+  co_await state.compute_pool.schedule();
+
+  while (const STD optional<quality_pipeline_block> block = co_await state.queue.pop(state.compute_pool)) {
+    stream_quality_block(state.mesh,
+                         state.options,
+                         block->first,
+                         block->last,
+                         state.blocks[block->n_block],
+                         state.failed[block->n_block]);
+
+    if (state.options.release_blocks) {
+      const size_t offset = state.mesh.element_offset(block->first);
+      state.mesh.file().release(offset, state.mesh.element_offset(block->last) - offset);
+    }
+  }
+
+  state.done.count_down();
+}
+}  // namespace internal
+
+template<size_t NodesPerElement>
+MI_NODISCARD quality_stream_result pipeline_quality(const mapped_flat_mesh<NodesPerElement>& mesh,
+                                                    const quality_pipeline_options&          options = {}) {
+  MI_CHECK(mesh.is_open());
+  MI_CHECK(options.block_size > 0);
+
+  const size_t n_elements = mesh.n_elements();
+  const size_t n_blocks   = (n_elements + options.block_size - 1) / options.block_size;
+  const size_t n_workers  = STD max(STD min(options.n_threads, n_blocks), size_t{1});
+
+  quality_stream_result result;
+  result.blocks.resize(n_blocks);
+
+  STD vector<STD vector<STD uint64_t>> failed(n_blocks);
+
+  mesh.file().advise_sequential();
+
+  {
+    // Порядок объявлений важен: пулы разрушаются (дожидаясь своих потоков) раньше latch и очереди.
+    STD latch                                                done(static_cast<STD ptrdiff_t>(n_workers + 1));
+    MI async_bounded_queue<internal::quality_pipeline_block> queue(STD max(options.queue_capacity, size_t{1}));
+    MI coroutine_pool                                        io_pool(1);
+    MI coroutine_pool                                        compute_pool(n_workers);
+
+    internal::quality_pipeline_state<NodesPerElement> state{
+      mesh, options, io_pool, compute_pool, queue, done, result.blocks, failed};
+
+    internal::load_quality_blocks(state);
+
+    for (size_t i = 0; i < n_workers; ++i) {
+      internal::compute_quality_blocks(state);
+    }
+
+    done.wait();
+  }
+
+  for (const quality_block_stats& block: result.blocks) {
+    internal::merge(result.total, block);
+  }
+
+  for (const auto& local: failed) {
+    result.failed_elements.insert(result.failed_elements.end(), local.begin(), local.end());
+  }
+
+  return result;
+}
+}  // namespace mi
+#endif
@@ -0,0 +1,100 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "Common/MI.Check.h"
+
+#if MI_CPP_VERSION == 20
+  #include <cstdio>
+  #include <string>
+
+  #include "Mesh/MI.FlatMeshFile.h"
+  #include "Mesh/MI.MeshTestUtil.h"
+  #include "Mesh/MI.QualityPipeline.h"
+  #include "Mesh/MI.QualityStream.h"
+
+namespace mi::test {
+namespace {
+// Решетка n x n quad в плоскости z = 0 с одним вывернутым элементом (номер 3).
+MI flat_quad_mesh grid_with_inverted(const size_t n) {
+  grid_options options;
+  options.jitter = 0.05;
+
+  MI flat_quad_mesh mesh = make_grid(n, options);
+  STD swap(mesh.elements[3][1], mesh.elements[3][3]);
+
+  return mesh;
+}
+
+class QualityPipeline : public testing::Test {
+  protected:
+    void SetUp() override {
+      _path = testing::TempDir() + "mi_quality_pipeline.bin";
+    }
+
+    void TearDown() override {
+      STD remove(_path.c_str());
+    }
+
+  protected:
+    STD string _path;
+};
+}  // namespace
+
+TEST_F(QualityPipeline, MatchesStreamQuality) {
+  const MI flat_quad_mesh mesh = grid_with_inverted(40);
+
+  ASSERT_TRUE(MI write_flat_mesh(_path, mesh));
+
+  MI mapped_flat_mesh<4> mapped;
+  ASSERT_TRUE(mapped.open(_path));
+
+  MI quality_pipeline_options options;
+  options.block_size       = 37;
+  options.min_quality      = 0.9;
+  options.reference_normal = {0., 0., 1.};
+
+  const MI quality_stream_result expected = MI stream_quality(mapped, options);
+
+  ASSERT_THAT(expected.failed_elements, testing::Contains(3));
+
+  for (const size_t n_threads: {1, 2, 7}) {
+    for (const size_t queue_capacity: {1, 3, 64}) {
+      options.n_threads      = n_threads;
+      options.queue_capacity = queue_capacity;
+
+      const MI quality_stream_result result = MI pipeline_quality(mapped, options);
+
+      ASSERT_EQ(result.blocks.size(), expected.blocks.size());
+      EXPECT_EQ(result.failed_elements, expected.failed_elements);
+      EXPECT_EQ(result.total.n_elements, mesh.n_elements());
+      EXPECT_EQ(result.total.n_failed, expected.total.n_failed);
+      EXPECT_EQ(result.total.min_quality, expected.total.min_quality);
+      EXPECT_EQ(result.total.max_quality, expected.total.max_quality);
+
+      for (size_t n_block = 0; n_block < result.blocks.size(); ++n_block) {
+        EXPECT_EQ(result.blocks[n_block].first_element, expected.blocks[n_block].first_element);
+        EXPECT_EQ(result.blocks[n_block].sum_quality, expected.blocks[n_block].sum_quality);
+      }
+    }
+  }
+}
+
+TEST_F(QualityPipeline, SingleBlock) {
+  const MI flat_quad_mesh mesh = grid_with_inverted(3);
+
+  ASSERT_TRUE(MI write_flat_mesh(_path, mesh));
+
+  MI mapped_flat_mesh<4> mapped;
+  ASSERT_TRUE(mapped.open(_path));
+
+  MI quality_pipeline_options options;
+  options.reference_normal = {0., 0., 1.};
+
+  const MI quality_stream_result result = MI pipeline_quality(mapped, options);
+
+  ASSERT_EQ(result.blocks.size(), 1);
+  EXPECT_THAT(result.failed_elements, testing::ElementsAre(3));
+  EXPECT_EQ(result.total.n_elements, 9);
+}
+}  // namespace mi::test
+#endif
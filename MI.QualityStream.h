@@ -0,0 +1,170 @@
+﻿#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#if defined(_MSC_VER)
+  #include <intrin.h>
+#endif
+
+#include "Common/MI.Check.h"
+#include "Common/MI.ParallelFor.h"
+#include "Container/MI.Matrix.h"
+#include "Mesh/MI.FlatMeshFile.h"
+#include "Mesh/MI.QualityGradient.h"
+
+// Потоковая проверка качества сетки из файла, отображенного в память.
+// ===================================================================
+//
+// Элементы обходятся блоками по options.block_size. Блоки делятся между потоками непрерывными кусками
+// (MI parallel_chunks), каждый поток идет по своим блокам последовательно и заранее подгружает вершины элемента,
+// который будет обработан через options.prefetch_distance элементов. После обработки блока его элементы отдаются
+// системе (MI mapped_file::release), поэтому в памяти одновременно находятся только вершины и текущие блоки
+// элементов каждого потока.
+//
+// Для каждого блока считается статистика, номера непрошедших элементов собираются по возрастанию. Результат
+// не зависит от количества потоков.
+//
+// Элемент не проходит проверку, если его качество (MI mean_ratio_quality) меньше options.min_quality, если он
+// недействителен (качество 0) или если хотя бы один индекс вершины выходит за пределы файла.
+namespace mi {
+struct quality_stream_options {
+    size_t block_size        = size_t{1} << 16;
+    size_t prefetch_distance = 8;
+    double min_quality       = 0.;    // Элементы с качеством меньше min_quality не проходят проверку
+    size_t n_threads         = MI default_thread_count();
+    bool   release_blocks    = true;  // Отдавать страницы обработанных блоков системе
+
+    // Общая опорная нормаль для плоских сеток. Нулевой вектор - нормаль каждого элемента (вывернутые элементы
+    // не обнаруживаются).
+    MI point3d reference_normal = {0., 0., 0.};
+};
+
+struct quality_block_stats {
+    size_t first_element = 0;
+    size_t n_elements    = 0;
+    size_t n_failed      = 0;
+    double min_quality   = 1.;
+    double max_quality   = 0.;
+    double sum_quality   = 0.;
+
+    MI_NODISCARD double mean_quality() const noexcept {
+      return n_elements == 0 ? 0. : sum_quality / static_cast<double>(n_elements);
+    }
+};
+
+struct quality_stream_result {
+    STD vector<quality_block_stats> blocks;
+    STD vector<STD uint64_t>        failed_elements;  // По возрастанию
+    quality_block_stats             total;
+};
+
+namespace internal {
+inline void prefetch(const void* address) noexcept {
+#if defined(_MSC_VER)
+  _mm_prefetch(static_cast<const char*>(address), _MM_HINT_T0);
+#elif defined(__GNUC__)
+  __builtin_prefetch(address);
+#else
+  static_cast<void>(address);
+#endif
+}
+
+inline void merge(quality_block_stats& to, const quality_block_stats& from) noexcept {
+  to.n_elements += from.n_elements;
+  to.n_failed += from.n_failed;
+  to.min_quality = STD min(to.min_quality, from.min_quality);
+  to.max_quality = STD max(to.max_quality, from.max_quality);
+  to.sum_quality += from.sum_quality;
+}
+
+template<size_t NodesPerElement>
+void stream_quality_block(const mapped_flat_mesh<NodesPerElement>& mesh,
+                          const quality_stream_options&            options,
+                          const size_t                             first,
+                          const size_t                             last,
+                          quality_block_stats&                     stats,
+                          STD vector<STD uint64_t>&                failed) {
+  const size_t n_vertices = mesh.n_vertices();
+
+  stats.first_element = first;
+  stats.n_elements    = last - first;
+
+  for (size_t n_element = first; n_element < last; ++n_element) {
+    if (n_element + options.prefetch_distance < last) {
+      for (const STD uint64_t n_vertex: mesh.element(n_element + options.prefetch_distance)) {
+        if (n_vertex < n_vertices) {
+          prefetch(mesh.vertex_data(static_cast<size_t>(n_vertex)));
+        }
+      }
+    }
+
+    const auto& element = mesh.element(n_element);
+
+    STD array<MI point3d, NodesPerElement> p;
+    bool                                   is_indexed = true;
+
+    for (size_t i = 0; i < NodesPerElement; ++i) {
+      is_indexed = is_indexed && element[i] < n_vertices;
+      p[i]       = is_indexed ? mesh.get_vertex(static_cast<size_t>(element[i])) : MI point3d{0., 0., 0.};
+    }
+
+    const double quality =
+      is_indexed ? MI mean_ratio_quality(p, internal::select_normal(p, options.reference_normal)) : 0.;
+
+    stats.min_quality = STD min(stats.min_quality, quality);
+    stats.max_quality = STD max(stats.max_quality, quality);
+    stats.sum_quality += quality;
+
+    if (!(quality > 0.) || quality < options.min_quality) {
+      ++stats.n_failed;
+      failed.push_back(n_element);
+    }
+  }
+}
+}  // namespace internal
+
+template<size_t NodesPerElement>
+MI_NODISCARD quality_stream_result stream_quality(const mapped_flat_mesh<NodesPerElement>& mesh,
+                                                  const quality_stream_options&            options = {}) {
+  MI_CHECK(mesh.is_open());
+  MI_CHECK(options.block_size > 0);
+
+  const size_t n_elements = mesh.n_elements();
+  const size_t n_blocks   = (n_elements + options.block_size - 1) / options.block_size;
+  const size_t n_threads  = STD max(STD min(options.n_threads, n_blocks), size_t{1});
+
+  quality_stream_result result;
+  result.blocks.resize(n_blocks);
+
+  STD vector<STD vector<STD uint64_t>> failed(n_threads);
+
+  mesh.file().advise_sequential();
+
+  parallel_chunks(n_blocks, n_threads, [&](const size_t n_chunk, const size_t first_block, const size_t last_block) {
+    for (size_t n_block = first_block; n_block < last_block; ++n_block) {
+      const size_t first = n_block * options.block_size;
+      const size_t last  = STD min(first + options.block_size, n_elements);
+
+      internal::stream_quality_block(mesh, options, first, last, result.blocks[n_block], failed[n_chunk]);
+
+      if (options.release_blocks) {
+        mesh.file().release(mesh.element_offset(first), mesh.element_offset(last) - mesh.element_offset(first));
+      }
+    }
+  });
+
+  for (const quality_block_stats& block: result.blocks) {
+    internal::merge(result.total, block);
+  }
+
+  // Куски идут по возрастанию номеров блоков, поэтому склейка сохраняет порядок элементов.
+  for (const auto& local: failed) {
+    result.failed_elements.insert(result.failed_elements.end(), local.begin(), local.end());
+  }
+
+  return result;
+}
+}  // namespace mi
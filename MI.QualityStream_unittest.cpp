@@ -0,0 +1,177 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <string>
+
+#include "Mesh/MI.FlatMeshFile.h"
+#include "Mesh/MI.MeshTestUtil.h"
+#include "Mesh/MI.QualityStream.h"
+
+namespace mi::test {
+namespace {
+// Решетка n x n quad в плоскости z = 0 с одним вывернутым элементом (номер 5) и одним битым индексом (номер 7).
+MI flat_quad_mesh broken_grid(const size_t n) {
+  grid_options options;
+  options.jitter = 0.01;
+
+  MI flat_quad_mesh mesh = make_grid(n, options);
+  STD swap(mesh.elements[5][1], mesh.elements[5][3]);
+  mesh.elements[7][2] = mesh.n_vertices() + 100;
+
+  return mesh;
+}
+
+class QualityStream : public testing::Test {
+  protected:
+    void SetUp() override {
+      _path = testing::TempDir() + "mi_quality_stream.bin";
+    }
+
+    void TearDown() override {
+      STD remove(_path.c_str());
+    }
+
+  protected:
+    STD string _path;
+};
+}  // namespace
+
+TEST_F(QualityStream, WriteAndMap) {
+  const MI flat_quad_mesh mesh = broken_grid(4);
+
+  ASSERT_TRUE(MI write_flat_mesh(_path, mesh));
+
+  MI mapped_flat_mesh<4> mapped;
+
+  ASSERT_TRUE(mapped.open(_path));
+  ASSERT_EQ(mapped.n_vertices(), mesh.n_vertices());
+  ASSERT_EQ(mapped.n_elements(), mesh.n_elements());
+
+  for (size_t n_vertex = 0; n_vertex < mesh.n_vertices(); ++n_vertex) {
+    EXPECT_EQ(mapped.get_vertex(n_vertex), mesh.vertices[n_vertex]);
+  }
+
+  for (size_t n_element = 0; n_element < mesh.n_elements(); ++n_element) {
+    EXPECT_THAT(mapped.element(n_element), testing::ElementsAreArray(mesh.elements[n_element]));
+  }
+
+  // Другой тип элементов.
+  MI mapped_flat_mesh<3> triangles;
+  EXPECT_FALSE(triangles.open(_path));
+}
+
+TEST_F(QualityStream, RejectsTruncatedFile) {
+  ASSERT_TRUE(MI write_flat_mesh(_path, broken_grid(3)));
+
+  {
+    STD ofstream stream(_path, STD ios::binary | STD ios::app);
+    stream.put('x');
+  }
+
+  MI mapped_flat_mesh<4> mapped;
+
+  EXPECT_FALSE(mapped.open(_path));
+  EXPECT_FALSE(mapped.open(_path + ".missing"));
+}
+
+TEST_F(QualityStream, RejectsForgedHeader) {
+  const MI flat_quad_mesh mesh = broken_grid(3);
+
+  ASSERT_TRUE(MI write_flat_mesh(_path, mesh));
+
+  const auto forge = [this](const STD uint64_t n_vertices, const STD uint64_t n_elements) {
+    STD fstream stream(_path, STD ios::binary | STD ios::in | STD ios::out);
+
+    MI flat_mesh_file_header header;
+    stream.read(reinterpret_cast<char*>(&header), sizeof(header));
+
+    header.n_vertices = n_vertices;
+    header.n_elements = n_elements;
+
+    stream.seekp(0);
+    stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  };
+
+  MI mapped_flat_mesh<4> mapped;
+
+  // 24 * 2^61 = 3 * 2^64: без проверки делением размер массива вершин переполняется до прежнего и совпадает
+  // с размером файла.
+  forge(mesh.n_vertices() + (STD uint64_t{1} << 61), mesh.n_elements());
+  EXPECT_FALSE(mapped.open(_path));
+
+  // 32 * 2^59 = 2^64.
+  forge(mesh.n_vertices(), mesh.n_elements() + (STD uint64_t{1} << 59));
+  EXPECT_FALSE(mapped.open(_path));
+
+  forge(mesh.n_vertices(), mesh.n_elements());
+  EXPECT_TRUE(mapped.open(_path));
+}
+
+TEST_F(QualityStream, LoadAndReleaseRanges) {
+  ASSERT_TRUE(MI write_flat_mesh(_path, broken_grid(3)));
+
+  MI mapped_file file;
+  ASSERT_TRUE(file.open(_path));
+
+  // Пустые диапазоны, в том числе в начале файла, ничего не читают.
+  file.load(0, 0);
+  file.load(file.size() - 1, 0);
+
+  // Диапазоны за концом файла и с переполнением offset + size обрезаются по размеру файла.
+  file.load(file.size() - 1, STD numeric_limits<size_t>::max());
+  file.load(file.size(), 1);
+  file.release(1, STD numeric_limits<size_t>::max());
+
+  MI mapped_flat_mesh<4> mapped;
+  ASSERT_TRUE(mapped.open(_path));
+  EXPECT_EQ(mapped.n_elements(), 9);
+}
+
+TEST_F(QualityStream, StatisticsAndFailedElements) {
+  const MI flat_quad_mesh mesh = broken_grid(8);
+
+  ASSERT_TRUE(MI write_flat_mesh(_path, mesh));
+
+  MI mapped_flat_mesh<4> mapped;
+  ASSERT_TRUE(mapped.open(_path));
+
+  MI quality_stream_options options;
+  options.block_size       = 5;
+  options.reference_normal = {0., 0., 1.};
+
+  for (const size_t n_threads: {1, 3, 16}) {
+    options.n_threads = n_threads;
+
+    const MI quality_stream_result result = MI stream_quality(mapped, options);
+
+    ASSERT_EQ(result.blocks.size(), (mesh.n_elements() + 4) / 5);
+    EXPECT_THAT(result.failed_elements, testing::ElementsAre(5, 7));
+    EXPECT_EQ(result.total.n_elements, mesh.n_elements());
+    EXPECT_EQ(result.total.n_failed, 2);
+    EXPECT_EQ(result.total.min_quality, 0.);
+
+    EXPECT_EQ(result.blocks[1].first_element, 5);
+    EXPECT_EQ(result.blocks[1].n_failed, 2);
+    EXPECT_EQ(result.blocks.back().n_elements, mesh.n_elements() % 5);
+
+    double sum = 0.;
+
+    for (size_t n_element = 0; n_element < mesh.n_elements(); ++n_element) {
+      if (n_element != 5 && n_element != 7) {
+        sum += MI element_quality(mesh, n_element);
+      }
+    }
+
+    EXPECT_NEAR(result.total.sum_quality, sum, 1e-9);
+  }
+
+  // Порог качества.
+  options.min_quality = 2.;
+
+  EXPECT_EQ(MI stream_quality(mapped, options).failed_elements.size(), mesh.n_elements());
+}
+}  // namespace mi::test
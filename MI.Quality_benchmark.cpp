@@ -0,0 +1,513 @@
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#if defined(__linux__)
+  #include <sys/syscall.h>
+  #include <unistd.h>
+#endif
+
+#include "Common/MI.DeterministicReduce.h"
+#include "Common/MI.NumaAllocator.h"
+#include "Common/MI.ParallelFor.h"
+#include "Mesh/MI.ElementGeometryCache.h"
+#include "Mesh/MI.FlatMeshNuma.h"
+#include "Mesh/MI.MetricQuality.h"
+#include "Mesh/MI.QuadConvexity.h"
+#include "Mesh/MI.QuadraticQuality.h"
+#include "Mesh/MI.Quality.h"
+#include "Mesh/MI.QualityGradient.h"
+#include "Mesh/MI.QualityMetrics.h"
+
+// Пропускная способность MI quality на синтетических сетках от 1K до 50M элементов.
+//
+// Сетка - регулярная решетка в плоскости z = 0 со случайным смещением внутренних узлов (не более 20% шага),
+// чтобы все элементы оставались валидными, но не были идеальными. Порядок элементов - построчный.
+//
+// Запуск с сохранением результатов для сравнения между коммитами:
+// MI.Quality_benchmark --benchmark_format=json --benchmark_out=quality.json
+
+namespace mi::benchmark {
+namespace {
+template<size_t NodesPerElement>
+struct synthetic_mesh {
+    STD vector<MI point3d>                            vertices;
+    STD vector<STD array<size_t, NodesPerElement>> elements;
+};
+
+// Решетка из (nx + 1) * (ny + 1) узлов.
+STD vector<MI point3d> make_grid_vertices(const size_t nx, const size_t ny) {
+  STD mt19937                            gen(42);
+  STD uniform_real_distribution<double> jitter(-0.2, 0.2);
+
+  STD vector<MI point3d> vertices;
+  vertices.reserve((nx + 1) * (ny + 1));
+
+  for (size_t j = 0; j <= ny; ++j) {
+    for (size_t i = 0; i <= nx; ++i) {
+      const bool   inner = i > 0 && j > 0 && i < nx && j < ny;
+      const double dx    = inner ? jitter(gen) : 0.;
+      const double dy    = inner ? jitter(gen) : 0.;
+
+      vertices.emplace_back(static_cast<double>(i) + dx, static_cast<double>(j) + dy, 0.);
+    }
+  }
+
+  return vertices;
+}
+
+// Размеры решетки, в которой примерно n_cells ячеек.
+STD pair<size_t, size_t> grid_size(const size_t n_cells) {
+  size_t nx = 1;
+
+  while (nx * nx < n_cells) {
+    ++nx;
+  }
+
+  return {nx, (n_cells + nx - 1) / nx};
+}
+
+synthetic_mesh<3> make_triangle_mesh(const size_t n_elements) {
+  const auto [nx, ny] = grid_size((n_elements + 1) / 2);
+
+  synthetic_mesh<3> mesh;
+  mesh.vertices = make_grid_vertices(nx, ny);
+  mesh.elements.reserve(n_elements);
+
+  for (size_t j = 0; j < ny && mesh.elements.size() < n_elements; ++j) {
+    for (size_t i = 0; i < nx && mesh.elements.size() < n_elements; ++i) {
+      const size_t v0 = j * (nx + 1) + i;
+      const size_t v1 = v0 + 1;
+      const size_t v2 = v1 + nx + 1;
+      const size_t v3 = v0 + nx + 1;
+
+      mesh.elements.push_back({v0, v1, v2});
+
+      if (mesh.elements.size() < n_elements) {
+        mesh.elements.push_back({v0, v2, v3});
+      }
+    }
+  }
+
+  return mesh;
+}
+
+synthetic_mesh<4> make_quad_mesh(const size_t n_elements) {
+  const auto [nx, ny] = grid_size(n_elements);
+
+  synthetic_mesh<4> mesh;
+  mesh.vertices = make_grid_vertices(nx, ny);
+  mesh.elements.reserve(n_elements);
+
+  for (size_t j = 0; j < ny && mesh.elements.size() < n_elements; ++j) {
+    for (size_t i = 0; i < nx && mesh.elements.size() < n_elements; ++i) {
+      const size_t v0 = j * (nx + 1) + i;
+
+      mesh.elements.push_back({v0, v0 + 1, v0 + nx + 2, v0 + nx + 1});
+    }
+  }
+
+  return mesh;
+}
+
+// Доли страниц, которые лежат не на узле NUMA потока, читающего или пишущего их (куски MI chunk_bounds, как
+// у параллельного прохода, потоки привязаны так же). -1, если система не сообщает узлы страниц.
+struct remote_pages {
+    double mesh   = -1.;  // Вершины и элементы
+    double output = -1.;  // Столбец качества
+};
+
+remote_pages remote_page_fraction(const MI flat_quad_mesh& mesh, const double* const output, const size_t n_threads) {
+#if defined(__linux__) && defined(SYS_move_pages) && defined(SYS_getcpu)
+  const long page = ::sysconf(_SC_PAGESIZE);
+
+  // Счетчики кусков: [0; n_threads) - сетка, [n_threads; 2 * n_threads) - столбец качества.
+  STD vector<size_t> n_pages(2 * n_threads, 0);
+  STD vector<size_t> n_remote(2 * n_threads, 0);
+  STD atomic<bool>   is_supported{true};
+
+  const auto count_pages = [&](const void* data, const size_t n_bytes, const size_t n_chunk, const unsigned node) {
+    const auto first = reinterpret_cast<STD uintptr_t>(data) / page * page;
+    const auto last  = reinterpret_cast<STD uintptr_t>(data) + n_bytes;
+
+    STD vector<void*> pages;
+
+    for (STD uintptr_t address = first; address < last; address += page) {
+      pages.push_back(reinterpret_cast<void*>(address));
+    }
+
+    STD vector<int> status(pages.size(), -1);
+
+    // Без списка узлов move_pages только сообщает узел каждой страницы.
+    if (::syscall(SYS_move_pages, 0, pages.size(), pages.data(), nullptr, status.data(), 0) != 0) {
+      is_supported.store(false, STD memory_order_relaxed);
+
+      return;
+    }
+
+    for (const int page_node: status) {
+      n_pages[n_chunk] += 1;
+      n_remote[n_chunk] += page_node >= 0 && static_cast<unsigned>(page_node) != node;
+    }
+  };
+
+  MI parallel_chunks(
+    mesh.n_elements(),
+    n_threads,
+    [&](const size_t n_chunk, const size_t first, const size_t last) {
+      unsigned cpu  = 0;
+      unsigned node = 0;
+      ::syscall(SYS_getcpu, &cpu, &node, nullptr);
+
+      const auto [first_vertex, last_vertex] = MI chunk_bounds(mesh.n_vertices(), n_threads, n_chunk);
+
+      count_pages(mesh.elements.data() + first, (last - first) * sizeof(mesh.elements[0]), n_chunk, node);
+      count_pages(
+        mesh.vertices.data() + first_vertex, (last_vertex - first_vertex) * sizeof(MI point3d), n_chunk, node);
+      count_pages(output + first, (last - first) * sizeof(double), n_threads + n_chunk, node);
+    },
+    MI thread_affinity::pinned);
+
+  const auto sum = [n_threads](const STD vector<size_t>& values, const size_t first_chunk) {
+    return STD accumulate(values.begin() + first_chunk, values.begin() + first_chunk + n_threads, size_t{0});
+  };
+
+  const auto fraction = [&](const size_t first_chunk) {
+    const size_t total  = sum(n_pages, first_chunk);
+    const size_t remote = sum(n_remote, first_chunk);
+
+    return total == 0 ? -1. : static_cast<double>(remote) / static_cast<double>(total);
+  };
+
+  if (!is_supported.load(STD memory_order_relaxed)) {
+    return {};
+  }
+
+  return {fraction(0), fraction(n_threads)};
+#else
+  static_cast<void>(mesh);
+  static_cast<void>(output);
+  static_cast<void>(n_threads);
+
+  return {};
+#endif
+}
+
+template<size_t NodesPerElement>
+synthetic_mesh<NodesPerElement> make_mesh(const size_t n_elements) {
+  if constexpr (NodesPerElement == 3) {
+    return make_triangle_mesh(n_elements);
+  } else {
+    return make_quad_mesh(n_elements);
+  }
+}
+}  // namespace
+
+void BM_TriangleQuality(::benchmark::State& state) {
+  const synthetic_mesh<3> mesh = make_triangle_mesh(static_cast<size_t>(state.range(0)));
+
+  for (auto _: state) {
+    double sum = 0.;
+
+    for (const auto& element: mesh.elements) {
+      sum += MI quality(mesh.vertices[element[0]], mesh.vertices[element[1]], mesh.vertices[element[2]]);
+    }
+
+    ::benchmark::DoNotOptimize(sum);
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(mesh.elements.size()));
+}
+
+void BM_QuadQuality(::benchmark::State& state) {
+  const synthetic_mesh<4> mesh = make_quad_mesh(static_cast<size_t>(state.range(0)));
+
+  for (auto _: state) {
+    double sum = 0.;
+
+    for (const auto& element: mesh.elements) {
+      sum += MI quality(mesh.vertices[element[0]],
+                        mesh.vertices[element[1]],
+                        mesh.vertices[element[2]],
+                        mesh.vertices[element[3]]);
+    }
+
+    ::benchmark::DoNotOptimize(sum);
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(mesh.elements.size()));
+}
+
+// Значение вместе с градиентом по всем вершинам (MI quality_gradient) - сравнивать с BM_TriangleQuality и
+// BM_QuadQuality.
+template<size_t NodesPerElement>
+void BM_QualityGradient(::benchmark::State& state) {
+  const synthetic_mesh<NodesPerElement> mesh = make_mesh<NodesPerElement>(static_cast<size_t>(state.range(0)));
+
+  for (auto _: state) {
+    double sum = 0.;
+
+    for (const auto& element: mesh.elements) {
+      STD array<MI point3d, NodesPerElement> p;
+
+      for (size_t i = 0; i < NodesPerElement; ++i) {
+        p[i] = mesh.vertices[element[i]];
+      }
+
+      const auto result = MI quality_gradient(p, MI point3d{0., 0., 1.});
+
+      sum += result.quality + result.gradient[0].x();
+    }
+
+    ::benchmark::DoNotOptimize(sum);
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(mesh.elements.size()));
+}
+
+// Четыре метрики для quad (mean ratio, scaled Jacobian, углы, aspect ratio): range(1) == 0 - один проход
+// MI evaluate_quality_metrics, range(1) == 1 - отдельный проход на каждую метрику.
+void BM_QualityMetrics(::benchmark::State& state) {
+  const synthetic_mesh<4> synthetic = make_quad_mesh(static_cast<size_t>(state.range(0)));
+  const MI flat_quad_mesh mesh      = {synthetic.vertices, synthetic.elements};
+
+  const bool              separate = state.range(1) != 0;
+  const MI point3d        normal   = {0., 0., 1.};
+  const MI quality_metric passes[] = {MI quality_metric::mean_ratio,
+                                      MI quality_metric::scaled_jacobian,
+                                      MI quality_metric::min_angle | MI quality_metric::max_angle,
+                                      MI quality_metric::aspect_ratio};
+
+  for (auto _: state) {
+    if (separate) {
+      for (const MI quality_metric metric: passes) {
+        ::benchmark::DoNotOptimize(MI evaluate_quality_metrics(mesh, metric, normal, 1));
+      }
+    } else {
+      ::benchmark::DoNotOptimize(MI evaluate_quality_metrics(mesh, MI quality_metric::all, normal, 1));
+    }
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(mesh.n_elements()));
+}
+
+// Проверка quad на вогнутость и коробление: range(1) == 0 - пакетная MI quad_convexity_mask, range(1) == 1 - по одному
+// элементу через нормали углов и арккосинусы (как angle_between_normals).
+void BM_QuadConvexity(::benchmark::State& state) {
+  const synthetic_mesh<4> synthetic = make_quad_mesh(static_cast<size_t>(state.range(0)));
+  const MI flat_quad_mesh mesh      = {synthetic.vertices, synthetic.elements};
+
+  const bool   per_element    = state.range(1) != 0;
+  const double max_warp_angle = 0.5;
+
+  for (auto _: state) {
+    if (per_element) {
+      size_t n_passed = 0;
+
+      for (const auto& element: mesh.elements) {
+        const STD array<MI point3d, 4> p = {
+          mesh.vertices[element[0]], mesh.vertices[element[1]], mesh.vertices[element[2]], mesh.vertices[element[3]]};
+
+        const MI element_geometry<4> geometry = MI make_element_geometry(p, {0., 0., 0.});
+
+        n_passed += MI is_convex(geometry) && MI max_angle_between_normals(geometry) <= max_warp_angle;
+      }
+
+      ::benchmark::DoNotOptimize(n_passed);
+    } else {
+      ::benchmark::DoNotOptimize(MI quad_convexity_mask(mesh, STD cos(max_warp_angle), {0., 0., 0.}, 1));
+    }
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(mesh.n_elements()));
+}
+
+// Mean ratio 9-узловых quad с прямыми ребрами (MI evaluate_quadratic_quality, range(1) == 0) и линейных quad той же
+// решетки (MI evaluate_quality_metrics, range(1) == 1). Узлы на ребрах квадратичных элементов не общие.
+void BM_QuadraticQuality(::benchmark::State& state) {
+  const synthetic_mesh<4> synthetic = make_quad_mesh(static_cast<size_t>(state.range(0)));
+  const MI flat_quad_mesh linear    = {synthetic.vertices, synthetic.elements};
+
+  MI flat_quadratic_quad_mesh quadratic;
+  quadratic.vertices = synthetic.vertices;
+
+  for (const auto& element: synthetic.elements) {
+    const size_t first = quadratic.vertices.size();
+
+    for (size_t i = 0; i < 4; ++i) {
+      quadratic.vertices.push_back(
+        (synthetic.vertices[element[i]] + synthetic.vertices[element[(i + 1) % 4]]) * 0.5);
+    }
+
+    quadratic.vertices.push_back((synthetic.vertices[element[0]] + synthetic.vertices[element[1]] +
+                                  synthetic.vertices[element[2]] + synthetic.vertices[element[3]]) *
+                                 0.25);
+
+    quadratic.elements.push_back(
+      {element[0], element[1], element[2], element[3], first, first + 1, first + 2, first + 3, first + 4});
+  }
+
+  const bool       is_linear = state.range(1) != 0;
+  const MI point3d normal    = {0., 0., 1.};
+
+  for (auto _: state) {
+    if (is_linear) {
+      ::benchmark::DoNotOptimize(MI evaluate_quality_metrics(linear, MI quality_metric::mean_ratio, normal, 1));
+    } else {
+      ::benchmark::DoNotOptimize(MI evaluate_quadratic_quality(quadratic, normal, 1));
+    }
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(linear.n_elements()));
+}
+
+// Mean ratio quad в анизотропной метрике с заранее разложенными метриками элементов (MI evaluate_metric_quality,
+// range(1) == 0) и изотропный mean ratio (MI evaluate_quality_metrics, range(1) == 1).
+void BM_MetricQuality(::benchmark::State& state) {
+  const synthetic_mesh<4> synthetic = make_quad_mesh(static_cast<size_t>(state.range(0)));
+  const MI flat_quad_mesh mesh      = {synthetic.vertices, synthetic.elements};
+
+  MI symmetric_matrix3d metric;
+  metric.xx = 4.;
+  metric.xy = 0.5;
+  metric.yy = 1.;
+  metric.zz = 1.;
+
+  const STD vector<MI metric_factor> factors =
+    MI element_metric_factors(mesh, STD vector<MI symmetric_matrix3d>(mesh.n_vertices(), metric), 1);
+
+  const bool       is_isotropic = state.range(1) != 0;
+  const MI point3d normal       = {0., 0., 1.};
+
+  for (auto _: state) {
+    if (is_isotropic) {
+      ::benchmark::DoNotOptimize(MI evaluate_quality_metrics(mesh, MI quality_metric::mean_ratio, normal, 1));
+    } else {
+      ::benchmark::DoNotOptimize(MI evaluate_metric_quality(mesh, factors, normal, 1));
+    }
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(mesh.n_elements()));
+}
+
+// Параллельный проход mean ratio по quad на всех потоках, привязанных к процессорам. range(1): 0 - страницы сетки
+// и столбца качества тронуты одним потоком загрузчика, 1 - страницы сетки перенесены на узлы потоков прохода
+// (MI first_touch_redistribute), а столбец качества - MI numa_vector, страницы которого первым пишет сам проход, 2 - то
+// же с transparent huge pages.
+// Счетчики remote_pages и remote_output_pages - доли страниц сетки и столбца качества на чужом узле NUMA (на одном
+// сокете всегда 0, -1 - неизвестно).
+void BM_FirstTouchScan(::benchmark::State& state) {
+  const synthetic_mesh<4> synthetic = make_quad_mesh(static_cast<size_t>(state.range(0)));
+  MI flat_quad_mesh       mesh      = {synthetic.vertices, synthetic.elements};
+
+  const size_t         n_threads = MI default_thread_count();
+  const MI point3d     normal    = {0., 0., 1.};
+  const MI page_policy policy    = state.range(1) == 2 ? MI page_policy::transparent_huge : MI page_policy::normal;
+
+  STD vector<double>     loader_quality;
+  MI numa_vector<double> chunk_quality{MI numa_allocator<double>(policy)};
+
+  MI quality_metric_outputs output;
+
+  if (state.range(1) == 0) {
+    loader_quality.resize(mesh.n_elements());
+    output.mean_ratio = loader_quality.data();
+  } else {
+    MI first_touch_redistribute(mesh, n_threads, policy);
+
+    chunk_quality.resize(mesh.n_elements());
+    output.mean_ratio = chunk_quality.data();
+  }
+
+  const MI thread_affinity affinity = MI default_thread_affinity();
+  MI set_default_thread_affinity(MI thread_affinity::pinned);
+
+  for (auto _: state) {
+    MI evaluate_quality_metrics(mesh, output, normal, n_threads);
+
+    ::benchmark::ClobberMemory();
+  }
+
+  MI set_default_thread_affinity(affinity);
+
+  const remote_pages remote = remote_page_fraction(mesh, output.mean_ratio, n_threads);
+
+  state.counters["remote_pages"]        = remote.mesh;
+  state.counters["remote_output_pages"] = remote.output;
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(mesh.n_elements()));
+}
+
+// Сумма качества всех элементов на всех потоках. range(1): 0 - MI deterministic_sum, 1 - обычная параллельная сумма
+// (последовательная сумма каждого куска, затем сумма кусков), результат которой зависит от количества потоков.
+void BM_QualitySum(::benchmark::State& state) {
+  const synthetic_mesh<4> synthetic = make_quad_mesh(static_cast<size_t>(state.range(0)));
+  const MI flat_quad_mesh mesh      = {synthetic.vertices, synthetic.elements};
+
+  const STD vector<double> quality =
+    MI evaluate_quality_metrics(mesh, MI quality_metric::mean_ratio, {0., 0., 1.}, 1).mean_ratio;
+
+  const size_t n_threads        = MI default_thread_count();
+  const bool   is_deterministic = state.range(1) == 0;
+
+  for (auto _: state) {
+    if (is_deterministic) {
+      ::benchmark::DoNotOptimize(MI deterministic_sum(quality, n_threads));
+    } else {
+      STD vector<double> sums(n_threads, 0.);
+
+      MI parallel_chunks(quality.size(), n_threads, [&](const size_t n_chunk, const size_t first, const size_t last) {
+        sums[n_chunk] = STD accumulate(quality.begin() + first, quality.begin() + last, 0.);
+      });
+
+      ::benchmark::DoNotOptimize(STD accumulate(sums.begin(), sums.end(), 0.));
+    }
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(quality.size()));
+}
+
+BENCHMARK(BM_TriangleQuality)->RangeMultiplier(8)->Range(1'000, 50'000'000)->Unit(::benchmark::kMillisecond);
+BENCHMARK(BM_QuadQuality)->RangeMultiplier(8)->Range(1'000, 50'000'000)->Unit(::benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_QualityGradient, 3)
+  ->RangeMultiplier(8)
+  ->Range(1'000, 50'000'000)
+  ->Unit(::benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_QualityGradient, 4)
+  ->RangeMultiplier(8)
+  ->Range(1'000, 50'000'000)
+  ->Unit(::benchmark::kMillisecond);
+BENCHMARK(BM_QualityMetrics)
+  ->ArgsProduct({{1 << 16, 1 << 20, 1 << 23}, {0, 1}})
+  ->ArgNames({"elements", "separate"})
+  ->Unit(::benchmark::kMillisecond);
+BENCHMARK(BM_QuadConvexity)
+  ->ArgsProduct({{1 << 16, 1 << 20, 1 << 23}, {0, 1}})
+  ->ArgNames({"elements", "per_element"})
+  ->Unit(::benchmark::kMillisecond);
+BENCHMARK(BM_QuadraticQuality)
+  ->ArgsProduct({{1 << 16, 1 << 20}, {0, 1}})
+  ->ArgNames({"elements", "linear"})
+  ->Unit(::benchmark::kMillisecond);
+BENCHMARK(BM_MetricQuality)
+  ->ArgsProduct({{1 << 16, 1 << 20}, {0, 1}})
+  ->ArgNames({"elements", "isotropic"})
+  ->Unit(::benchmark::kMillisecond);
+BENCHMARK(BM_FirstTouchScan)
+  ->ArgsProduct({{1 << 20, 1 << 23}, {0, 1, 2}})
+  ->ArgNames({"elements", "placement"})
+  ->Unit(::benchmark::kMillisecond)
+  ->UseRealTime();
+BENCHMARK(BM_QualitySum)
+  ->ArgsProduct({{1 << 20, 1 << 23}, {0, 1}})
+  ->ArgNames({"elements", "naive"})
+  ->Unit(::benchmark::kMillisecond)
+  ->UseRealTime();
+}  // namespace mi::benchmark
+
+BENCHMARK_MAIN();
@@ -0,0 +1,256 @@
+﻿#pragma once
+
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+#include "Common/MI.Check.h"
+#include "Common/MI.ParallelFor.h"
+
+// Параллельная LSD radix sort для массивов ключей static_vector<Integral, N> и sortable<Integral, N>.
+// ==================================================================================================
+//
+// Ключи упорядочиваются лексикографически только по живым элементам [begin(); end()), ключ-префикс меньше
+// более длинного ключа. Хвост контейнера за size() не участвует в сравнении.
+//
+// Каждый элемент ключа разбирается на байты, проходы идут от младшего байта последнего элемента к старшему байту
+// первого. В каждом проходе 257 корзин: корзина 0 - "элемента нет" (позиция >= size()), остальные - значение байта.
+// Знаковые типы сортируются корректно: у старшего байта инвертируется знаковый бит.
+//
+// Проход выполняется в два этапа по одному и тому же разбиению массива на куски (MI chunk_bounds):
+// - каждый поток строит гистограмму своего куска;
+// - смещения считаются в порядке (корзина, поток), поэтому каждый поток пишет в свои непересекающиеся диапазоны.
+// Сортировка стабильная. Проход пропускается, если все ключи попали в одну корзину (например, старшие байты
+// небольших индексов вершин), поэтому для sortable3i с индексами < 2^24 реально выполняется 9 проходов из 12.
+//
+// Итераторы должны быть непрерывными (STD vector, STD array, указатели).
+namespace mi {
+namespace internal {
+template<class Key, class = void>
+struct is_radix_key : STD false_type {};
+
+template<class Key>
+struct is_radix_key<Key, STD void_t<typename Key::value_type, decltype(Key::max_size())>>
+    : STD bool_constant<STD is_integral_v<typename Key::value_type>> {};
+
+template<class Key>
+constexpr bool is_radix_key_v = is_radix_key<Key>::value;
+
+// Количество корзин в одном проходе: 256 значений байта + корзина для отсутствующего элемента.
+constexpr size_t radix_bucket_count = 257;
+
+// Размер массива, начиная с которого сортировка выполняется в нескольких потоках.
+constexpr size_t radix_parallel_threshold = size_t{1} << 16;
+
+// Размер массива, до которого radix sort проигрывает сортировке сравнением.
+constexpr size_t radix_small_threshold = 64;
+
+template<class ValueTy>
+MI_NODISCARD constexpr auto radix_unsigned(const ValueTy value) {
+  if constexpr (STD is_same_v<ValueTy, bool>) {
+    return static_cast<unsigned char>(value);
+  } else {
+    using unsigned_type = STD make_unsigned_t<ValueTy>;
+
+    auto result = static_cast<unsigned_type>(value);
+
+    if constexpr (STD is_signed_v<ValueTy>) {
+      result ^= static_cast<unsigned_type>(unsigned_type{1} << (sizeof(ValueTy) * CHAR_BIT - 1));
+    }
+
+    return result;
+  }
+}
+
+template<class Key>
+MI_NODISCARD constexpr size_t radix_bucket(const Key& key, const size_t position, const size_t n_byte) {
+  if (position >= key.size()) {
+    return 0;
+  }
+
+  const auto value = radix_unsigned(key.data()[position]);
+
+  return static_cast<size_t>((value >> (n_byte * CHAR_BIT)) & 0xFF) + 1;
+}
+
+template<class Key>
+MI_NODISCARD bool radix_less(const Key& lhs, const Key& rhs) {
+  return STD lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+// Пустой тип значения для сортировки без значений.
+struct radix_no_value {};
+
+template<class Key, class ValueTy>
+void radix_sort_impl(Key* const keys, ValueTy* const values, const size_t count, size_t n_threads) {
+  constexpr bool   has_values = !STD is_same_v<ValueTy, radix_no_value>;
+  constexpr size_t capacity   = Key::max_size();
+  constexpr size_t n_bytes    = sizeof(typename Key::value_type);
+
+  if (count < 2) {
+    return;
+  }
+
+  if (count < radix_small_threshold) {
+    STD vector<size_t> order(count);
+
+    for (size_t i = 0; i < count; ++i) {
+      order[i] = i;
+    }
+
+    STD stable_sort(order.begin(), order.end(), [keys](const size_t lhs, const size_t rhs) {
+      return radix_less(keys[lhs], keys[rhs]);
+    });
+
+    STD vector<Key> sorted_keys(count);
+
+    for (size_t i = 0; i < count; ++i) {
+      sorted_keys[i] = STD move(keys[order[i]]);
+    }
+
+    STD move(sorted_keys.begin(), sorted_keys.end(), keys);
+
+    if constexpr (has_values) {
+      STD vector<ValueTy> sorted_values(count);
+
+      for (size_t i = 0; i < count; ++i) {
+        sorted_values[i] = STD move(values[order[i]]);
+      }
+
+      STD move(sorted_values.begin(), sorted_values.end(), values);
+    }
+
+    return;
+  }
+
+  if (count < radix_parallel_threshold) {
+    n_threads = 1;
+  }
+
+  n_threads = STD max(STD min(n_threads, count), size_t{1});
+
+  using histogram = STD array<size_t, radix_bucket_count>;
+
+  STD vector<Key>       key_buffer(count);
+  STD vector<ValueTy>   value_buffer(has_values ? count : 0);
+  STD vector<histogram> histograms(n_threads);
+
+  Key*     src_keys   = keys;
+  Key*     dst_keys   = key_buffer.data();
+  ValueTy* src_values = values;
+  ValueTy* dst_values = value_buffer.data();
+
+  for (size_t position = capacity; position-- > 0;) {
+    for (size_t n_byte = 0; n_byte < n_bytes; ++n_byte) {
+      parallel_chunks(count, n_threads, [&](const size_t n_chunk, const size_t first, const size_t last) {
+        histogram& local = histograms[n_chunk];
+        local.fill(0);
+
+        for (size_t i = first; i < last; ++i) {
+          ++local[radix_bucket(src_keys[i], position, n_byte)];
+        }
+      });
+
+      // Смещения в порядке (корзина, поток) сохраняют стабильность.
+      bool   trivial_pass = false;
+      size_t offset       = 0;
+
+      for (size_t bucket = 0; bucket < radix_bucket_count; ++bucket) {
+        size_t bucket_size = 0;
+
+        for (size_t n_chunk = 0; n_chunk < n_threads; ++n_chunk) {
+          const size_t chunk_size     = histograms[n_chunk][bucket];
+          histograms[n_chunk][bucket] = offset;
+          offset += chunk_size;
+          bucket_size += chunk_size;
+        }
+
+        if (bucket_size == count) {
+          trivial_pass = true;
+
+          break;
+        }
+      }
+
+      if (trivial_pass) {
+        continue;
+      }
+
+      parallel_chunks(count, n_threads, [&](const size_t n_chunk, const size_t first, const size_t last) {
+        histogram& local = histograms[n_chunk];
+
+        for (size_t i = first; i < last; ++i) {
+          const size_t destination = local[radix_bucket(src_keys[i], position, n_byte)]++;
+
+          dst_keys[destination] = STD move(src_keys[i]);
+
+          if constexpr (has_values) {
+            dst_values[destination] = STD move(src_values[i]);
+          }
+        }
+      });
+
+      STD swap(src_keys, dst_keys);
+
+      if constexpr (has_values) {
+        STD swap(src_values, dst_values);
+      }
+    }
+  }
+
+  if (src_keys != keys) {
+    parallel_chunks(count, n_threads, [&](size_t, const size_t first, const size_t last) {
+      STD move(src_keys + first, src_keys + last, keys + first);
+
+      if constexpr (has_values) {
+        STD move(src_values + first, src_values + last, values + first);
+      }
+    });
+  }
+}
+}  // namespace internal
+
+// Сортирует непрерывный диапазон ключей static_vector<Integral, N> / sortable<Integral, N>.
+template<class RandomIt>
+void radix_sort(RandomIt first, RandomIt last, const size_t n_threads = MI default_thread_count()) {
+  using key_type = typename STD iterator_traits<RandomIt>::value_type;
+
+  static_assert(internal::is_radix_key_v<key_type>, "radix_sort: key must be a static_vector of integral values");
+
+  const auto count = static_cast<size_t>(STD distance(first, last));
+
+  if (count == 0) {
+    return;
+  }
+
+  internal::radix_sort_impl<key_type, internal::radix_no_value>(STD addressof(*first), nullptr, count, n_threads);
+}
+
+// Сортирует ключи и переставляет вместе с ними значения (например, номера элементов, которым принадлежат грани).
+// Значения с равными ключами сохраняют исходный порядок.
+template<class KeyIt, class ValueIt>
+void radix_sort_by_key(KeyIt        keys_first,
+                       KeyIt        keys_last,
+                       ValueIt      values_first,
+                       const size_t n_threads = MI default_thread_count()) {
+  using key_type   = typename STD iterator_traits<KeyIt>::value_type;
+  using value_type = typename STD iterator_traits<ValueIt>::value_type;
+
+  static_assert(internal::is_radix_key_v<key_type>,
+                "radix_sort_by_key: key must be a static_vector of integral values");
+
+  const auto count = static_cast<size_t>(STD distance(keys_first, keys_last));
+
+  if (count == 0) {
+    return;
+  }
+
+  internal::radix_sort_impl<key_type, value_type>(STD addressof(*keys_first),
+                                                  STD addressof(*values_first),
+                                                  count,
+                                                  n_threads);
+}
+}  // namespace mi
@@ -0,0 +1,112 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include "Container/MI.RadixSort.h"
+#include "Container/MI.Sortable.h"
+
+namespace mi::test {
+namespace {
+template<class Key>
+bool lexicographical_less(const Key& lhs, const Key& rhs) {
+  return STD lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+STD vector<MI sortable3i> random_faces(const size_t count, const int max_index, const unsigned seed) {
+  STD mt19937                        gen(seed);
+  STD uniform_int_distribution<int> dist(-max_index, max_index);
+
+  STD vector<MI sortable3i> faces;
+  faces.reserve(count);
+
+  for (size_t i = 0; i < count; ++i) {
+    faces.push_back({dist(gen), dist(gen), dist(gen)});
+  }
+
+  return faces;
+}
+}  // namespace
+
+TEST(RadixSort, Empty) {
+  STD vector<MI sortable3i> faces;
+
+  MI radix_sort(faces.begin(), faces.end());
+
+  EXPECT_TRUE(faces.empty());
+}
+
+TEST(RadixSort, Small) {
+  STD vector<MI sortable3i> faces = {
+    {3, 1, 2},
+    {0, 0, 1},
+    {5, -1, 2},
+    {0, 0, 0}
+  };
+
+  MI radix_sort(faces.begin(), faces.end());
+
+  EXPECT_THAT(faces,
+              testing::ElementsAre(MI sortable3i{-1, 2, 5},
+                                   MI sortable3i{0, 0, 0},
+                                   MI sortable3i{0, 0, 1},
+                                   MI sortable3i{1, 2, 3}));
+}
+
+TEST(RadixSort, MatchesStableSort) {
+  for (const size_t count: {size_t{100}, size_t{5000}, size_t{200000}}) {
+    STD vector<MI sortable3i> faces    = random_faces(count, 1000, 42);
+    STD vector<MI sortable3i> expected = faces;
+
+    STD stable_sort(expected.begin(), expected.end(), lexicographical_less<MI sortable3i>);
+    MI radix_sort(faces.begin(), faces.end(), 4);
+
+    EXPECT_EQ(faces, expected);
+  }
+}
+
+TEST(RadixSort, LiveElementsOnly) {
+  STD vector<MI static_vector<unsigned, 3>> keys = {
+    {1, 2},
+    {1},
+    {1, 2, 0},
+    {},
+    {0, 5}
+  };
+
+  MI radix_sort(keys.begin(), keys.end());
+
+  ASSERT_EQ(keys.size(), 5);
+  EXPECT_THAT(keys[0], testing::ElementsAre());
+  EXPECT_THAT(keys[1], testing::ElementsAre(0, 5));
+  EXPECT_THAT(keys[2], testing::ElementsAre(1));
+  EXPECT_THAT(keys[3], testing::ElementsAre(1, 2));
+  EXPECT_THAT(keys[4], testing::ElementsAre(1, 2, 0));
+}
+
+TEST(RadixSort, ByKeyIsStable) {
+  STD vector<MI sortable3i> faces = random_faces(100000, 50, 7);
+  STD vector<size_t>        ids(faces.size());
+
+  for (size_t i = 0; i < ids.size(); ++i) {
+    ids[i] = i;
+  }
+
+  const STD vector<MI sortable3i> source = faces;
+
+  MI radix_sort_by_key(faces.begin(), faces.end(), ids.begin(), 3);
+
+  for (size_t i = 0; i < faces.size(); ++i) {
+    EXPECT_EQ(faces[i], source[ids[i]]);
+  }
+
+  for (size_t i = 1; i < faces.size(); ++i) {
+    ASSERT_FALSE(lexicographical_less(faces[i], faces[i - 1]));
+
+    if (faces[i] == faces[i - 1]) {
+      ASSERT_LT(ids[i - 1], ids[i]);
+    }
+  }
+}
+}  // namespace mi::test
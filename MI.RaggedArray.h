@@ -0,0 +1,342 @@
+﻿#pragma once
+
+#include <algorithm>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+#include "Common/MI.Check.h"
+#include "Common/MI.If.h"
+#include "Common/MI.IsIterator.h"
+#include "Common/MI.ParallelFor.h"
+#include "Container/MI.StaticVector.h"
+
+// Рваный массив (CSR): последовательность строк разной длины в одном непрерывном буфере.
+// ======================================================================================
+//
+// offsets: | 0 | 3 | 3 | 7 |         Строка i - это payload[offsets[i]; offsets[i + 1]).
+// payload: | a b c | d e f g |
+//
+// Заменяет STD vector<static_vector<Ty, N>>, в котором каждая строка занимает N элементов независимо от
+// фактического размера, а перевыделение памяти копирует в том числе неиспользуемые хвосты.
+// Здесь строка занимает ровно size() элементов + одно смещение.
+//
+// Для параллельного построения каждый поток заполняет свой ragged_array::builder (локальный буфер потока), после
+// чего буферы склеиваются одним проходом (MI ragged_array<Ty>::concat), без блокировок и общих аллокаций.
+namespace mi {
+// Представление одной строки рваного массива.
+template<class PointerTy>
+class ragged_row {
+  public:
+    using pointer         = PointerTy;
+    using reference       = decltype(*STD declval<pointer>());
+    using value_type      = STD remove_cv_t<STD remove_reference_t<reference>>;
+    using size_type       = size_t;
+    using difference_type = STD ptrdiff_t;
+    using iterator        = pointer;
+
+  public:
+    constexpr ragged_row() = default;
+
+    constexpr ragged_row(pointer first, pointer last) noexcept
+        : _first(first),
+          _last(last) {
+    }
+
+  public:
+    MI_NODISCARD constexpr iterator begin() const noexcept {
+      return _first;
+    }
+
+    MI_NODISCARD constexpr iterator end() const noexcept {
+      return _last;
+    }
+
+  public:
+    MI_NODISCARD constexpr size_type size() const noexcept {
+      return static_cast<size_type>(_last - _first);
+    }
+
+    MI_NODISCARD constexpr bool empty() const noexcept {
+      return _first == _last;
+    }
+
+    MI_NODISCARD constexpr pointer data() const noexcept {
+      return _first;
+    }
+
+  public:
+    MI_NODISCARD constexpr reference operator[](size_type pos) const {
+      MI_DCHECK(pos < size());
+
+      return _first[pos];
+    }
+
+  public:
+    MI_NODISCARD MI_CONSTEXPR_17 bool contains(const value_type& value) const {
+      return STD find(_first, _last, value) != _last;
+    }
+
+  public:
+    // Копия строки во встроенный контейнер, строка должна помещаться в N элементов.
+    template<size_t N>
+    MI_NODISCARD MI_CONSTEXPR_17 MI static_vector<value_type, N> to_static_vector() const {
+      MI_CHECK(size() <= N);
+
+      return MI static_vector<value_type, N>(_first, _last);
+    }
+
+  private:
+    pointer _first = nullptr;
+    pointer _last  = nullptr;
+};
+
+template<class Ty>
+class ragged_array {
+  public:
+    using value_type = Ty;
+    using size_type  = size_t;
+
+    using row_type       = ragged_row<Ty*>;
+    using const_row_type = ragged_row<const Ty*>;
+
+  public:
+    // Локальный буфер для построения части рваного массива в одном потоке.
+    // Хранит размеры строк вместо смещений, чтобы склейка буферов не требовала их пересчета.
+    class builder {
+      public:
+        template<class Range>
+        void push_back(const Range& row) {
+          push_back(STD begin(row), STD end(row));
+        }
+
+        template<class ItTy, if_t<is_iterator_v<ItTy>> = 0>
+        void push_back(ItTy first, ItTy last) {
+          const size_type previous_size = _payload.size();
+
+          _payload.insert(_payload.end(), first, last);
+          _row_sizes.push_back(_payload.size() - previous_size);
+        }
+
+      public:
+        MI_NODISCARD size_type size() const noexcept {
+          return _row_sizes.size();
+        }
+
+        MI_NODISCARD size_type payload_size() const noexcept {
+          return _payload.size();
+        }
+
+      public:
+        void reserve(const size_type n_rows, const size_type n_values) {
+          _row_sizes.reserve(n_rows);
+          _payload.reserve(n_values);
+        }
+
+        // Очищает буфер, сохраняя выделенную память для повторного использования.
+        void clear() noexcept {
+          _row_sizes.clear();
+          _payload.clear();
+        }
+
+      private:
+        friend class ragged_array;
+
+        STD vector<size_type>  _row_sizes;
+        STD vector<value_type> _payload;
+    };
+
+  public:
+    ragged_array()
+        : _offsets(1, size_type{0}) {
+    }
+
+    // Построение из готовых смещений (size() + 1 элементов, начиная с 0) и элементов.
+    ragged_array(STD vector<size_type> offsets, STD vector<value_type> payload)
+        : _offsets(STD move(offsets)),
+          _payload(STD move(payload)) {
+      MI_CHECK(!_offsets.empty() && _offsets.front() == 0 && _offsets.back() == _payload.size());
+      MI_DCHECK(STD is_sorted(_offsets.begin(), _offsets.end()));
+    }
+
+    // Построение из последовательности строк (static_vector, sortable и т.п.).
+    template<class ItTy, if_t<is_iterator_v<ItTy>> = 0>
+    ragged_array(ItTy first, ItTy last)
+        : ragged_array() {
+      for (; first != last; ++first) {
+        push_back(*first);
+      }
+    }
+
+    template<class Container>
+    explicit ragged_array(const STD vector<Container>& rows)
+        : ragged_array(rows.begin(), rows.end()) {
+    }
+
+  public:
+    // Склеивает буферы в порядке их следования. Буферы копируются параллельно, каждый поток пишет в свой
+    // непересекающийся диапазон.
+    MI_NODISCARD static ragged_array concat(const STD vector<builder>& builders,
+                                            const size_t               n_threads = MI default_thread_count()) {
+      ragged_array result;
+
+      const size_t n_builders = builders.size();
+
+      STD vector<size_type> row_offsets(n_builders + 1, 0);
+      STD vector<size_type> payload_offsets(n_builders + 1, 0);
+
+      for (size_t i = 0; i < n_builders; ++i) {
+        row_offsets[i + 1]     = row_offsets[i] + builders[i].size();
+        payload_offsets[i + 1] = payload_offsets[i] + builders[i].payload_size();
+      }
+
+      result._offsets.resize(row_offsets.back() + 1);
+      result._payload.resize(payload_offsets.back());
+
+      parallel_chunks(n_builders,
+                      STD min(n_threads, n_builders),
+                      [&](size_t, const size_t first, const size_t last) {
+                        for (size_t i = first; i < last; ++i) {
+                          const builder& local  = builders[i];
+                          size_type      offset = payload_offsets[i];
+
+                          for (size_t row = 0; row < local.size(); ++row) {
+                            offset += local._row_sizes[row];
+                            result._offsets[row_offsets[i] + row + 1] = offset;
+                          }
+
+                          STD copy(local._payload.begin(),
+                                   local._payload.end(),
+                                   result._payload.begin() + static_cast<STD ptrdiff_t>(payload_offsets[i]));
+                        }
+                      });
+
+      return result;
+    }
+
+    // Параллельное построение: fill(n_row, builder) должна добавить в builder ровно одну строку с номером n_row.
+    // Строки [0; n_rows) делятся на непрерывные куски, каждый кусок заполняется в своем локальном буфере.
+    template<class Fn>
+    MI_NODISCARD static ragged_array build(const size_type n_rows,
+                                           Fn&&            fill,
+                                           const size_t    n_threads = MI default_thread_count()) {
+      const size_t n_chunks = STD max(STD min(n_threads, n_rows), size_t{1});
+
+      STD vector<builder> builders(n_chunks);
+
+      parallel_chunks(n_rows, n_chunks, [&](const size_t n_chunk, const size_t first, const size_t last) {
+        builder& local = builders[n_chunk];
+
+        for (size_t n_row = first; n_row < last; ++n_row) {
+          fill(n_row, local);
+        }
+
+        MI_CHECK(local.size() == last - first);
+      });
+
+      return concat(builders, n_chunks);
+    }
+
+  public:
+    MI_NODISCARD size_type size() const noexcept {
+      return _offsets.size() - 1;
+    }
+
+    MI_NODISCARD bool empty() const noexcept {
+      return size() == 0;
+    }
+
+    MI_NODISCARD size_type payload_size() const noexcept {
+      return _payload.size();
+    }
+
+    MI_NODISCARD size_type row_size(const size_type n_row) const {
+      MI_DCHECK(n_row < size());
+
+      return _offsets[n_row + 1] - _offsets[n_row];
+    }
+
+  public:
+    MI_NODISCARD row_type operator[](const size_type n_row) {
+      MI_DCHECK(n_row < size());
+
+      return {_payload.data() + _offsets[n_row], _payload.data() + _offsets[n_row + 1]};
+    }
+
+    MI_NODISCARD const_row_type operator[](const size_type n_row) const {
+      MI_DCHECK(n_row < size());
+
+      return {_payload.data() + _offsets[n_row], _payload.data() + _offsets[n_row + 1]};
+    }
+
+    MI_NODISCARD const_row_type at(const size_type n_row) const {
+      MI_CHECK(n_row < size());
+
+      return (*this)[n_row];
+    }
+
+  public:
+    // Смещения строк, size() + 1 элементов, первое всегда 0.
+    MI_NODISCARD const STD vector<size_type>& offsets() const noexcept {
+      return _offsets;
+    }
+
+    // Элементы всех строк подряд.
+    MI_NODISCARD const STD vector<value_type>& payload() const noexcept {
+      return _payload;
+    }
+
+  public:
+    template<class Range>
+    void push_back(const Range& row) {
+      push_back(STD begin(row), STD end(row));
+    }
+
+    template<class ItTy, if_t<is_iterator_v<ItTy>> = 0>
+    void push_back(ItTy first, ItTy last) {
+      _payload.insert(_payload.end(), first, last);
+      _offsets.push_back(_payload.size());
+    }
+
+    // Дописывает строки локального буфера в конец массива.
+    void append(const builder& local) {
+      _offsets.reserve(_offsets.size() + local.size());
+
+      size_type offset = _payload.size();
+
+      for (const size_type row_size: local._row_sizes) {
+        offset += row_size;
+        _offsets.push_back(offset);
+      }
+
+      _payload.insert(_payload.end(), local._payload.begin(), local._payload.end());
+    }
+
+  public:
+    void reserve(const size_type n_rows, const size_type n_values) {
+      _offsets.reserve(n_rows + 1);
+      _payload.reserve(n_values);
+    }
+
+    void clear() noexcept {
+      _offsets.resize(1);
+      _payload.clear();
+    }
+
+    void shrink_to_fit() {
+      _offsets.shrink_to_fit();
+      _payload.shrink_to_fit();
+    }
+
+  public:
+    // Копия строки во встроенный контейнер.
+    template<size_t N>
+    MI_NODISCARD MI static_vector<value_type, N> to_static_vector(const size_type n_row) const {
+      return (*this)[n_row].template to_static_vector<N>();
+    }
+
+  private:
+    STD vector<size_type>  _offsets;  // Смещения начала строк, последний элемент - размер payload
+    STD vector<value_type> _payload;  // Элементы всех строк подряд
+};
+}  // namespace mi
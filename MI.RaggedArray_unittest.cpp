@@ -0,0 +1,104 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "Container/MI.RaggedArray.h"
+
+namespace mi::test {
+TEST(RaggedArray, DefaultConstructor) {
+  MI ragged_array<int> a;
+
+  EXPECT_TRUE(a.empty());
+  EXPECT_EQ(a.size(), 0);
+  EXPECT_EQ(a.payload_size(), 0);
+  EXPECT_THAT(a.offsets(), testing::ElementsAre(0));
+}
+
+TEST(RaggedArray, FromStaticVectors) {
+  const STD vector<MI static_vector<int, 27>> rows = {
+    {1, 2, 3},
+    {},
+    {4, 5, 6, 7}
+  };
+
+  const MI ragged_array<int> a(rows);
+
+  ASSERT_EQ(a.size(), 3);
+  EXPECT_EQ(a.payload_size(), 7);
+  EXPECT_THAT(a.offsets(), testing::ElementsAre(0, 3, 3, 7));
+  EXPECT_THAT(a[0], testing::ElementsAre(1, 2, 3));
+  EXPECT_TRUE(a[1].empty());
+  EXPECT_THAT(a[2], testing::ElementsAre(4, 5, 6, 7));
+  EXPECT_TRUE(a[2].contains(6));
+  EXPECT_EQ(a.to_static_vector<27>(2), rows[2]);
+}
+
+TEST(RaggedArray, PushBackAndModify) {
+  MI ragged_array<int> a;
+
+  a.push_back(MI static_vector<int, 3>{1, 2});
+  a.push_back(STD vector<int>{3});
+
+  a[0][1] = 10;
+
+  EXPECT_THAT(a[0], testing::ElementsAre(1, 10));
+  EXPECT_THAT(a[1], testing::ElementsAre(3));
+  EXPECT_EQ(a.row_size(0), 2);
+}
+
+TEST(RaggedArray, AppendBuilder) {
+  MI ragged_array<int>          a;
+  MI ragged_array<int>::builder local;
+
+  a.push_back(STD vector<int>{1});
+  local.push_back(STD vector<int>{2, 3});
+  local.push_back(STD vector<int>{});
+  a.append(local);
+
+  ASSERT_EQ(a.size(), 3);
+  EXPECT_THAT(a.offsets(), testing::ElementsAre(0, 1, 3, 3));
+  EXPECT_THAT(a[1], testing::ElementsAre(2, 3));
+}
+
+TEST(RaggedArray, Concat) {
+  STD vector<MI ragged_array<int>::builder> builders(3);
+
+  builders[0].push_back(STD vector<int>{1, 2});
+  builders[2].push_back(STD vector<int>{3});
+  builders[2].push_back(STD vector<int>{4, 5, 6});
+
+  const auto a = MI ragged_array<int>::concat(builders, 2);
+
+  ASSERT_EQ(a.size(), 3);
+  EXPECT_THAT(a.offsets(), testing::ElementsAre(0, 2, 3, 6));
+  EXPECT_THAT(a.payload(), testing::ElementsAre(1, 2, 3, 4, 5, 6));
+}
+
+TEST(RaggedArray, ParallelBuild) {
+  constexpr size_t n_rows = 1000;
+
+  const auto a = MI ragged_array<size_t>::build(
+    n_rows,
+    [](const size_t n_row, MI ragged_array<size_t>::builder& local) {
+      MI static_vector<size_t, 27> row;
+
+      for (size_t i = 0; i < n_row % 27; ++i) {
+        row.emplace_back(n_row + i);
+      }
+
+      local.push_back(row);
+    },
+    4);
+
+  ASSERT_EQ(a.size(), n_rows);
+
+  for (size_t n_row = 0; n_row < n_rows; ++n_row) {
+    ASSERT_EQ(a.row_size(n_row), n_row % 27);
+
+    for (size_t i = 0; i < a.row_size(n_row); ++i) {
+      ASSERT_EQ(a[n_row][i], n_row + i);
+    }
+  }
+}
+}  // namespace mi::test
@@ -5,58 +5,68 @@
 #include "Container/MI.SortableBase.h"
 #include "MI.Property.h"
 
+// Объявление производного типа шаблона Template
+// (sortable, int, i, 3) -> sortable3i
+#define MI_MAKE_TYPEDEFS_FOR(Template, Type, TypeSuffix, Size) using Template##Size##TypeSuffix = MI Template<Type, Size>
+
 // Объявление производного типа sortable
 // (int, i, 3) -> sortable3i
-#define MI_MAKE_TYPEDEFS(Type, TypeSuffix, Size) using sortable##Size##TypeSuffix = MI sortable<Type, Size>
+#define MI_MAKE_TYPEDEFS(Type, TypeSuffix, Size) MI_MAKE_TYPEDEFS_FOR(sortable, Type, TypeSuffix, Size)
 
-#define MI_MAKE_TYPEDEFS_SIMPLE(Size)                                                                                  \
+#define MI_MAKE_TYPEDEFS_SIMPLE_FOR(Template, Size)                                                                    \
   template<class Ty>                                                                                                   \
-  using sortable##Size = MI sortable<Ty, Size>
+  using Template##Size = MI Template<Ty, Size>
+
+#define MI_MAKE_TYPEDEFS_SIMPLE(Size) MI_MAKE_TYPEDEFS_SIMPLE_FOR(sortable, Size)
 
 // Объявление производных типов разного размера
-#define MI_MAKE_TYPEDEFS_ALL_SIZES(Type, TypeSuffix)                                                                   \
-  MI_MAKE_TYPEDEFS(Type, TypeSuffix, 0);                                                                               \
-  MI_MAKE_TYPEDEFS(Type, TypeSuffix, 1);                                                                               \
-  MI_MAKE_TYPEDEFS(Type, TypeSuffix, 2);                                                                               \
-  MI_MAKE_TYPEDEFS(Type, TypeSuffix, 3);                                                                               \
-  MI_MAKE_TYPEDEFS(Type, TypeSuffix, 4);                                                                               \
-  MI_MAKE_TYPEDEFS(Type, TypeSuffix, 5);                                                                               \
-  MI_MAKE_TYPEDEFS(Type, TypeSuffix, 6);                                                                               \
-  MI_MAKE_TYPEDEFS(Type, TypeSuffix, 7);                                                                               \
-  MI_MAKE_TYPEDEFS(Type, TypeSuffix, 8);                                                                               \
-  MI_MAKE_TYPEDEFS(Type, TypeSuffix, 9);                                                                               \
-  MI_MAKE_TYPEDEFS(Type, TypeSuffix, 10);                                                                              \
-  MI_MAKE_TYPEDEFS(Type, TypeSuffix, 11);                                                                              \
-  MI_MAKE_TYPEDEFS(Type, TypeSuffix, 12);                                                                              \
-  MI_MAKE_TYPEDEFS(Type, TypeSuffix, 13);                                                                              \
-  MI_MAKE_TYPEDEFS(Type, TypeSuffix, 14);                                                                              \
-  MI_MAKE_TYPEDEFS(Type, TypeSuffix, 15);                                                                              \
-  MI_MAKE_TYPEDEFS(Type, TypeSuffix, 16);                                                                              \
-  MI_MAKE_TYPEDEFS(Type, TypeSuffix, 17);                                                                              \
-  MI_MAKE_TYPEDEFS(Type, TypeSuffix, 18);                                                                              \
-  MI_MAKE_TYPEDEFS(Type, TypeSuffix, 19);
-
-#define MAKE_TYPEDEFS_SIMPLE_ALL_SIZES                                                                                 \
-  MI_MAKE_TYPEDEFS_SIMPLE(0);                                                                                          \
-  MI_MAKE_TYPEDEFS_SIMPLE(1);                                                                                          \
-  MI_MAKE_TYPEDEFS_SIMPLE(2);                                                                                          \
-  MI_MAKE_TYPEDEFS_SIMPLE(3);                                                                                          \
-  MI_MAKE_TYPEDEFS_SIMPLE(4);                                                                                          \
-  MI_MAKE_TYPEDEFS_SIMPLE(5);                                                                                          \
-  MI_MAKE_TYPEDEFS_SIMPLE(6);                                                                                          \
-  MI_MAKE_TYPEDEFS_SIMPLE(7);                                                                                          \
-  MI_MAKE_TYPEDEFS_SIMPLE(8);                                                                                          \
-  MI_MAKE_TYPEDEFS_SIMPLE(9);                                                                                          \
-  MI_MAKE_TYPEDEFS_SIMPLE(10);                                                                                         \
-  MI_MAKE_TYPEDEFS_SIMPLE(11);                                                                                         \
-  MI_MAKE_TYPEDEFS_SIMPLE(12);                                                                                         \
-  MI_MAKE_TYPEDEFS_SIMPLE(13);                                                                                         \
-  MI_MAKE_TYPEDEFS_SIMPLE(14);                                                                                         \
-  MI_MAKE_TYPEDEFS_SIMPLE(15);                                                                                         \
-  MI_MAKE_TYPEDEFS_SIMPLE(16);                                                                                         \
-  MI_MAKE_TYPEDEFS_SIMPLE(17);                                                                                         \
-  MI_MAKE_TYPEDEFS_SIMPLE(18);                                                                                         \
-  MI_MAKE_TYPEDEFS_SIMPLE(19);
+#define MI_MAKE_TYPEDEFS_ALL_SIZES_FOR(Template, Type, TypeSuffix)                                                     \
+  MI_MAKE_TYPEDEFS_FOR(Template, Type, TypeSuffix, 0);                                                                 \
+  MI_MAKE_TYPEDEFS_FOR(Template, Type, TypeSuffix, 1);                                                                 \
+  MI_MAKE_TYPEDEFS_FOR(Template, Type, TypeSuffix, 2);                                                                 \
+  MI_MAKE_TYPEDEFS_FOR(Template, Type, TypeSuffix, 3);                                                                 \
+  MI_MAKE_TYPEDEFS_FOR(Template, Type, TypeSuffix, 4);                                                                 \
+  MI_MAKE_TYPEDEFS_FOR(Template, Type, TypeSuffix, 5);                                                                 \
+  MI_MAKE_TYPEDEFS_FOR(Template, Type, TypeSuffix, 6);                                                                 \
+  MI_MAKE_TYPEDEFS_FOR(Template, Type, TypeSuffix, 7);                                                                 \
+  MI_MAKE_TYPEDEFS_FOR(Template, Type, TypeSuffix, 8);                                                                 \
+  MI_MAKE_TYPEDEFS_FOR(Template, Type, TypeSuffix, 9);                                                                 \
+  MI_MAKE_TYPEDEFS_FOR(Template, Type, TypeSuffix, 10);                                                                \
+  MI_MAKE_TYPEDEFS_FOR(Template, Type, TypeSuffix, 11);                                                                \
+  MI_MAKE_TYPEDEFS_FOR(Template, Type, TypeSuffix, 12);                                                                \
+  MI_MAKE_TYPEDEFS_FOR(Template, Type, TypeSuffix, 13);                                                                \
+  MI_MAKE_TYPEDEFS_FOR(Template, Type, TypeSuffix, 14);                                                                \
+  MI_MAKE_TYPEDEFS_FOR(Template, Type, TypeSuffix, 15);                                                                \
+  MI_MAKE_TYPEDEFS_FOR(Template, Type, TypeSuffix, 16);                                                                \
+  MI_MAKE_TYPEDEFS_FOR(Template, Type, TypeSuffix, 17);                                                                \
+  MI_MAKE_TYPEDEFS_FOR(Template, Type, TypeSuffix, 18);                                                                \
+  MI_MAKE_TYPEDEFS_FOR(Template, Type, TypeSuffix, 19);
+
+#define MI_MAKE_TYPEDEFS_ALL_SIZES(Type, TypeSuffix) MI_MAKE_TYPEDEFS_ALL_SIZES_FOR(sortable, Type, TypeSuffix)
+
+#define MI_MAKE_TYPEDEFS_SIMPLE_ALL_SIZES_FOR(Template)                                                                \
+  MI_MAKE_TYPEDEFS_SIMPLE_FOR(Template, 0);                                                                            \
+  MI_MAKE_TYPEDEFS_SIMPLE_FOR(Template, 1);                                                                            \
+  MI_MAKE_TYPEDEFS_SIMPLE_FOR(Template, 2);                                                                            \
+  MI_MAKE_TYPEDEFS_SIMPLE_FOR(Template, 3);                                                                            \
+  MI_MAKE_TYPEDEFS_SIMPLE_FOR(Template, 4);                                                                            \
+  MI_MAKE_TYPEDEFS_SIMPLE_FOR(Template, 5);                                                                            \
+  MI_MAKE_TYPEDEFS_SIMPLE_FOR(Template, 6);                                                                            \
+  MI_MAKE_TYPEDEFS_SIMPLE_FOR(Template, 7);                                                                            \
+  MI_MAKE_TYPEDEFS_SIMPLE_FOR(Template, 8);                                                                            \
+  MI_MAKE_TYPEDEFS_SIMPLE_FOR(Template, 9);                                                                            \
+  MI_MAKE_TYPEDEFS_SIMPLE_FOR(Template, 10);                                                                           \
+  MI_MAKE_TYPEDEFS_SIMPLE_FOR(Template, 11);                                                                           \
+  MI_MAKE_TYPEDEFS_SIMPLE_FOR(Template, 12);                                                                           \
+  MI_MAKE_TYPEDEFS_SIMPLE_FOR(Template, 13);                                                                           \
+  MI_MAKE_TYPEDEFS_SIMPLE_FOR(Template, 14);                                                                           \
+  MI_MAKE_TYPEDEFS_SIMPLE_FOR(Template, 15);                                                                           \
+  MI_MAKE_TYPEDEFS_SIMPLE_FOR(Template, 16);                                                                           \
+  MI_MAKE_TYPEDEFS_SIMPLE_FOR(Template, 17);                                                                           \
+  MI_MAKE_TYPEDEFS_SIMPLE_FOR(Template, 18);                                                                           \
+  MI_MAKE_TYPEDEFS_SIMPLE_FOR(Template, 19);
+
+#define MAKE_TYPEDEFS_SIMPLE_ALL_SIZES MI_MAKE_TYPEDEFS_SIMPLE_ALL_SIZES_FOR(sortable)
 
 namespace mi {
 // Создать полный список простых типов
@@ -0,0 +1,321 @@
+﻿#pragma once
+
+#include <array>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+
+#include "Common/MI.Check.h"
+#include "Common/MI.Hash.h"
+#include "Common/MI.If.h"
+#include "Common/MI.IsIterator.h"
+#include "Container/MI.Sortable.h"
+#include "MI.Property.h"
+
+namespace mi {
+// Отсортированный массив фиксированного размера.
+//
+// В отличие от sortable всегда содержит ровно Size элементов, поэтому не хранит размер: sizeof(sorted_array) ==
+// Size * sizeof(Ty), тип тривиально копируемый, если тривиально копируемый Ty. Предназначен для ключей граней и ребер
+// (sorted_array3i вместо sortable3i), которые всегда заполнены полностью.
+//
+// Элементы доступны только для чтения, иначе нельзя гарантировать упорядоченность.
+template<class Ty, size_t Size>
+class sorted_array {
+  public:
+    using static_capacity = STD integral_constant<size_t, Size>;
+
+  public:
+    using container_type = STD array<Ty, Size>;
+
+  public:
+    using value_type = typename container_type::value_type;
+
+    using size_type       = typename container_type::size_type;
+    using difference_type = typename container_type::difference_type;
+
+    using pointer       = typename container_type::const_pointer;
+    using const_pointer = typename container_type::const_pointer;
+
+    using reference       = typename container_type::const_reference;
+    using const_reference = typename container_type::const_reference;
+
+    using iterator               = typename container_type::const_iterator;
+    using const_iterator         = typename container_type::const_iterator;
+    using reverse_iterator       = typename container_type::const_reverse_iterator;
+    using const_reverse_iterator = typename container_type::const_reverse_iterator;
+
+  private:
+    // Сортировка вставками: constexpr в C++17 и быстрее STD sort для маленьких Size.
+    MI_CONSTEXPR_17 void _sort() noexcept {
+      for (size_type i = 1; i < Size; ++i) {
+        value_type value = _container[i];
+        size_type  j     = i;
+
+        for (; j > 0 && value < _container[j - 1]; --j) {
+          _container[j] = _container[j - 1];
+        }
+
+        _container[j] = value;
+      }
+    }
+
+  public:
+    // Только default, иначе не тривиально копируемый.
+    ~sorted_array() = default;
+
+  public:
+    MI_CONSTEXPR_17 sorted_array()
+        : _container(container_type{}) {
+    }
+
+  public:
+    MI_CONSTEXPR_17 sorted_array(const sorted_array& lv_other)            = default;
+    MI_CONSTEXPR_17 sorted_array& operator=(const sorted_array& lv_other) = default;
+
+  public:
+    MI_CONSTEXPR_17 sorted_array(sorted_array&& rv_other) noexcept            = default;
+    MI_CONSTEXPR_17 sorted_array& operator=(sorted_array&& rv_other) noexcept = default;
+
+  public:
+    MI_CONSTEXPR_17 sorted_array(STD initializer_list<value_type> list)
+        : _container(container_type{}) {
+      MI_CHECK(list.size() == static_capacity::value);
+
+      size_type i = 0;
+
+      for (const auto& element: list) {
+        _container[i++] = element;
+      }
+
+      _sort();
+    }
+
+    MI_CONSTEXPR_17 sorted_array& operator=(STD initializer_list<value_type> list) {
+      return *this = sorted_array(list);
+    }
+
+  public:
+    template<class ItTy, if_t<is_iterator_v<ItTy>> = 0>
+    MI_CONSTEXPR_17 sorted_array(ItTy first, ItTy last)
+        : _container(container_type{}) {
+      MI verify_range(first, last);
+
+      size_type i = 0;
+
+      for (; first != last; ++first) {
+        MI_CHECK(i < static_capacity::value);
+
+        _container[i++] = *first;
+      }
+
+      MI_CHECK(i == static_capacity::value);
+
+      _sort();
+    }
+
+    MI_CONSTEXPR_17 explicit sorted_array(const value_type (&values)[Size])
+        : _container(container_type{}) {
+      for (size_type i = 0; i < Size; ++i) {
+        _container[i] = values[i];
+      }
+
+      _sort();
+    }
+
+  public:
+    // Конвертация из sortable/static_vector, который должен быть заполнен полностью.
+    template<class Container, if_t<Container::static_capacity::value == Size> = 0>
+    MI_CONSTEXPR_17 explicit sorted_array(const Container& other)
+        : sorted_array(other.begin(), other.end()) {
+    }
+
+  public:
+    MI_NODISCARD MI_CONSTEXPR_17 static size_type size() {
+      return static_capacity::value;
+    }
+
+    MI_NODISCARD MI_CONSTEXPR_17 static size_type max_size() {
+      return static_capacity::value;
+    }
+
+    MI_NODISCARD MI_CONSTEXPR_17 static bool empty() {
+      return static_capacity::value == 0;
+    }
+
+  public:
+    MI_CONSTEXPR_17 void swap(sorted_array& other) noexcept(STD is_nothrow_swappable_v<container_type>) {
+      STD swap(_container, other._container);
+    }
+
+  public:
+    MI_NODISCARD MI_CONSTEXPR_17 const_iterator begin() const {
+      return _container.begin();
+    }
+
+    MI_NODISCARD MI_CONSTEXPR_17 const_iterator end() const {
+      return _container.end();
+    }
+
+    MI_NODISCARD MI_CONSTEXPR_17 const_iterator cbegin() const {
+      return _container.cbegin();
+    }
+
+    MI_NODISCARD MI_CONSTEXPR_17 const_iterator cend() const {
+      return _container.cend();
+    }
+
+    MI_NODISCARD MI_CONSTEXPR_17 const_reverse_iterator rbegin() const {
+      return _container.rbegin();
+    }
+
+    MI_NODISCARD MI_CONSTEXPR_17 const_reverse_iterator rend() const {
+      return _container.rend();
+    }
+
+  public:
+    MI_NODISCARD MI_CONSTEXPR_17 const_reference at(size_type pos) const {
+      MI_CHECK(pos < size());
+
+      return _container[pos];
+    }
+
+    MI_NODISCARD MI_CONSTEXPR_17 const_reference operator[](size_type pos) const {
+      MI_DCHECK(pos < size());
+
+      return _container[pos];
+    }
+
+  public:
+    MI_NODISCARD MI_CONSTEXPR_17 const_reference front() const {
+      return _container[0];
+    }
+
+    MI_NODISCARD MI_CONSTEXPR_17 const_reference back() const {
+      return _container[Size - 1];
+    }
+
+  public:
+    MI_NODISCARD MI_CONSTEXPR_17 const_pointer data() const {
+      return _container.data();
+    }
+
+  public:
+    MI_NODISCARD MI_CONSTEXPR_17 bool contains(const Ty& value) const {
+      for (const auto& element: _container) {
+        if (element == value) {
+          return true;
+        }
+      }
+
+      return false;
+    }
+
+  public:
+    MI_NODISCARD friend MI_CONSTEXPR_17 bool operator==(const sorted_array& lhs, const sorted_array& rhs) {
+      for (size_type i = 0; i < Size; ++i) {
+        if (!(lhs._container[i] == rhs._container[i])) {
+          return false;
+        }
+      }
+
+      return true;
+    }
+
+    MI_NODISCARD friend MI_CONSTEXPR_17 bool operator!=(const sorted_array& lhs, const sorted_array& rhs) {
+      return !(lhs == rhs);
+    }
+
+    MI_NODISCARD friend MI_CONSTEXPR_17 bool operator<(const sorted_array& lhs, const sorted_array& rhs) {
+      for (size_type i = 0; i < Size; ++i) {
+        if (lhs._container[i] < rhs._container[i]) {
+          return true;
+        }
+
+        if (rhs._container[i] < lhs._container[i]) {
+          return false;
+        }
+      }
+
+      return false;
+    }
+
+    MI_NODISCARD friend MI_CONSTEXPR_17 bool operator>(const sorted_array& lhs, const sorted_array& rhs) {
+      return rhs < lhs;
+    }
+
+    MI_NODISCARD friend MI_CONSTEXPR_17 bool operator<=(const sorted_array& lhs, const sorted_array& rhs) {
+      return !(lhs > rhs);
+    }
+
+    MI_NODISCARD friend MI_CONSTEXPR_17 bool operator>=(const sorted_array& lhs, const sorted_array& rhs) {
+      return !(lhs < rhs);
+    }
+
+  private:
+    container_type _container;  // Контейнер, всегда отсортирован
+};
+
+template<class Ty, size_t Size>
+MI_CONSTEXPR_17 void swap(sorted_array<Ty, Size>& lhs, sorted_array<Ty, Size>& rhs) noexcept(noexcept(lhs.swap(rhs))) {
+  lhs.swap(rhs);
+}
+
+// Создать полный список простых типов
+MI_MAKE_TYPEDEFS_SIMPLE_ALL_SIZES_FOR(sorted_array)
+
+// Создать полный список всех производных типов sorted_array
+MI_MAKE_TYPEDEFS_ALL_SIZES_FOR(sorted_array, bool, b);
+
+MI_MAKE_TYPEDEFS_ALL_SIZES_FOR(sorted_array, char, c);
+MI_MAKE_TYPEDEFS_ALL_SIZES_FOR(sorted_array, signed char, sc);
+MI_MAKE_TYPEDEFS_ALL_SIZES_FOR(sorted_array, unsigned char, uc);
+#if MI_CPP_VERSION == 20
+MI_MAKE_TYPEDEFS_ALL_SIZES_FOR(sorted_array, char8_t, c8);
+#endif
+MI_MAKE_TYPEDEFS_ALL_SIZES_FOR(sorted_array, char16_t, c16);
+MI_MAKE_TYPEDEFS_ALL_SIZES_FOR(sorted_array, char32_t, c32);
+MI_MAKE_TYPEDEFS_ALL_SIZES_FOR(sorted_array, wchar_t, wc);
+
+MI_MAKE_TYPEDEFS_ALL_SIZES_FOR(sorted_array, short, s);
+MI_MAKE_TYPEDEFS_ALL_SIZES_FOR(sorted_array, int, i);
+MI_MAKE_TYPEDEFS_ALL_SIZES_FOR(sorted_array, long, l);  //-V126
+MI_MAKE_TYPEDEFS_ALL_SIZES_FOR(sorted_array, long long, ll);
+
+MI_MAKE_TYPEDEFS_ALL_SIZES_FOR(sorted_array, unsigned short, us);
+MI_MAKE_TYPEDEFS_ALL_SIZES_FOR(sorted_array, unsigned int, ui);
+MI_MAKE_TYPEDEFS_ALL_SIZES_FOR(sorted_array, unsigned long, ul);  //-V126
+MI_MAKE_TYPEDEFS_ALL_SIZES_FOR(sorted_array, unsigned long long, ull);
+
+MI_MAKE_TYPEDEFS_ALL_SIZES_FOR(sorted_array, float, f);
+MI_MAKE_TYPEDEFS_ALL_SIZES_FOR(sorted_array, double, d);
+MI_MAKE_TYPEDEFS_ALL_SIZES_FOR(sorted_array, long double, ld);
+
+MI_MAKE_TYPEDEFS_ALL_SIZES_FOR(sorted_array, STD size_t, n);
+MI_MAKE_TYPEDEFS_ALL_SIZES_FOR(sorted_array, STD ptrdiff_t, p);
+
+MI_MAKE_TYPEDEFS_ALL_SIZES_FOR(sorted_array, STD int8_t, i8);
+MI_MAKE_TYPEDEFS_ALL_SIZES_FOR(sorted_array, STD int16_t, i16);
+MI_MAKE_TYPEDEFS_ALL_SIZES_FOR(sorted_array, STD int32_t, i32);
+MI_MAKE_TYPEDEFS_ALL_SIZES_FOR(sorted_array, STD int64_t, i64);
+
+MI_MAKE_TYPEDEFS_ALL_SIZES_FOR(sorted_array, STD uint8_t, u8);
+MI_MAKE_TYPEDEFS_ALL_SIZES_FOR(sorted_array, STD uint16_t, u16);
+MI_MAKE_TYPEDEFS_ALL_SIZES_FOR(sorted_array, STD uint32_t, u32);
+MI_MAKE_TYPEDEFS_ALL_SIZES_FOR(sorted_array, STD uint64_t, u64);
+
+}  // namespace mi
+
+template<class Ty, size_t Size>
+struct mi::hash<MI sorted_array<Ty, Size>> {
+    STD size_t operator()(const sorted_array<Ty, Size>& s) const {
+      STD size_t seed(0);
+
+      for (const auto& val: s) {
+        const STD size_t hash_val = MI hash<Ty>{}(val);
+        seed                      = MI hash_combine(seed, hash_val);
+      }
+
+      return seed;
+    }
+};
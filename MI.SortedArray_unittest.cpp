@@ -0,0 +1,112 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "Base/Ranges/MI.Algorithm.h"
+#include "Base/Test/MI.GTestUtil.h"
+#include "Container/MI.RadixSort.h"
+#include "Container/MI.SortedArray.h"
+
+namespace mi::test {
+static_assert(sizeof(MI sorted_array3i) == 3 * sizeof(int), "");
+static_assert(sizeof(MI sorted_array2n) == 2 * sizeof(STD size_t), "");
+static_assert(STD is_trivially_copyable_v<MI sorted_array3i>, "");
+static_assert(STD is_same_v<MI sorted_array3<int>, MI sorted_array3i>, "");
+
+TEST(SortedArray, DefaultConstructor) {
+  MI sorted_array3i value;
+
+  EXPECT_EQ(value.size(), 3);
+  EXPECT_FALSE(value.empty());
+  EXPECT_THAT(value, testing::ElementsAre(0, 0, 0));
+}
+
+TEST(SortedArray, InitListConstructor) {
+  MI sorted_array3i sort   = {0, 1, 2};
+  MI sorted_array3i unsort = {2, 0, 1};
+
+  EXPECT_THAT(sort, testing::ElementsAre(0, 1, 2));
+  EXPECT_THAT(unsort, testing::ElementsAre(0, 1, 2));
+
+  EXPECT_TRUE(MI ranges::is_sorted(unsort));
+  MI_EXPECT_CHECK_DEATH((MI sorted_array3i{1, 2}));
+}
+
+TEST(SortedArray, InitListOperator) {
+  MI sorted_array3i sort;
+
+  sort = {5, 4, 3};
+
+  EXPECT_THAT(sort, testing::ElementsAre(3, 4, 5));
+}
+
+TEST(SortedArray, IteratorConstructor) {
+  STD array<int, 3> ar = {2, 0, 1};
+  MI sorted_array3i sort(ar.begin(), ar.end());
+
+  ASSERT_THAT(ar, testing::ElementsAre(2, 0, 1));
+  ASSERT_THAT(sort, testing::ElementsAre(0, 1, 2));
+}
+
+TEST(SortedArray, SequenceCopyConstructor) {
+  int ar[3] = {2, 0, 1};
+
+  MI sorted_array3i sort(ar);
+
+  ASSERT_THAT(sort, testing::ElementsAre(0, 1, 2));
+}
+
+TEST(SortedArray, FromSortable) {
+  const MI sortable3i     key = {7, 3, 5};
+  const MI sorted_array3i compact(key);
+
+  EXPECT_THAT(compact, testing::ElementsAre(3, 5, 7));
+}
+
+TEST(SortedArray, Swap) {
+  MI sorted_array3i lhs({0, 1, 2});
+  MI sorted_array3i rhs({3, 4, 5});
+
+  MI swap(lhs, rhs);
+
+  ASSERT_THAT(lhs, testing::ElementsAre(3, 4, 5));
+  ASSERT_THAT(rhs, testing::ElementsAre(0, 1, 2));
+}
+
+TEST(SortedArray, Compare) {
+  constexpr MI sorted_array3i a = {2, 1, 0};
+  constexpr MI sorted_array3i b = {0, 1, 3};
+
+  static_assert(a == MI sorted_array3i{0, 1, 2}, "");
+  static_assert(a < b, "");
+  static_assert(b > a, "");
+  static_assert(a != b, "");
+  static_assert(a.contains(2) && !a.contains(3), "");
+}
+
+TEST(SortedArray, Constexpr) {
+  constexpr MI sorted_array2n s2 = {2, 1};
+  constexpr MI sorted_array5n s5 = {11, 2, 1, 0, 13};
+
+  static_assert(s2.front() == 1 && s2.back() == 2, "");
+  static_assert(s5[0] == 0 && s5[4] == 13, "");
+}
+
+TEST(SortedArray, RadixSort) {
+  STD vector<MI sorted_array3i> faces = {
+    {3, 1, 2},
+    {0, 0, 1},
+    {5, -1, 2},
+    {0, 0, 0}
+  };
+
+  MI radix_sort(faces.begin(), faces.end());
+
+  EXPECT_THAT(faces,
+              testing::ElementsAre(MI sorted_array3i{-1, 2, 5},
+                                   MI sorted_array3i{0, 0, 0},
+                                   MI sorted_array3i{0, 0, 1},
+                                   MI sorted_array3i{1, 2, 3}));
+}
+}  // namespace mi::test
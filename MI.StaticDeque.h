@@ -0,0 +1,460 @@
+﻿#pragma once
+
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "Common/MI.Check.h"
+#include "Common/MI.If.h"
+#include "Common/MI.IsIterator.h"
+
+// Очередь с двумя концами фиксированной емкости (кольцевой буфер).
+// ================================================================
+//
+// Для обхода в ширину по окрестностям элементов (распространение фронта, наращивание патча) нужна небольшая очередь
+// FIFO, которую MI static_vector не заменяет: у него нет pop_front. static_deque хранит значения в STD array, как
+// MI static_vector, и не выделяет память.
+//
+// Размер хранилища - наименьшая степень двойки, не меньшая Size, поэтому позиция в кольце вычисляется маской, а не
+// делением. max_size() при этом равен Size.
+//
+// MI static_deque<size_t, 64> front;
+//
+// front.push_back(n_seed);
+//
+// while (!front.empty()) {
+//   const size_t n_element = front.front();
+//   front.pop_front();
+//   ...
+// }
+namespace mi {
+namespace internal {
+constexpr size_t ring_capacity(const size_t size) noexcept {
+  size_t result = 1;
+
+  while (result < size) {
+    result *= 2;
+  }
+
+  return result;
+}
+
+template<class Deque, class Ty>
+class static_deque_iterator {
+    template<class, class>
+    friend class static_deque_iterator;
+
+  public:
+    using iterator_category = STD random_access_iterator_tag;
+    using value_type        = STD remove_const_t<Ty>;
+    using difference_type   = STD ptrdiff_t;
+    using pointer           = Ty*;
+    using reference         = Ty&;
+
+  public:
+    MI_CONSTEXPR_17 static_deque_iterator() = default;
+
+    MI_CONSTEXPR_17 static_deque_iterator(Deque* const deque, const size_t pos) noexcept
+        : _deque(deque),
+          _pos(pos) {
+    }
+
+    // iterator -> const_iterator.
+    template<class OtherDeque,
+             class OtherTy,
+             if_t<!STD is_same_v<OtherDeque, Deque> && STD is_convertible_v<OtherDeque*, Deque*>> = 0>
+    MI_CONSTEXPR_17 static_deque_iterator(const static_deque_iterator<OtherDeque, OtherTy>& other) noexcept
+        : _deque(other._deque),
+          _pos(other._pos) {
+    }
+
+  public:
+    MI_NODISCARD MI_CONSTEXPR_17 reference operator*() const {
+      return (*_deque)[_pos];
+    }
+
+    MI_NODISCARD MI_CONSTEXPR_17 pointer operator->() const {
+      return STD addressof(**this);
+    }
+
+    MI_NODISCARD MI_CONSTEXPR_17 reference operator[](const difference_type offset) const {
+      return *(*this + offset);
+    }
+
+  public:
+    MI_CONSTEXPR_17 static_deque_iterator& operator++() noexcept {
+      ++_pos;
+
+      return *this;
+    }
+
+    MI_CONSTEXPR_17 static_deque_iterator operator++(int) noexcept {
+      static_deque_iterator result = *this;
+      ++_pos;
+
+      return result;
+    }
+
+    MI_CONSTEXPR_17 static_deque_iterator& operator--() noexcept {
+      --_pos;
+
+      return *this;
+    }
+
+    MI_CONSTEXPR_17 static_deque_iterator operator--(int) noexcept {
+      static_deque_iterator result = *this;
+      --_pos;
+
+      return result;
+    }
+
+    MI_CONSTEXPR_17 static_deque_iterator& operator+=(const difference_type offset) noexcept {
+      _pos = static_cast<size_t>(static_cast<difference_type>(_pos) + offset);
+
+      return *this;
+    }
+
+    MI_CONSTEXPR_17 static_deque_iterator& operator-=(const difference_type offset) noexcept {
+      return *this += -offset;
+    }
+
+  public:
+    MI_NODISCARD friend MI_CONSTEXPR_17 static_deque_iterator operator+(static_deque_iterator it,
+                                                                        const difference_type offset) noexcept {
+      return it += offset;
+    }
+
+    MI_NODISCARD friend MI_CONSTEXPR_17 static_deque_iterator operator+(const difference_type offset,
+                                                                        static_deque_iterator it) noexcept {
+      return it += offset;
+    }
+
+    MI_NODISCARD friend MI_CONSTEXPR_17 static_deque_iterator operator-(static_deque_iterator it,
+                                                                        const difference_type offset) noexcept {
+      return it -= offset;
+    }
+
+    MI_NODISCARD friend MI_CONSTEXPR_17 difference_type operator-(const static_deque_iterator& lhs,
+                                                                  const static_deque_iterator& rhs) noexcept {
+      return static_cast<difference_type>(lhs._pos) - static_cast<difference_type>(rhs._pos);
+    }
+
+  public:
+    MI_NODISCARD friend MI_CONSTEXPR_17 bool operator==(const static_deque_iterator& lhs,
+                                                        const static_deque_iterator& rhs) noexcept {
+      return lhs._pos == rhs._pos;
+    }
+
+    MI_NODISCARD friend MI_CONSTEXPR_17 bool operator!=(const static_deque_iterator& lhs,
+                                                        const static_deque_iterator& rhs) noexcept {
+      return !(lhs == rhs);
+    }
+
+    MI_NODISCARD friend MI_CONSTEXPR_17 bool operator<(const static_deque_iterator& lhs,
+                                                       const static_deque_iterator& rhs) noexcept {
+      return lhs._pos < rhs._pos;
+    }
+
+    MI_NODISCARD friend MI_CONSTEXPR_17 bool operator>(const static_deque_iterator& lhs,
+                                                       const static_deque_iterator& rhs) noexcept {
+      return rhs < lhs;
+    }
+
+    MI_NODISCARD friend MI_CONSTEXPR_17 bool operator<=(const static_deque_iterator& lhs,
+                                                        const static_deque_iterator& rhs) noexcept {
+      return !(rhs < lhs);
+    }
+
+    MI_NODISCARD friend MI_CONSTEXPR_17 bool operator>=(const static_deque_iterator& lhs,
+                                                        const static_deque_iterator& rhs) noexcept {
+      return !(lhs < rhs);
+    }
+
+  private:
+    Deque* _deque = nullptr;  // Очередь
+    size_t _pos   = 0;        // Номер значения от начала очереди
+};
+}  // namespace internal
+
+template<class Ty, size_t Size>
+class static_deque {
+  public:
+    using static_capacity = STD integral_constant<size_t, Size>;
+
+  public:
+    using container_type = STD array<Ty, internal::ring_capacity(Size)>;
+
+  public:
+    using value_type = typename container_type::value_type;
+
+    using size_type       = typename container_type::size_type;
+    using difference_type = typename container_type::difference_type;
+
+    using pointer       = typename container_type::pointer;
+    using const_pointer = typename container_type::const_pointer;
+
+    using reference       = typename container_type::reference;
+    using const_reference = typename container_type::const_reference;
+
+    using iterator               = internal::static_deque_iterator<static_deque, Ty>;
+    using const_iterator         = internal::static_deque_iterator<const static_deque, const Ty>;
+    using reverse_iterator       = STD reverse_iterator<iterator>;
+    using const_reverse_iterator = STD reverse_iterator<const_iterator>;
+
+  private:
+    static constexpr size_type _mask = internal::ring_capacity(Size) - 1;
+
+    MI_NODISCARD MI_CONSTEXPR_17 size_type _slot(const size_type pos) const noexcept {
+      return (_first + pos) & _mask;
+    }
+
+  public:
+    MI_CONSTEXPR_17 static_deque()
+        : _container(container_type{}),
+          _first(size_type{0}),
+          _size(size_type{0}) {
+    }
+
+    MI_CONSTEXPR_17 static_deque(STD initializer_list<value_type> list)
+        : static_deque() {
+      MI_CHECK(list.size() <= static_capacity::value);
+
+      for (const auto& element: list) {
+        emplace_back(element);
+      }
+    }
+
+    template<class ItTy, if_t<is_iterator_v<ItTy>> = 0>
+    MI_CONSTEXPR_17 static_deque(ItTy first, ItTy last)
+        : static_deque() {
+      append(first, last);
+    }
+
+  public:
+    MI_NODISCARD MI_CONSTEXPR_17 size_type size() const {
+      return _size;
+    }
+
+    MI_NODISCARD MI_CONSTEXPR_17 static size_type max_size() {
+      return static_capacity::value;
+    }
+
+    MI_NODISCARD MI_CONSTEXPR_17 bool empty() const {
+      return _size == 0;
+    }
+
+    MI_NODISCARD MI_CONSTEXPR_17 bool full() const {
+      return _size == max_size();
+    }
+
+  public:
+    MI_NODISCARD MI_CONSTEXPR_17 iterator begin() {
+      return iterator{this, 0};
+    }
+
+    MI_NODISCARD MI_CONSTEXPR_17 const_iterator begin() const {
+      return const_iterator{this, 0};
+    }
+
+    MI_NODISCARD MI_CONSTEXPR_17 iterator end() {
+      return iterator{this, _size};
+    }
+
+    MI_NODISCARD MI_CONSTEXPR_17 const_iterator end() const {
+      return const_iterator{this, _size};
+    }
+
+  public:
+    MI_NODISCARD MI_CONSTEXPR_17 reverse_iterator rbegin() {
+      return reverse_iterator{end()};
+    }
+
+    MI_NODISCARD MI_CONSTEXPR_17 const_reverse_iterator rbegin() const {
+      return const_reverse_iterator{end()};
+    }
+
+    MI_NODISCARD MI_CONSTEXPR_17 reverse_iterator rend() {
+      return reverse_iterator{begin()};
+    }
+
+    MI_NODISCARD MI_CONSTEXPR_17 const_reverse_iterator rend() const {
+      return const_reverse_iterator{begin()};
+    }
+
+  public:
+    MI_NODISCARD MI_CONSTEXPR_17 const_iterator cbegin() const {
+      return begin();
+    }
+
+    MI_NODISCARD MI_CONSTEXPR_17 const_iterator cend() const {
+      return end();
+    }
+
+    MI_NODISCARD MI_CONSTEXPR_17 const_reverse_iterator crbegin() const {
+      return rbegin();
+    }
+
+    MI_NODISCARD MI_CONSTEXPR_17 const_reverse_iterator crend() const {
+      return rend();
+    }
+
+  public:
+    MI_NODISCARD MI_CONSTEXPR_17 reference at(const size_type pos) {
+      MI_CHECK(pos < size());
+
+      return _container[_slot(pos)];
+    }
+
+    MI_NODISCARD MI_CONSTEXPR_17 const_reference at(const size_type pos) const {
+      MI_CHECK(pos < size());
+
+      return _container[_slot(pos)];
+    }
+
+  public:
+    MI_NODISCARD MI_CONSTEXPR_17 reference operator[](const size_type pos) {
+      MI_DCHECK(pos < _size);
+
+      return _container[_slot(pos)];
+    }
+
+    MI_NODISCARD MI_CONSTEXPR_17 const_reference operator[](const size_type pos) const {
+      MI_DCHECK(pos < _size);
+
+      return _container[_slot(pos)];
+    }
+
+  public:
+    MI_NODISCARD MI_CONSTEXPR_17 reference front() {
+      MI_DCHECK(!empty());
+
+      return _container[_first];
+    }
+
+    MI_NODISCARD MI_CONSTEXPR_17 const_reference front() const {
+      MI_DCHECK(!empty());
+
+      return _container[_first];
+    }
+
+  public:
+    MI_NODISCARD MI_CONSTEXPR_17 reference back() {
+      MI_DCHECK(!empty());
+
+      return _container[_slot(_size - 1)];
+    }
+
+    MI_NODISCARD MI_CONSTEXPR_17 const_reference back() const {
+      MI_DCHECK(!empty());
+
+      return _container[_slot(_size - 1)];
+    }
+
+  public:
+    MI_NODISCARD friend MI_CONSTEXPR_17 bool operator==(const static_deque& lhs, const static_deque& rhs) {
+      if (lhs.size() != rhs.size()) {
+        return false;
+      }
+
+      for (size_type i = 0; i < lhs.size(); ++i) {
+        if (!(lhs[i] == rhs[i])) {
+          return false;
+        }
+      }
+
+      return true;
+    }
+
+    MI_NODISCARD friend MI_CONSTEXPR_17 bool operator!=(const static_deque& lhs, const static_deque& rhs) {
+      return !(lhs == rhs);
+    }
+
+  public:
+    template<class... TyVal>
+    MI_CONSTEXPR_17 void emplace_back(TyVal&&... values) {
+      MI_CHECK(!full());
+
+      _container[_slot(_size)] = {STD forward<TyVal>(values)...};
+      ++_size;
+    }
+
+    template<class... TyVal>
+    MI_CONSTEXPR_17 void push_back(TyVal&&... values) {
+      emplace_back(STD forward<TyVal>(values)...);
+    }
+
+    template<class... TyVal>
+    MI_CONSTEXPR_17 void emplace_front(TyVal&&... values) {
+      MI_CHECK(!full());
+
+      _first             = (_first + _mask) & _mask;
+      _container[_first] = {STD forward<TyVal>(values)...};
+      ++_size;
+    }
+
+    template<class... TyVal>
+    MI_CONSTEXPR_17 void push_front(TyVal&&... values) {
+      emplace_front(STD forward<TyVal>(values)...);
+    }
+
+  public:
+    // Освободившаяся ячейка сбрасывается в value_type{}, как в MI static_vector.
+    MI_CONSTEXPR_17 void pop_front() {
+      MI_DCHECK(!empty());
+
+      _container[_first] = value_type{};
+      _first             = (_first + 1) & _mask;
+      --_size;
+    }
+
+    MI_CONSTEXPR_17 void pop_back() {
+      MI_DCHECK(!empty());
+
+      --_size;
+      _container[_slot(_size)] = value_type{};
+    }
+
+  public:
+    // Добавляет [first; last) в конец. Диапазон должен поместиться целиком.
+    template<class ItTy, if_t<is_iterator_v<ItTy>> = 0>
+    MI_CONSTEXPR_17 void append(ItTy first, const ItTy last) {
+      for (; first != last; ++first) {
+        emplace_back(*first);
+      }
+    }
+
+    // Переносит в out не больше count значений из начала очереди. Возвращает количество перенесенных значений.
+    template<class OutTy>
+    MI_CONSTEXPR_17 size_type pop_front(OutTy out, const size_type count) {
+      const size_type n_values = count < _size ? count : _size;
+
+      for (size_type i = 0; i < n_values; ++i) {
+        *out = STD move(_container[_slot(i)]);
+        ++out;
+
+        _container[_slot(i)] = value_type{};
+      }
+
+      _first = _slot(n_values);
+      _size -= n_values;
+
+      return n_values;
+    }
+
+  public:
+    MI_CONSTEXPR_17 void clear() {
+      _container = container_type{};
+      _first     = size_type{0};
+      _size      = size_type{0};
+    }
+
+  private:
+    container_type _container;  // Кольцо
+    size_type      _first;      // Ячейка начала очереди
+    size_type      _size;       // Текущий размер очереди
+};
+}  // namespace mi
@@ -0,0 +1,207 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <iterator>
+#include <memory>
+#include <vector>
+
+#include "Base/Test/MI.GTestUtil.h"
+#include "Container/MI.StaticDeque.h"
+
+namespace mi::test {
+namespace {
+// Первые count значений после прохода кольца по кругу.
+constexpr int wrapped_sum(const int count) {
+  MI static_deque<int, 3> a;
+
+  int result = 0;
+
+  for (int i = 0; i < count; ++i) {
+    if (a.full()) {
+      result += a.front();
+      a.pop_front();
+    }
+
+    a.push_back(i);
+  }
+
+  for (const int value: a) {
+    result += value;
+  }
+
+  return result;
+}
+}  // namespace
+
+TEST(StaticDeque, DefaultConstructor) {
+  MI static_deque<int, 1> a;
+  MI static_deque<int, 3> b;
+
+  EXPECT_TRUE(a.empty());
+  EXPECT_TRUE(b.empty());
+}
+
+TEST(StaticDeque, InitListConstructor) {
+  MI static_deque<int, 3> a = {1, 2, 3};
+
+  EXPECT_TRUE(a.full());
+  EXPECT_THAT(a, testing::ElementsAre(1, 2, 3));
+}
+
+TEST(StaticDeque, IteratorConstructor) {
+  const STD vector<int>   values = {1, 2};
+  MI static_deque<int, 5> a(values.begin(), values.end());
+
+  EXPECT_THAT(a, testing::ElementsAre(1, 2));
+}
+
+TEST(StaticDeque, MaxSize) {
+  // Хранилище округляется до степени двойки, емкость - нет.
+  GTEST_ASSERT_EQ((MI static_deque<int, 3>::max_size()), 3);
+  GTEST_ASSERT_EQ((STD tuple_size_v<MI static_deque<int, 3>::container_type>), 4);
+  GTEST_ASSERT_EQ((STD tuple_size_v<MI static_deque<int, 8>::container_type>), 8);
+}
+
+TEST(StaticDeque, PushPop) {
+  MI static_deque<int, 4> a;
+
+  a.push_back(2);
+  a.push_back(3);
+  a.push_front(1);
+  a.emplace_front(0);
+
+  EXPECT_TRUE(a.full());
+  EXPECT_THAT(a, testing::ElementsAre(0, 1, 2, 3));
+  EXPECT_EQ(a.front(), 0);
+  EXPECT_EQ(a.back(), 3);
+
+  a.pop_front();
+  a.pop_back();
+
+  EXPECT_THAT(a, testing::ElementsAre(1, 2));
+  EXPECT_THAT(STD vector<int>(a.rbegin(), a.rend()), testing::ElementsAre(2, 1));
+}
+
+TEST(StaticDeque, WrapAround) {
+  MI static_deque<int, 3> a;
+
+  for (int i = 0; i < 10; ++i) {
+    if (a.full()) {
+      a.pop_front();
+    }
+
+    a.push_back(i);
+  }
+
+  EXPECT_THAT(a, testing::ElementsAre(7, 8, 9));
+  EXPECT_EQ(a[0], 7);
+  EXPECT_EQ(a.at(2), 9);
+  EXPECT_EQ(a.end() - a.begin(), 3);
+}
+
+TEST(StaticDeque, ConstIterator) {
+  MI static_deque<int, 4> a = {1, 2, 3};
+
+  a.pop_front();
+  a.push_back(4);
+  a.push_back(5);
+
+  using const_iterator = MI static_deque<int, 4>::const_iterator;
+
+  const const_iterator first = a.begin();
+
+  EXPECT_TRUE(first == a.cbegin());
+  EXPECT_TRUE(a.end() == a.cend());
+  EXPECT_TRUE(a.begin() < a.cend());
+  EXPECT_EQ(a.cend() - a.begin(), 4);
+  EXPECT_THAT(STD vector<int>(first, a.cend()), testing::ElementsAre(2, 3, 4, 5));
+  EXPECT_THAT(STD vector<int>(a.crbegin(), a.crend()), testing::ElementsAre(5, 4, 3, 2));
+}
+
+TEST(StaticDeque, RemovedValuesAreReset) {
+  const auto value = STD make_shared<int>(1);
+
+  MI static_deque<STD shared_ptr<int>, 4> a;
+
+  for (int i = 0; i < 4; ++i) {
+    a.push_back(value);
+  }
+
+  EXPECT_EQ(value.use_count(), 5);
+
+  a.pop_front();
+  a.pop_back();
+
+  EXPECT_EQ(value.use_count(), 3);
+
+  STD vector<STD shared_ptr<int>> out;
+  a.pop_front(STD back_inserter(out), 1);
+  out.clear();
+
+  EXPECT_EQ(value.use_count(), 2);
+
+  a.push_front(value);
+  a.clear();
+
+  EXPECT_EQ(value.use_count(), 1);
+}
+
+TEST(StaticDeque, Bulk) {
+  MI static_deque<int, 6> a;
+
+  const int values[] = {1, 2, 3, 4, 5};
+
+  a.append(STD begin(values), STD end(values));
+  a.pop_front();
+  a.pop_front();
+  a.append(STD begin(values), STD begin(values) + 3);
+
+  EXPECT_THAT(a, testing::ElementsAre(3, 4, 5, 1, 2, 3));
+
+  STD vector<int> out;
+
+  EXPECT_EQ(a.pop_front(STD back_inserter(out), 4), 4);
+  EXPECT_EQ(a.pop_front(STD back_inserter(out), 4), 2);
+  EXPECT_THAT(out, testing::ElementsAre(3, 4, 5, 1, 2, 3));
+  EXPECT_TRUE(a.empty());
+}
+
+TEST(StaticDeque, Constexpr) {
+  static_assert(wrapped_sum(2) == 1, "");
+  static_assert(wrapped_sum(10) == 45, "");
+
+  constexpr MI static_deque<int, 3> a = {1, 2, 3};
+
+  static_assert(a.front() == 1 && a.back() == 3, "");
+  static_assert(a.end() - a.begin() == 3, "");
+}
+
+TEST(StaticDeque, Equal) {
+  MI static_deque<int, 3> a = {1, 2, 3};
+  MI static_deque<int, 3> b = {0, 1, 2};
+
+  b.pop_front();
+  b.push_back(3);
+
+  EXPECT_EQ(a, b);
+
+  b.pop_back();
+
+  EXPECT_NE(a, b);
+}
+
+TEST(StaticDeque, At) {
+  constexpr MI static_deque<int, 3> m = {1, 2};
+
+  GTEST_ASSERT_EQ(m.at(0), 1);
+  GTEST_ASSERT_EQ(m.at(1), 2);
+  MI_EXPECT_CHECK_DEATH((MI_DISABLE_4834)m.at(2));
+}
+
+TEST(StaticDeque, Overflow) {
+  MI static_deque<int, 2> a = {1, 2};
+
+  MI_EXPECT_CHECK_DEATH(a.push_back(3));
+  MI_EXPECT_CHECK_DEATH(a.push_front(0));
+}
+}  // namespace mi::test
@@ -233,6 +233,24 @@ class strong_alias {
     underlying_type _value;
 };
 
+// Является ли тип strong_alias.
+template<class Ty>
+struct is_strong_alias : STD false_type {};
+
+template<class Tag, class Underlying>
+struct is_strong_alias<strong_alias<Tag, Underlying>> : STD true_type {};
+
+template<class Ty>
+constexpr bool is_strong_alias_v = is_strong_alias<STD remove_cv_t<Ty>>::value;
+
+// Массив strong_alias можно рассматривать как массив underlying_type (и наоборот), если у них совпадают
+// размер и выравнивание, а сам алиас - standard layout и тривиально копируемый.
+template<class Alias>
+constexpr bool is_layout_compatible_alias_v =
+  is_strong_alias_v<Alias> && sizeof(Alias) == sizeof(typename Alias::underlying_type) &&
+  alignof(Alias) == alignof(typename Alias::underlying_type) && STD is_standard_layout_v<Alias> &&
+  STD is_trivially_copyable_v<Alias>;
+
 template<class Tag, class Underlying, MI if_t<MI internal::supports_ostream_operator<Underlying>::value> = 0>
 constexpr STD ostream& operator<<(STD ostream& str, const strong_alias<Tag, Underlying>& descriptor) {
   str << descriptor.value();
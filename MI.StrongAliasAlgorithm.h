@@ -0,0 +1,127 @@
+﻿#pragma once
+
+#include <algorithm>
+#include <utility>
+
+#include "Common/MI.Check.h"
+#include "Common/MI.StrongAlias.h"
+#include "Container/MI.TypedVector.h"
+
+// Массовые операции над диапазонами strong_alias.
+// ============================================
+//
+// Поэлементный цикл вида `for (auto& v: vertices) v += offset;` проходит через operator+= обертки, и компилятор
+// не всегда его векторизует. Функции ниже получают underlying_span() и работают с обычными целыми в простом цикле
+// без ветвлений и вызовов, поэтому генерируют тот же SIMD-код, что и аналогичные функции над int/size_t
+// (см. MI.StrongAliasAlgorithm_benchmark.cpp).
+//
+// Все функции принимают typed_span<Index, Alias>, где Alias - strong_alias, совместимый по раскладке с
+// underlying_type (MI internal::is_layout_compatible_alias_v).
+namespace mi {
+namespace internal {
+template<class Alias>
+constexpr void check_bulk_alias() noexcept {
+  static_assert(is_layout_compatible_alias_v<Alias>, "bulk strong_alias algorithms require a layout compatible alias");
+  static_assert(STD is_arithmetic_v<typename Alias::underlying_type>,
+                "bulk strong_alias algorithms require an arithmetic underlying_type");
+}
+}  // namespace internal
+
+// Сдвигает все значения на delta (перенумерация при слиянии сеток).
+template<class Index, class Alias>
+void add_offset(const typed_span<Index, Alias> values, const typename Alias::underlying_type delta) noexcept {
+  internal::check_bulk_alias<Alias>();
+
+  auto* const  data = values.underlying_span().data();
+  const size_t size = values.size();
+
+  for (size_t i = 0; i < size; ++i) {
+    data[i] += delta;
+  }
+}
+
+// Заменяет каждое значение v на lookup[v] (применение перестановки или карты перенумерации).
+// lookup индексируется самим Alias: typed_vector<vertex_id, vertex_id> old_to_new.
+template<class Index, class Alias, class LookupTy>
+void remap(const typed_span<Index, Alias> values, const typed_span<Alias, LookupTy> lookup) {
+  static_assert(STD is_same_v<STD remove_const_t<LookupTy>, Alias>, "remap: lookup must map Alias to Alias");
+
+  internal::check_bulk_alias<Alias>();
+
+  auto* const       data       = values.underlying_span().data();
+  const auto* const table      = lookup.underlying_span().data();
+  const size_t      size       = values.size();
+  const size_t      table_size = lookup.size();
+
+  for (size_t i = 0; i < size; ++i) {
+    MI_DCHECK(static_cast<size_t>(data[i]) < table_size);
+
+    data[i] = table[static_cast<size_t>(data[i])];
+  }
+
+  static_cast<void>(table_size);
+}
+
+// Минимальное и максимальное значение. Диапазон не должен быть пустым.
+template<class Index, class Alias>
+MI_NODISCARD STD pair<STD remove_const_t<Alias>, STD remove_const_t<Alias>> minmax(
+  const typed_span<Index, Alias> values) {
+  using alias_type = STD remove_const_t<Alias>;
+
+  internal::check_bulk_alias<alias_type>();
+
+  MI_CHECK(!values.empty());
+
+  const auto* const data = values.underlying_span().data();
+  const size_t      size = values.size();
+
+  auto min_value = data[0];
+  auto max_value = data[0];
+
+  for (size_t i = 1; i < size; ++i) {
+    min_value = STD min(min_value, data[i]);
+    max_value = STD max(max_value, data[i]);
+  }
+
+  return {alias_type(min_value), alias_type(max_value)};
+}
+
+// Включающая префиксная сумма на месте: values[i] = values[0] + ... + values[i].
+// Возвращает сумму всех значений.
+template<class Index, class Alias>
+typename Alias::underlying_type inclusive_scan(const typed_span<Index, Alias> values) noexcept {
+  internal::check_bulk_alias<Alias>();
+
+  auto* const  data = values.underlying_span().data();
+  const size_t size = values.size();
+
+  typename Alias::underlying_type sum{};
+
+  for (size_t i = 0; i < size; ++i) {
+    sum += data[i];
+    data[i] = sum;
+  }
+
+  return sum;
+}
+
+// Исключающая префиксная сумма на месте: values[i] = values[0] + ... + values[i - 1], values[0] = 0.
+// Возвращает сумму всех значений. Превращает размеры строк в смещения (CSR).
+template<class Index, class Alias>
+typename Alias::underlying_type exclusive_scan(const typed_span<Index, Alias> values) noexcept {
+  internal::check_bulk_alias<Alias>();
+
+  auto* const  data = values.underlying_span().data();
+  const size_t size = values.size();
+
+  typename Alias::underlying_type sum{};
+
+  for (size_t i = 0; i < size; ++i) {
+    const auto value = data[i];
+    data[i]          = sum;
+    sum += value;
+  }
+
+  return sum;
+}
+}  // namespace mi
@@ -0,0 +1,202 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "Container/MI.StrongAliasAlgorithm.h"
+
+// Сравнение массовых операций над strong_alias с теми же циклами над "сырыми" int.
+// Пары BM_*Alias / BM_*Raw должны показывать одинаковую пропускную способность; если нет, обертка мешает векторизации.
+//
+// --benchmark_format=json для сохранения результатов.
+
+namespace mi::benchmark {
+MI_NEW_STRONG_ALIAS(bench_vertex_id, int);
+MI_NEW_STRONG_ALIAS(bench_slot_id, size_t);
+
+namespace {
+using alias_array = MI typed_vector<bench_slot_id, bench_vertex_id>;
+
+STD vector<int> make_indices(const size_t count) {
+  STD vector<int> indices(count);
+  STD iota(indices.begin(), indices.end(), 0);
+  STD shuffle(indices.begin(), indices.end(), STD mt19937(42));
+
+  return indices;
+}
+
+alias_array make_alias_indices(const size_t count) {
+  const STD vector<int> raw = make_indices(count);
+
+  alias_array result;
+  result.reserve(count);
+
+  for (const int value: raw) {
+    result.emplace_back(value);
+  }
+
+  return result;
+}
+
+void set_bytes_processed(::benchmark::State& state) {
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0) *
+                          static_cast<int64_t>(sizeof(int)));
+}
+}  // namespace
+
+void BM_AddOffsetAlias(::benchmark::State& state) {
+  alias_array values = make_alias_indices(static_cast<size_t>(state.range(0)));
+
+  for (auto _: state) {
+    MI add_offset(values.span(), 1);
+    ::benchmark::ClobberMemory();
+  }
+
+  set_bytes_processed(state);
+}
+
+void BM_AddOffsetRaw(::benchmark::State& state) {
+  STD vector<int> values = make_indices(static_cast<size_t>(state.range(0)));
+
+  for (auto _: state) {
+    int* const   data = values.data();
+    const size_t size = values.size();
+
+    for (size_t i = 0; i < size; ++i) {
+      data[i] += 1;
+    }
+
+    ::benchmark::ClobberMemory();
+  }
+
+  set_bytes_processed(state);
+}
+
+// Цикл через operator+= обертки, для сравнения.
+void BM_AddOffsetAliasLoop(::benchmark::State& state) {
+  alias_array values = make_alias_indices(static_cast<size_t>(state.range(0)));
+
+  for (auto _: state) {
+    for (auto& value: values) {
+      value += 1;
+    }
+
+    ::benchmark::ClobberMemory();
+  }
+
+  set_bytes_processed(state);
+}
+
+void BM_RemapAlias(::benchmark::State& state) {
+  const size_t count = static_cast<size_t>(state.range(0));
+
+  alias_array       values         = make_alias_indices(count);
+  const alias_array lookup_mapping = make_alias_indices(count);
+
+  const MI typed_vector<bench_vertex_id, bench_vertex_id> lookup(lookup_mapping.begin(), lookup_mapping.end());
+
+  for (auto _: state) {
+    MI remap(values.span(), lookup.span());
+    ::benchmark::ClobberMemory();
+  }
+
+  set_bytes_processed(state);
+}
+
+void BM_RemapRaw(::benchmark::State& state) {
+  const size_t count = static_cast<size_t>(state.range(0));
+
+  STD vector<int>       values = make_indices(count);
+  const STD vector<int> lookup = make_indices(count);
+
+  for (auto _: state) {
+    int* const       data  = values.data();
+    const int* const table = lookup.data();
+
+    for (size_t i = 0; i < count; ++i) {
+      data[i] = table[static_cast<size_t>(data[i])];
+    }
+
+    ::benchmark::ClobberMemory();
+  }
+
+  set_bytes_processed(state);
+}
+
+void BM_MinMaxAlias(::benchmark::State& state) {
+  const alias_array values = make_alias_indices(static_cast<size_t>(state.range(0)));
+
+  for (auto _: state) {
+    ::benchmark::DoNotOptimize(MI minmax(values.span()));
+  }
+
+  set_bytes_processed(state);
+}
+
+void BM_MinMaxRaw(::benchmark::State& state) {
+  const STD vector<int> values = make_indices(static_cast<size_t>(state.range(0)));
+
+  for (auto _: state) {
+    const int* const data = values.data();
+    const size_t     size = values.size();
+
+    int min_value = data[0];
+    int max_value = data[0];
+
+    for (size_t i = 1; i < size; ++i) {
+      min_value = STD min(min_value, data[i]);
+      max_value = STD max(max_value, data[i]);
+    }
+
+    ::benchmark::DoNotOptimize(min_value);
+    ::benchmark::DoNotOptimize(max_value);
+  }
+
+  set_bytes_processed(state);
+}
+
+void BM_ExclusiveScanAlias(::benchmark::State& state) {
+  alias_array values(static_cast<size_t>(state.range(0)), bench_vertex_id(1));
+
+  for (auto _: state) {
+    ::benchmark::DoNotOptimize(MI exclusive_scan(values.span()));
+  }
+
+  set_bytes_processed(state);
+}
+
+void BM_ExclusiveScanRaw(::benchmark::State& state) {
+  STD vector<int> values(static_cast<size_t>(state.range(0)), 1);
+
+  for (auto _: state) {
+    int* const   data = values.data();
+    const size_t size = values.size();
+
+    int sum = 0;
+
+    for (size_t i = 0; i < size; ++i) {
+      const int value = data[i];
+      data[i]         = sum;
+      sum += value;
+    }
+
+    ::benchmark::DoNotOptimize(sum);
+  }
+
+  set_bytes_processed(state);
+}
+
+BENCHMARK(BM_AddOffsetAlias)->Range(1 << 10, 1 << 24);
+BENCHMARK(BM_AddOffsetRaw)->Range(1 << 10, 1 << 24);
+BENCHMARK(BM_AddOffsetAliasLoop)->Range(1 << 10, 1 << 24);
+BENCHMARK(BM_RemapAlias)->Range(1 << 10, 1 << 24);
+BENCHMARK(BM_RemapRaw)->Range(1 << 10, 1 << 24);
+BENCHMARK(BM_MinMaxAlias)->Range(1 << 10, 1 << 24);
+BENCHMARK(BM_MinMaxRaw)->Range(1 << 10, 1 << 24);
+BENCHMARK(BM_ExclusiveScanAlias)->Range(1 << 10, 1 << 24);
+BENCHMARK(BM_ExclusiveScanRaw)->Range(1 << 10, 1 << 24);
+}  // namespace mi::benchmark
+
+BENCHMARK_MAIN();
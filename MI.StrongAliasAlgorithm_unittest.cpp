@@ -0,0 +1,56 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "Base/Test/MI.GTestUtil.h"
+#include "Container/MI.StrongAliasAlgorithm.h"
+
+namespace mi::test {
+MI_NEW_STRONG_ALIAS(bulk_vertex_id, int);
+MI_NEW_STRONG_ALIAS(bulk_slot_id, size_t);
+
+using vertex_array = MI typed_vector<bulk_slot_id, bulk_vertex_id>;
+
+TEST(StrongAliasAlgorithm, AddOffset) {
+  vertex_array vertices = {bulk_vertex_id(0), bulk_vertex_id(3), bulk_vertex_id(1)};
+
+  MI add_offset(vertices.span(), 10);
+
+  EXPECT_THAT(vertices, testing::ElementsAre(bulk_vertex_id(10), bulk_vertex_id(13), bulk_vertex_id(11)));
+}
+
+TEST(StrongAliasAlgorithm, Remap) {
+  vertex_array vertices = {bulk_vertex_id(0), bulk_vertex_id(2), bulk_vertex_id(2)};
+
+  const MI typed_vector<bulk_vertex_id, bulk_vertex_id> old_to_new = {bulk_vertex_id(5),
+                                                                      bulk_vertex_id(6),
+                                                                      bulk_vertex_id(7)};
+
+  MI remap(vertices.span(), old_to_new.span());
+
+  EXPECT_THAT(vertices, testing::ElementsAre(bulk_vertex_id(5), bulk_vertex_id(7), bulk_vertex_id(7)));
+}
+
+TEST(StrongAliasAlgorithm, MinMax) {
+  const vertex_array vertices = {bulk_vertex_id(4), bulk_vertex_id(-2), bulk_vertex_id(9), bulk_vertex_id(0)};
+
+  const auto [min_value, max_value] = MI minmax(vertices.span());
+
+  EXPECT_EQ(min_value, bulk_vertex_id(-2));
+  EXPECT_EQ(max_value, bulk_vertex_id(9));
+
+  const vertex_array empty;
+
+  MI_EXPECT_CHECK_DEATH((MI_DISABLE_4834)MI minmax(empty.span()));
+}
+
+TEST(StrongAliasAlgorithm, Scan) {
+  vertex_array inclusive = {bulk_vertex_id(1), bulk_vertex_id(2), bulk_vertex_id(3)};
+  vertex_array exclusive = inclusive;
+
+  EXPECT_EQ(MI inclusive_scan(inclusive.span()), 6);
+  EXPECT_EQ(MI exclusive_scan(exclusive.span()), 6);
+
+  EXPECT_THAT(inclusive, testing::ElementsAre(bulk_vertex_id(1), bulk_vertex_id(3), bulk_vertex_id(6)));
+  EXPECT_THAT(exclusive, testing::ElementsAre(bulk_vertex_id(0), bulk_vertex_id(1), bulk_vertex_id(3)));
+}
+}  // namespace mi::test
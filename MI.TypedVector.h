@@ -0,0 +1,358 @@
+﻿#pragma once
+
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+#include "Common/MI.Check.h"
+#include "Common/MI.If.h"
+#include "Common/MI.IsIterator.h"
+#include "Common/MI.StrongAlias.h"
+
+// Контейнеры, индексируемые только strong_alias.
+// ============================================
+//
+// MI_NEW_STRONG_ALIAS(vertex_id, size_t);
+// MI_NEW_STRONG_ALIAS(element_id, size_t);
+//
+// MI typed_vector<vertex_id, MI point3d> vertices;
+// vertices[vertex_id(0)];    // Компилируется.
+// vertices[element_id(0)];   // Не компилируется.
+// vertices[0];               // Не компилируется.
+//
+// Если элементы контейнера сами являются strong_alias (MI typed_vector<element_id, vertex_id>), то
+// underlying_span() возвращает представление тех же данных как массива underlying_type без копирования,
+// которое можно передать в векторизованные функции, работающие с "сырыми" целыми.
+namespace mi {
+namespace internal {
+// Тип элемента после снятия strong_alias с сохранением const.
+template<class Ty, class = void>
+struct underlying_element {
+    using type = Ty;
+};
+
+template<class Ty>
+struct underlying_element<Ty, STD enable_if_t<is_strong_alias_v<Ty>>> {
+    using type = STD conditional_t<STD is_const_v<Ty>,
+                                   const typename Ty::underlying_type,
+                                   typename Ty::underlying_type>;
+};
+
+template<class Ty>
+using underlying_element_t = typename underlying_element<Ty>::type;
+
+template<class Index>
+MI_NODISCARD constexpr size_t index_to_position(const Index index) noexcept {
+  return static_cast<size_t>(index.value());
+}
+}  // namespace internal
+
+template<class Index, class Ty>
+class typed_span {
+    static_assert(internal::is_strong_alias_v<Index>, "typed_span: index must be a strong_alias");
+    static_assert(STD is_integral_v<typename Index::underlying_type>, "typed_span: index must alias an integral type");
+
+  public:
+    using index_type = Index;
+
+    using element_type = Ty;
+    using value_type   = STD remove_cv_t<Ty>;
+
+    using size_type       = size_t;
+    using difference_type = STD ptrdiff_t;
+
+    using pointer   = Ty*;
+    using reference = Ty&;
+    using iterator  = Ty*;
+
+  public:
+    constexpr typed_span() noexcept = default;
+
+    constexpr typed_span(pointer data, const size_type size) noexcept
+        : _data(data),
+          _size(size) {
+    }
+
+    // Неявное преобразование typed_span<Index, Ty> -> typed_span<Index, const Ty>.
+    template<class OtherTy, if_t<STD is_convertible_v<OtherTy (*)[], Ty (*)[]>> = 0>
+    constexpr typed_span(const typed_span<Index, OtherTy>& other) noexcept
+        : _data(other.data()),
+          _size(other.size()) {
+    }
+
+  public:
+    MI_NODISCARD constexpr size_type size() const noexcept {
+      return _size;
+    }
+
+    MI_NODISCARD constexpr bool empty() const noexcept {
+      return _size == 0;
+    }
+
+    // Индекс за последним элементом.
+    MI_NODISCARD constexpr index_type end_index() const noexcept {
+      return index_type(static_cast<typename index_type::underlying_type>(_size));
+    }
+
+  public:
+    MI_NODISCARD constexpr iterator begin() const noexcept {
+      return _data;
+    }
+
+    MI_NODISCARD constexpr iterator end() const noexcept {
+      return _data + _size;
+    }
+
+    MI_NODISCARD constexpr pointer data() const noexcept {
+      return _data;
+    }
+
+  public:
+    MI_NODISCARD constexpr reference operator[](const index_type index) const {
+      MI_DCHECK(internal::index_to_position(index) < _size);
+
+      return _data[internal::index_to_position(index)];
+    }
+
+    MI_NODISCARD constexpr reference at(const index_type index) const {
+      MI_CHECK(internal::index_to_position(index) < _size);
+
+      return _data[internal::index_to_position(index)];
+    }
+
+    MI_NODISCARD constexpr reference front() const {
+      MI_DCHECK(!empty());
+
+      return _data[0];
+    }
+
+    MI_NODISCARD constexpr reference back() const {
+      MI_DCHECK(!empty());
+
+      return _data[_size - 1];
+    }
+
+  public:
+    MI_NODISCARD constexpr typed_span subspan(const index_type first, const size_type count) const {
+      MI_CHECK(internal::index_to_position(first) + count <= _size);
+
+      return {_data + internal::index_to_position(first), count};
+    }
+
+  public:
+    // Те же данные как массив underlying_type, индексируемый тем же Index.
+    MI_NODISCARD typed_span<Index, internal::underlying_element_t<Ty>> underlying_span() const noexcept {
+      static_assert(internal::is_strong_alias_v<Ty>, "underlying_span: element must be a strong_alias");
+      static_assert(internal::is_layout_compatible_alias_v<value_type>,
+                    "underlying_span: strong_alias must be layout compatible with its underlying_type");
+
+      // strong_alias - standard layout класс с единственным полем, поэтому указатель на него взаимно
+      // преобразуем с указателем на underlying_type.
+      return {reinterpret_cast<internal::underlying_element_t<Ty>*>(_data), _size};
+    }
+
+  private:
+    pointer   _data = nullptr;
+    size_type _size = 0;
+};
+
+template<class Index, class Ty>
+class typed_vector {
+    static_assert(internal::is_strong_alias_v<Index>, "typed_vector: index must be a strong_alias");
+    static_assert(STD is_integral_v<typename Index::underlying_type>,
+                  "typed_vector: index must alias an integral type");
+
+  public:
+    using index_type     = Index;
+    using container_type = STD vector<Ty>;
+
+  public:
+    using value_type = typename container_type::value_type;
+
+    using size_type       = typename container_type::size_type;
+    using difference_type = typename container_type::difference_type;
+
+    using pointer       = typename container_type::pointer;
+    using const_pointer = typename container_type::const_pointer;
+
+    using reference       = typename container_type::reference;
+    using const_reference = typename container_type::const_reference;
+
+    using iterator       = typename container_type::iterator;
+    using const_iterator = typename container_type::const_iterator;
+
+    using span_type       = typed_span<Index, Ty>;
+    using const_span_type = typed_span<Index, const Ty>;
+
+  public:
+    typed_vector() = default;
+
+    explicit typed_vector(const size_type count)
+        : _container(count) {
+    }
+
+    typed_vector(const size_type count, const value_type& value)
+        : _container(count, value) {
+    }
+
+    typed_vector(STD initializer_list<value_type> list)
+        : _container(list) {
+    }
+
+    template<class ItTy, if_t<is_iterator_v<ItTy>> = 0>
+    typed_vector(ItTy first, ItTy last)
+        : _container(first, last) {
+    }
+
+    explicit typed_vector(container_type container)
+        : _container(STD move(container)) {
+    }
+
+  public:
+    MI_NODISCARD size_type size() const noexcept {
+      return _container.size();
+    }
+
+    MI_NODISCARD bool empty() const noexcept {
+      return _container.empty();
+    }
+
+    // Индекс, который получит следующий добавленный элемент.
+    MI_NODISCARD index_type end_index() const noexcept {
+      return index_type(static_cast<typename index_type::underlying_type>(_container.size()));
+    }
+
+  public:
+    void reserve(const size_type new_capacity) {
+      _container.reserve(new_capacity);
+    }
+
+    void resize(const size_type new_size) {
+      _container.resize(new_size);
+    }
+
+    void resize(const size_type new_size, const value_type& value) {
+      _container.resize(new_size, value);
+    }
+
+    void clear() noexcept {
+      _container.clear();
+    }
+
+    void shrink_to_fit() {
+      _container.shrink_to_fit();
+    }
+
+  public:
+    template<class... TyVal>
+    reference emplace_back(TyVal&&... values) {
+      return _container.emplace_back(STD forward<TyVal>(values)...);
+    }
+
+    void push_back(const value_type& value) {
+      _container.push_back(value);
+    }
+
+    void push_back(value_type&& value) {
+      _container.push_back(STD move(value));
+    }
+
+  public:
+    MI_NODISCARD iterator begin() noexcept {
+      return _container.begin();
+    }
+
+    MI_NODISCARD const_iterator begin() const noexcept {
+      return _container.begin();
+    }
+
+    MI_NODISCARD iterator end() noexcept {
+      return _container.end();
+    }
+
+    MI_NODISCARD const_iterator end() const noexcept {
+      return _container.end();
+    }
+
+    MI_NODISCARD pointer data() noexcept {
+      return _container.data();
+    }
+
+    MI_NODISCARD const_pointer data() const noexcept {
+      return _container.data();
+    }
+
+  public:
+    MI_NODISCARD reference operator[](const index_type index) {
+      MI_DCHECK(internal::index_to_position(index) < size());
+
+      return _container[internal::index_to_position(index)];
+    }
+
+    MI_NODISCARD const_reference operator[](const index_type index) const {
+      MI_DCHECK(internal::index_to_position(index) < size());
+
+      return _container[internal::index_to_position(index)];
+    }
+
+    MI_NODISCARD reference at(const index_type index) {
+      MI_CHECK(internal::index_to_position(index) < size());
+
+      return _container[internal::index_to_position(index)];
+    }
+
+    MI_NODISCARD const_reference at(const index_type index) const {
+      MI_CHECK(internal::index_to_position(index) < size());
+
+      return _container[internal::index_to_position(index)];
+    }
+
+  public:
+    MI_NODISCARD span_type span() noexcept {
+      return {_container.data(), _container.size()};
+    }
+
+    MI_NODISCARD const_span_type span() const noexcept {
+      return {_container.data(), _container.size()};
+    }
+
+    MI_NODISCARD operator span_type() noexcept {
+      return span();
+    }
+
+    MI_NODISCARD operator const_span_type() const noexcept {
+      return span();
+    }
+
+  public:
+    MI_NODISCARD auto underlying_span() noexcept {
+      return span().underlying_span();
+    }
+
+    MI_NODISCARD auto underlying_span() const noexcept {
+      return span().underlying_span();
+    }
+
+  public:
+    // Доступ к самому вектору, например для передачи в код, не знающий про strong_alias.
+    MI_NODISCARD const container_type& vector() const noexcept {
+      return _container;
+    }
+
+    MI_NODISCARD container_type release() && noexcept {
+      return STD move(_container);
+    }
+
+  public:
+    MI_NODISCARD friend bool operator==(const typed_vector& lhs, const typed_vector& rhs) {
+      return lhs._container == rhs._container;
+    }
+
+    MI_NODISCARD friend bool operator!=(const typed_vector& lhs, const typed_vector& rhs) {
+      return !(lhs == rhs);
+    }
+
+  private:
+    container_type _container;
+};
+}  // namespace mi
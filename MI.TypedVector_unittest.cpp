@@ -0,0 +1,69 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <numeric>
+
+#include "Base/Test/MI.GTestUtil.h"
+#include "Container/MI.TypedVector.h"
+
+namespace mi::test {
+MI_NEW_STRONG_ALIAS(test_vertex_id, int);
+MI_NEW_STRONG_ALIAS(test_element_id, size_t);
+
+static_assert(MI internal::is_layout_compatible_alias_v<test_vertex_id>, "");
+static_assert(!STD is_convertible_v<size_t, test_element_id>, "");
+
+TEST(TypedVector, IndexByAlias) {
+  MI typed_vector<test_element_id, double> quality(3, 1.);
+
+  quality[test_element_id(1)] = 0.5;
+
+  EXPECT_EQ(quality.size(), 3);
+  EXPECT_EQ(quality[test_element_id(1)], 0.5);
+  EXPECT_EQ(quality.at(test_element_id(2)), 1.);
+  EXPECT_EQ(quality.end_index(), test_element_id(3));
+  MI_EXPECT_CHECK_DEATH((MI_DISABLE_4834)quality.at(test_element_id(3)));
+}
+
+TEST(TypedVector, PushBack) {
+  MI typed_vector<test_element_id, test_vertex_id> vertices;
+
+  vertices.push_back(test_vertex_id(5));
+  vertices.emplace_back(7);
+
+  EXPECT_THAT(vertices, testing::ElementsAre(test_vertex_id(5), test_vertex_id(7)));
+}
+
+TEST(TypedVector, Span) {
+  MI typed_vector<test_element_id, int> values = {1, 2, 3, 4};
+
+  const MI typed_span<test_element_id, int>       span       = values;
+  const MI typed_span<test_element_id, const int> const_span = span;
+
+  span[test_element_id(0)] = 10;
+
+  EXPECT_EQ(const_span[test_element_id(0)], 10);
+  EXPECT_THAT(span.subspan(test_element_id(1), 2), testing::ElementsAre(2, 3));
+}
+
+TEST(TypedVector, UnderlyingSpan) {
+  MI typed_vector<test_element_id, test_vertex_id> vertices = {test_vertex_id(1), test_vertex_id(2), test_vertex_id(3)};
+
+  const auto raw = vertices.underlying_span();
+
+  static_assert(STD is_same_v<decltype(raw), const MI typed_span<test_element_id, int>>, "");
+  EXPECT_EQ(static_cast<const void*>(raw.data()), static_cast<const void*>(vertices.data()));
+
+  // Изменения через underlying_span видны в исходном контейнере без копирования.
+  for (int& value: raw) {
+    value += 10;
+  }
+
+  EXPECT_EQ(STD accumulate(raw.begin(), raw.end(), 0), 36);
+  EXPECT_THAT(vertices, testing::ElementsAre(test_vertex_id(11), test_vertex_id(12), test_vertex_id(13)));
+
+  const auto& const_vertices = vertices;
+  static_assert(STD is_same_v<decltype(const_vertices.underlying_span()), MI typed_span<test_element_id, const int>>,
+                "");
+}
+}  // namespace mi::test
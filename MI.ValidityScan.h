@@ -0,0 +1,65 @@
+﻿#pragma once
+
+#include <array>
+
+#include "Common/MI.Check.h"
+#include "Common/MI.ParallelFor.h"
+#include "Container/MI.Bitset.h"
+#include "Container/MI.CompressedIdList.h"
+#include "Container/MI.Matrix.h"
+#include "Mesh/MI.FlatMesh.h"
+#include "Mesh/MI.QualityGradient.h"
+
+// Проверка действительности всех элементов сетки.
+// ===============================================
+//
+// MI is_valid_quality возвращает bool для одного элемента, хранить результаты для всей сетки приходится вызывающему.
+// scan_validity возвращает:
+//
+// - valid   - битовый набор (1 бит на элемент), бит установлен у действительных элементов,
+// - invalid - сжатый список номеров недействительных элементов по возрастанию.
+//
+// Элемент действителен, если его mean ratio quality (MI mean_ratio_quality) больше 0, то есть ни один симплекс-узел
+// не вырожден и не вывернут относительно опорной нормали. Для quad это включает проверку на вогнутость.
+//
+// Набор заполняется параллельно словами по 64 элемента (MI make_bitset), поэтому его можно сразу пересекать
+// с другими фильтрами элементов:
+//
+// const MI validity_scan_result validity = MI scan_validity(mesh);
+// const MI dynamic_bitset       selected = validity.valid & MI make_bitset(mesh.n_elements(), n_threads, predicate);
+namespace mi {
+struct validity_scan_result {
+    MI dynamic_bitset     valid;
+    MI compressed_id_list invalid;
+
+    MI_NODISCARD size_t n_valid() const noexcept {
+      return valid.size() - invalid.size();
+    }
+
+    MI_NODISCARD bool is_valid(const size_t n_element) const {
+      return valid.test(n_element);
+    }
+};
+
+// reference_normal - общая опорная нормаль для плоских сеток, нулевой вектор - нормаль каждого элемента
+// (вывернутые элементы при этом не обнаруживаются).
+template<size_t NodesPerElement>
+MI_NODISCARD validity_scan_result scan_validity(const flat_mesh<NodesPerElement>& mesh,
+                                                const MI point3d& reference_normal = {0., 0., 0.},
+                                                const size_t      n_threads        = MI default_thread_count()) {
+  validity_scan_result result;
+
+  result.valid = MI make_bitset(mesh.n_elements(), n_threads, [&](const size_t n_element) {
+    const STD array<MI point3d, NodesPerElement> p = internal::gather(mesh, n_element);
+
+    return MI mean_ratio_quality(p, internal::select_normal(p, reference_normal)) > 0.;
+  });
+
+  // Недействительных элементов обычно мало: пропускаются целые слова без сброшенных битов.
+  result.valid.for_each_unset([&result](const size_t n_element) {
+    result.invalid.push_back(n_element);
+  });
+
+  return result;
+}
+}  // namespace mi
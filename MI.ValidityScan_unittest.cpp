@@ -0,0 +1,42 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "Mesh/MI.FlatMesh.h"
+#include "Mesh/MI.MeshTestUtil.h"
+#include "Mesh/MI.ValidityScan.h"
+
+namespace mi::test {
+TEST(ValidityScan, FindsInvertedAndDegeneratedElements) {
+  MI flat_quad_mesh mesh = make_grid(20);
+
+  STD swap(mesh.elements[3][1], mesh.elements[3][3]);       // Вывернут
+  mesh.elements[70][2] = mesh.elements[70][1];              // Вырожден
+  mesh.vertices[mesh.elements[399][2]] = {19.1, 19.1, 0.};  // Вогнутый (вершина внутри элемента)
+
+  for (const size_t n_threads: {1, 4}) {
+    const MI validity_scan_result result = MI scan_validity(mesh, {0., 0., 1.}, n_threads);
+
+    EXPECT_EQ(result.valid.size(), mesh.n_elements());
+    EXPECT_EQ(result.n_valid(), mesh.n_elements() - 3);
+    EXPECT_EQ(result.valid.count(), result.n_valid());
+    EXPECT_THAT(result.invalid.decode(), testing::ElementsAre(3, 70, 399));
+    EXPECT_FALSE(result.is_valid(70));
+    EXPECT_TRUE(result.is_valid(71));
+  }
+
+  // Без общей нормали вывернутый элемент не обнаруживается.
+  EXPECT_THAT(MI scan_validity(mesh).invalid.decode(), testing::ElementsAre(70, 399));
+}
+
+TEST(ValidityScan, IntersectsWithOtherFilters) {
+  MI flat_quad_mesh mesh = make_grid(10);
+  STD swap(mesh.elements[0][1], mesh.elements[0][3]);
+
+  const MI validity_scan_result validity = MI scan_validity(mesh, {0., 0., 1.});
+  const MI dynamic_bitset       first_row = MI make_bitset(mesh.n_elements(), 2, [](const size_t n_element) {
+    return n_element < 10;
+  });
+
+  EXPECT_EQ((validity.valid & first_row).count(), 9);
+}
+}  // namespace mi::test
@@ -0,0 +1,84 @@
+﻿#pragma once
+
+#include <limits>
+#include <vector>
+
+#include "Common/MI.Check.h"
+#include "Common/MI.ParallelFor.h"
+#include "Container/MI.RaggedArray.h"
+#include "Mesh/MI.FlatMesh.h"
+
+// Качество элементов, собранное по вершинам.
+// ==========================================
+//
+// Сглаживанию и адаптации нужны значения в вершинах: наихудшее и среднее качество инцидентных элементов и номер
+// наихудшего элемента. Разносить результаты элементов по их вершинам параллельно (scatter) можно только с атомарными
+// операциями над double или блокировками. Здесь вместо этого каждая вершина сама читает качество своих элементов
+// по строке MI vertex_elements (gather): потоки пишут только в свои вершины, синхронизация не нужна, результат
+// не зависит от количества потоков.
+//
+// element_quality - уже посчитанное качество элементов (например, столбец MI evaluate_quality_metrics или результат
+// параллельного прохода MI quality), буфер только читается.
+//
+// const MI ragged_array<size_t> incident = MI vertex_elements(mesh);  // Один раз на связность сетки
+// const MI vertex_quality_stats stats    = MI aggregate_vertex_quality(incident, quality);
+namespace mi {
+struct vertex_quality_stats {
+    static constexpr size_t no_element = STD numeric_limits<size_t>::max();
+
+    STD vector<double> min_quality;    // 0 для вершины без элементов
+    STD vector<double> mean_quality;   // 0 для вершины без элементов
+    STD vector<size_t> worst_element;  // Наименьший номер при равном качестве, no_element для вершины без элементов
+};
+
+MI_NODISCARD inline vertex_quality_stats aggregate_vertex_quality(const MI ragged_array<size_t>& vertex_elements,
+                                                                  const STD vector<double>&      element_quality,
+                                                                  const size_t n_threads = MI default_thread_count()) {
+  const size_t n_vertices = vertex_elements.size();
+
+  vertex_quality_stats result;
+  result.min_quality.resize(n_vertices);
+  result.mean_quality.resize(n_vertices);
+  result.worst_element.resize(n_vertices);
+
+  parallel_chunks(n_vertices, n_threads, [&](size_t, const size_t first, const size_t last) {
+    for (size_t n_vertex = first; n_vertex < last; ++n_vertex) {
+      double min_quality   = STD numeric_limits<double>::infinity();
+      double sum_quality   = 0.;
+      size_t worst_element = vertex_quality_stats::no_element;
+
+      for (const size_t n_element: vertex_elements[n_vertex]) {
+        // vertex_elements может быть построен для другой сетки: номер вне element_quality - ошибка вызывающего.
+        MI_CHECK(n_element < element_quality.size());
+
+        const double quality = element_quality[n_element];
+
+        // Строка упорядочена по возрастанию номеров, поэтому при равном качестве остается наименьший номер.
+        if (quality < min_quality) {
+          min_quality   = quality;
+          worst_element = n_element;
+        }
+
+        sum_quality += quality;
+      }
+
+      const size_t n_elements = vertex_elements.row_size(n_vertex);
+
+      result.min_quality[n_vertex]   = n_elements == 0 ? 0. : min_quality;
+      result.mean_quality[n_vertex]  = n_elements == 0 ? 0. : sum_quality / static_cast<double>(n_elements);
+      result.worst_element[n_vertex] = worst_element;
+    }
+  });
+
+  return result;
+}
+
+template<size_t NodesPerElement>
+MI_NODISCARD vertex_quality_stats aggregate_vertex_quality(const flat_mesh<NodesPerElement>& mesh,
+                                                           const STD vector<double>&         element_quality,
+                                                           const size_t n_threads = MI default_thread_count()) {
+  MI_CHECK(element_quality.size() == mesh.n_elements());
+
+  return aggregate_vertex_quality(MI vertex_elements(mesh), element_quality, n_threads);
+}
+}  // namespace mi
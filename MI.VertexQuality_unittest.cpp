@@ -0,0 +1,85 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "Mesh/MI.FlatMesh.h"
+#include "Mesh/MI.VertexQuality.h"
+
+namespace mi::test {
+namespace {
+// Решетка 2 x 2 quad:
+//
+// 6---7---8
+// | 2 | 3 |
+// 3---4---5
+// | 0 | 1 |
+// 0---1---2
+//
+// и вершина 9 без элементов.
+MI flat_quad_mesh grid_2x2() {
+  MI flat_quad_mesh mesh;
+
+  for (size_t j = 0; j <= 2; ++j) {
+    for (size_t i = 0; i <= 2; ++i) {
+      mesh.vertices.push_back({static_cast<double>(i), static_cast<double>(j), 0.});
+    }
+  }
+
+  mesh.vertices.push_back({5., 5., 0.});
+
+  mesh.elements = {
+    {0, 1, 4, 3},
+    {1, 2, 5, 4},
+    {3, 4, 7, 6},
+    {4, 5, 8, 7}
+  };
+
+  return mesh;
+}
+}  // namespace
+
+TEST(VertexQuality, MinMeanWorst) {
+  const MI flat_quad_mesh  mesh    = grid_2x2();
+  const STD vector<double> quality = {0.9, 0.5, 0.7, 0.5};
+
+  for (const size_t n_threads: {1, 3, 16}) {
+    const MI vertex_quality_stats stats = MI aggregate_vertex_quality(mesh, quality, n_threads);
+
+    ASSERT_EQ(stats.min_quality.size(), mesh.n_vertices());
+
+    // Центральная вершина: все 4 элемента, при равном качестве - наименьший номер.
+    EXPECT_DOUBLE_EQ(stats.min_quality[4], 0.5);
+    EXPECT_DOUBLE_EQ(stats.mean_quality[4], 0.65);
+    EXPECT_EQ(stats.worst_element[4], 1);
+
+    // Угол: один элемент.
+    EXPECT_DOUBLE_EQ(stats.min_quality[6], 0.7);
+    EXPECT_DOUBLE_EQ(stats.mean_quality[6], 0.7);
+    EXPECT_EQ(stats.worst_element[6], 2);
+
+    // Середина стороны: два элемента.
+    EXPECT_DOUBLE_EQ(stats.min_quality[3], 0.7);
+    EXPECT_DOUBLE_EQ(stats.mean_quality[3], 0.8);
+    EXPECT_EQ(stats.worst_element[3], 2);
+
+    // Вершина без элементов.
+    EXPECT_EQ(stats.min_quality[9], 0.);
+    EXPECT_EQ(stats.mean_quality[9], 0.);
+    EXPECT_EQ(stats.worst_element[9], MI vertex_quality_stats::no_element);
+  }
+}
+
+TEST(VertexQuality, ReusesIncidence) {
+  const MI flat_quad_mesh       mesh     = grid_2x2();
+  const MI ragged_array<size_t> incident = MI vertex_elements(mesh);
+
+  const MI vertex_quality_stats first  = MI aggregate_vertex_quality(incident, {1., 1., 1., 0.25});
+  const MI vertex_quality_stats second = MI aggregate_vertex_quality(incident, {0.25, 1., 1., 1.});
+
+  EXPECT_EQ(first.worst_element[4], 3);
+  EXPECT_EQ(second.worst_element[4], 0);
+  EXPECT_DOUBLE_EQ(first.min_quality[8], 0.25);
+  EXPECT_DOUBLE_EQ(second.min_quality[8], 1.);
+}
+}  // namespace mi::test